@@ -31,8 +31,11 @@ CNZSL_API void nzslBackendParametersDestroy(nzslBackendParameters* parameters);
 CNZSL_API void nzslBackendParametersEnableDeadCodeRemoval(nzslBackendParameters* parameters, nzslBool enable);
 CNZSL_API void nzslBackendParametersEnableOptimization(nzslBackendParameters* parameters, nzslBool enable);
 CNZSL_API void nzslBackendParametersEnableResolving(nzslBackendParameters* parameters, nzslBool enable);
+CNZSL_API void nzslBackendParametersEnableSpecializationConstants(nzslBackendParameters* parameters, nzslBool enable);
+CNZSL_API void nzslBackendParametersEnableSpirvOptimization(nzslBackendParameters* parameters, nzslBool enable);
 CNZSL_API void nzslBackendParametersEnableTargetRequired(nzslBackendParameters* parameters, nzslBool enable);
 CNZSL_API void nzslBackendParametersEnableValidation(nzslBackendParameters* parameters, nzslBool enable);
+CNZSL_API void nzslBackendParametersEnableVariablePromotion(nzslBackendParameters* parameters, nzslBool enable);
 CNZSL_API void nzslBackendParametersSetDebugLevel(nzslBackendParameters* parameters, nzslDebugLevel debugLevel);
 
 CNZSL_API void nzslBackendParametersSetModuleResolver_Filesystem(nzslBackendParameters* parameters, const nzslFilesystemModuleResolver* resolverPtr);
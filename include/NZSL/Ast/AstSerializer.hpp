@@ -73,7 +73,7 @@ namespace nzsl::Ast
 			template<typename T> void ExprValue(ExpressionValue<T>& attribute);
 			template<typename T> void OptEnum(std::optional<T>& optVal);
 			inline void OptSizeT(std::optional<std::size_t>& optVal);
-			inline void OptType(std::optional<ExpressionType>& optType);
+			inline void OptType(InternedType& optType);
 			template<typename T> void OptVal(std::optional<T>& optVal);
 
 			virtual bool IsVersionGreaterOrEqual(std::uint32_t version) const = 0;
@@ -103,6 +103,7 @@ namespace nzsl::Ast
 			virtual void Value(std::uint16_t& val) = 0;
 			virtual void Value(std::uint32_t& val) = 0;
 			virtual void Value(std::uint64_t& val) = 0;
+			inline void Value(InternedString& val);
 			template<typename T> void Value(Literal<T>& val);
 			template<typename T, std::size_t N> void Value(Vector<T, N>& val);
 	};
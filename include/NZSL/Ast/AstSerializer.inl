@@ -146,7 +146,7 @@ namespace nzsl::Ast
 			SizeT(optVal.value());
 	}
 
-	inline void SerializerBase::OptType(std::optional<ExpressionType>& optType)
+	inline void SerializerBase::OptType(InternedType& optType)
 	{
 		bool isWriting = IsWriting();
 
@@ -156,11 +156,17 @@ namespace nzsl::Ast
 
 		Value(hasValue);
 
-		if (!isWriting && hasValue)
-			optType.emplace();
+		if (!hasValue)
+			return;
+
+		ExpressionType type;
+		if (isWriting)
+			type = optType.value();
 
-		if (optType.has_value())
-			Type(optType.value());
+		Type(type);
+
+		if (!isWriting)
+			optType = std::move(type);
 	}
 
 	template<typename T>
@@ -197,13 +203,37 @@ namespace nzsl::Ast
 
 	inline void SerializerBase::SourceLoc(SourceLocation& sourceLoc)
 	{
-		SharedString(sourceLoc.file);
+		bool isWriting = IsWriting();
+
+		// serialize the file path rather than the index, as indices are only valid in the current process
+		std::shared_ptr<const std::string> file;
+		if (isWriting)
+			file = sourceLoc.GetFile();
+
+		SharedString(file);
+
+		if (!isWriting)
+			sourceLoc.fileIndex = (file) ? SourceLocation::RegisterFile(*file) : 0;
+
 		Value(sourceLoc.endColumn);
 		Value(sourceLoc.endLine);
 		Value(sourceLoc.startColumn);
 		Value(sourceLoc.startLine);
 	}
 
+	inline void SerializerBase::Value(InternedString& val)
+	{
+		if (IsWriting())
+			Value(const_cast<std::string&>(val.GetString())); //< won't be used for writing
+		else
+		{
+			std::string str;
+			Value(str);
+
+			val = InternedString(str);
+		}
+	}
+
 	template<typename T> 
 	void SerializerBase::Value(Literal<T>& val)
 	{
@@ -41,6 +41,7 @@ namespace nzsl::Ast
 
 			virtual ExpressionPtr CloneExpression(Expression& expr);
 			virtual StatementPtr CloneStatement(Statement& statement);
+			virtual void CloneFunctionBody(DeclareFunctionStatement& node, DeclareFunctionStatement& clone);
 			virtual ExpressionValue<ExpressionType> CloneType(const ExpressionValue<ExpressionType>& exprType);
 
 			virtual ExpressionPtr Clone(AccessFieldExpression& node);
@@ -182,7 +182,7 @@ namespace nzsl::Ast
 		if (!Compare(lhs.identifier, rhs.identifier, params))
 			return false;
 
-		if (!Compare(lhs.sourceLocation, rhs.sourceLocation, params))
+		if (params.compareSourceLoc && !Compare(lhs.sourceLocation, rhs.sourceLocation, params))
 			return false;
 
 		return true;
@@ -224,7 +224,7 @@ namespace nzsl::Ast
 		if (!Compare(lhs.type, rhs.type, params))
 			return false;
 
-		if (!Compare(lhs.sourceLocation, rhs.sourceLocation, params))
+		if (params.compareSourceLoc && !Compare(lhs.sourceLocation, rhs.sourceLocation, params))
 			return false;
 
 		if (!Compare(lhs.tag, rhs.tag, params))
@@ -244,7 +244,7 @@ namespace nzsl::Ast
 		if (!Compare(lhs.type, rhs.type, params))
 			return false;
 
-		if (!Compare(lhs.sourceLocation, rhs.sourceLocation, params))
+		if (params.compareSourceLoc && !Compare(lhs.sourceLocation, rhs.sourceLocation, params))
 			return false;
 
 		return true;
@@ -255,13 +255,13 @@ namespace nzsl::Ast
 		if (!Compare(lhs.identifier, rhs.identifier, params))
 			return false;
 
-		if (!Compare(lhs.identifierLoc, rhs.identifierLoc, params))
+		if (params.compareSourceLoc && !Compare(lhs.identifierLoc, rhs.identifierLoc, params))
 			return false;
 
 		if (!Compare(lhs.renamedIdentifier, rhs.renamedIdentifier, params))
 			return false;
 
-		if (!Compare(lhs.renamedIdentifierLoc, rhs.renamedIdentifierLoc, params))
+		if (params.compareSourceLoc && !Compare(lhs.renamedIdentifierLoc, rhs.renamedIdentifierLoc, params))
 			return false;
 
 		return true;
@@ -281,7 +281,7 @@ namespace nzsl::Ast
 		if (!Compare(lhs.startLine, rhs.startLine, params))
 			return false;
 
-		if (!Compare(lhs.file, rhs.file, params))
+		if (!Compare(lhs.fileIndex, rhs.fileIndex, params))
 			return false;
 
 		return true;
@@ -324,7 +324,7 @@ namespace nzsl::Ast
 		if (!Compare(lhs.type, rhs.type, params))
 			return false;
 
-		if (!Compare(lhs.sourceLocation, rhs.sourceLocation, params))
+		if (params.compareSourceLoc && !Compare(lhs.sourceLocation, rhs.sourceLocation, params))
 			return false;
 
 		if (!Compare(lhs.tag, rhs.tag, params))
@@ -629,7 +629,13 @@ namespace nzsl::Ast
 		if (!Compare(lhs.returnType, rhs.returnType, params))
 			return false;
 
-		if (!Compare(lhs.statements, rhs.statements, params))
+		// Shared bodies are compared by their statements, unparsed bodies can only be identical
+		if (lhs.deferredBody != rhs.deferredBody)
+			return false;
+
+		const auto& lhsStatements = (lhs.sharedBody) ? lhs.sharedBody->statements : lhs.statements;
+		const auto& rhsStatements = (rhs.sharedBody) ? rhs.sharedBody->statements : rhs.statements;
+		if (!Compare(lhsStatements, rhsStatements, params))
 			return false;
 
 		if (!Compare(lhs.workgroupSize, rhs.workgroupSize, params))
@@ -649,6 +655,9 @@ namespace nzsl::Ast
 		if (!Compare(lhs.defaultValue, rhs.defaultValue, params))
 			return false;
 
+		if (!Compare(lhs.isCompileTimeUsed, rhs.isCompileTimeUsed, params))
+			return false;
+
 		return true;
 	}
 
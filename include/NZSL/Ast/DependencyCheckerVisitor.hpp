@@ -36,6 +36,8 @@ namespace nzsl::Ast
 
 			inline void Resolve(bool allowUnknownId = false);
 
+			void UpdateFunction(DeclareFunctionStatement& node);
+
 			DependencyCheckerVisitor& operator=(const DependencyCheckerVisitor&) = delete;
 			DependencyCheckerVisitor& operator=(DependencyCheckerVisitor&&) = delete;
 
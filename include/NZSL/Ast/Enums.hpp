@@ -242,6 +242,20 @@ namespace nzsl::Ast
 
 	using ModuleFeatureFlags = Nz::Flags<ModuleFeature>;
 
+	// Operators and attributes some transformations act on, finer grained than node types
+	enum class NodeTrait
+	{
+		MatrixAddSub = 0, //< addition or subtraction between matrices
+		MatrixCast   = 1, //< cast to a matrix type
+		UnrolledLoop = 2, //< for or for-each loop with [unroll]
+
+		Max = UnrolledLoop
+	};
+
+	constexpr bool EnableEnumAsNzFlags(NodeTrait) { return true; }
+
+	using NodeTraitFlags = Nz::Flags<NodeTrait>;
+
 	enum class NodeType
 	{
 		// Remember to update Max value at the end of the enum when adding an entry (next free id: 47)
@@ -301,6 +315,12 @@ namespace nzsl::Ast
 		Max = IdentifierValueExpression
 	};
 
+	constexpr std::size_t NodeTypeCount = static_cast<std::size_t>(NodeType::Max) + 1;
+
+	constexpr bool EnableEnumAsNzFlags(NodeType) { return true; }
+
+	using NodeTypeFlags = Nz::Flags<NodeType>;
+
 	enum class PrimitiveType
 	{
 		Boolean        = 0, //< bool
@@ -0,0 +1,89 @@
+// Copyright (C) 2026 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NZSL_AST_HASH_HPP
+#define NZSL_AST_HASH_HPP
+
+#include <NZSL/Config.hpp>
+#include <NZSL/Ast/Compare.hpp>
+#include <NazaraUtils/Flags.hpp>
+#include <variant>
+#include <vector>
+
+namespace nzsl::Ast
+{
+	// Structural hash following the equality rules of Compare (same fields, same ComparisonParams handling),
+	// two modules comparing equal always have the same hash
+	inline std::size_t Hash(const Module& module, const ComparisonParams& params = {});
+
+	inline void Hash(std::size_t& seed, const Expression& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const Module& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const Module::ImportedModule& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const Module::Metadata& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const Statement& value, const ComparisonParams& params);
+
+	template<typename T> void Hash(std::size_t& seed, const T& value, const ComparisonParams& params);
+	template<typename T, std::size_t S> void Hash(std::size_t& seed, const std::array<T, S>& value, const ComparisonParams& params);
+	template<typename T> void Hash(std::size_t& seed, const std::shared_ptr<T>& value, const ComparisonParams& params);
+	template<typename T> void Hash(std::size_t& seed, const std::vector<T>& value, const ComparisonParams& params);
+	template<typename T> void Hash(std::size_t& seed, const std::unique_ptr<T>& value, const ComparisonParams& params);
+	template<typename... Args> void Hash(std::size_t& seed, const std::variant<Args...>& value, const ComparisonParams& params);
+	template<typename T> void Hash(std::size_t& seed, const Nz::Flags<T>& value, const ComparisonParams& params);
+	template<typename T> void Hash(std::size_t& seed, const ExpressionValue<T>& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const AccessIdentifierExpression::Identifier& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const BranchStatement::ConditionalStatement& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const CallFunctionExpression::Parameter& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const DeclareExternalStatement::ExternalVar& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const DeclareFunctionStatement::Parameter& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const ImportStatement::Identifier& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const SourceLocation& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const StructDescription& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const StructDescription::StructMember& value, const ComparisonParams& params);
+
+	inline void Hash(std::size_t& seed, const AccessFieldExpression& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const AccessIdentifierExpression& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const AccessIndexExpression& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const AssignExpression& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const BinaryExpression& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const CallFunctionExpression& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const CallMethodExpression& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const CastExpression& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const ConditionalExpression& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const ConstantArrayValueExpression& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const ConstantValueExpression& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const IdentifierExpression& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const IdentifierValueExpression& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const IntrinsicExpression& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const SwizzleExpression& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const TypeConstantExpression& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const UnaryExpression& value, const ComparisonParams& params);
+
+	inline void Hash(std::size_t& seed, const BranchStatement& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const BreakStatement& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const ConditionalStatement& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const ContinueStatement& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const DeclareAliasStatement& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const DeclareConstStatement& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const DeclareExternalStatement& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const DeclareFunctionStatement& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const DeclareOptionStatement& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const DeclareStructStatement& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const DeclareVariableStatement& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const DiscardStatement& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const ExpressionStatement& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const ForStatement& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const ForEachStatement& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const ImportStatement& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const MultiStatement& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const NoOpStatement& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const ReturnStatement& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const ScopedStatement& value, const ComparisonParams& params);
+	inline void Hash(std::size_t& seed, const WhileStatement& value, const ComparisonParams& params);
+}
+
+#include <NZSL/Ast/Hash.inl>
+
+#endif // NZSL_AST_HASH_HPP
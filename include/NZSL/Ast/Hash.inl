@@ -0,0 +1,478 @@
+// Copyright (C) 2026 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <NazaraUtils/Hash.hpp>
+#include <stdexcept>
+
+namespace nzsl::Ast
+{
+	std::size_t Hash(const Module& module, const ComparisonParams& params)
+	{
+		std::size_t seed = 0;
+		Hash(seed, module, params);
+
+		return seed;
+	}
+
+	inline void Hash(std::size_t& seed, const Expression& value, const ComparisonParams& params)
+	{
+		Nz::HashCombine(seed, value.GetType());
+
+		if (params.compareSourceLoc)
+			Hash(seed, value.sourceLocation, params);
+
+		switch (value.GetType())
+		{
+			case NodeType::None: break;
+
+#define NZSL_SHADERAST_EXPRESSION(Node) case NodeType::Node##Expression: return Hash(seed, static_cast<const Node##Expression&>(value), params);
+#include <NZSL/Ast/NodeList.hpp>
+
+			default: throw std::runtime_error("unexpected node type");
+		}
+	}
+
+	void Hash(std::size_t& seed, const Module& value, const ComparisonParams& params)
+	{
+		Hash(seed, *value.metadata, params);
+		Hash(seed, value.importedModules, params);
+		Hash(seed, *value.rootNode, params);
+	}
+
+	void Hash(std::size_t& seed, const Module::ImportedModule& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.identifier, params);
+		Hash(seed, *value.module, params);
+	}
+
+	void Hash(std::size_t& seed, const Module::Metadata& value, const ComparisonParams& params)
+	{
+		if (params.compareModuleName)
+			Hash(seed, value.moduleName, params);
+
+		Hash(seed, value.langVersion, params);
+		Hash(seed, value.enabledFeatures, params);
+		Hash(seed, value.author, params);
+		Hash(seed, value.description, params);
+		Hash(seed, value.license, params);
+	}
+
+	inline void Hash(std::size_t& seed, const Statement& value, const ComparisonParams& params)
+	{
+		Nz::HashCombine(seed, value.GetType());
+
+		if (params.compareSourceLoc)
+			Hash(seed, value.sourceLocation, params);
+
+		switch (value.GetType())
+		{
+			case NodeType::None: break;
+
+#define NZSL_SHADERAST_STATEMENT(Node) case NodeType::Node##Statement: return Hash(seed, static_cast<const Node##Statement&>(value), params);
+#include <NZSL/Ast/NodeList.hpp>
+
+			default: throw std::runtime_error("unexpected node type");
+		}
+	}
+
+	template<typename T>
+	void Hash(std::size_t& seed, const T& value, const ComparisonParams& /*params*/)
+	{
+		Nz::HashCombine(seed, value);
+	}
+
+	template<typename T, std::size_t S>
+	void Hash(std::size_t& seed, const std::array<T, S>& value, const ComparisonParams& params)
+	{
+		for (std::size_t i = 0; i < S; ++i)
+			Hash(seed, value[i], params);
+	}
+
+	template<typename T>
+	void Hash(std::size_t& seed, const std::shared_ptr<T>& value, const ComparisonParams& params)
+	{
+		Nz::HashCombine(seed, value != nullptr);
+		if (value)
+			Hash(seed, *value, params);
+	}
+
+	template<typename T>
+	void Hash(std::size_t& seed, const std::vector<T>& value, const ComparisonParams& params)
+	{
+		Nz::HashCombine(seed, value.size());
+		for (const T& element : value)
+			Hash(seed, element, params);
+	}
+
+	template<typename T>
+	void Hash(std::size_t& seed, const std::unique_ptr<T>& value, const ComparisonParams& params)
+	{
+		Nz::HashCombine(seed, value != nullptr);
+		if (value)
+			Hash(seed, *value, params);
+	}
+
+	template<typename... Args>
+	void Hash(std::size_t& seed, const std::variant<Args...>& value, const ComparisonParams& params)
+	{
+		// std::hash isn't defined for every alternative (array constants are std::vector)
+		Nz::HashCombine(seed, value.index());
+		std::visit([&](auto&& arg)
+		{
+			Hash(seed, arg, params);
+		}, value);
+	}
+
+	template<typename T>
+	void Hash(std::size_t& seed, const Nz::Flags<T>& value, const ComparisonParams& /*params*/)
+	{
+		for (T flag : value)
+			Nz::HashCombine(seed, flag);
+	}
+
+	template<typename T>
+	void Hash(std::size_t& seed, const ExpressionValue<T>& value, const ComparisonParams& params)
+	{
+		Nz::HashCombine(seed, value.HasValue());
+		Nz::HashCombine(seed, value.IsResultingValue());
+		Nz::HashCombine(seed, value.IsExpression());
+
+		if (value.IsExpression())
+			Hash(seed, value.GetExpression(), params);
+		else if (value.IsResultingValue())
+			Hash(seed, value.GetResultingValue(), params);
+	}
+
+	inline void Hash(std::size_t& seed, const AccessIdentifierExpression::Identifier& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.identifier, params);
+		if (params.compareSourceLoc)
+			Hash(seed, value.sourceLocation, params);
+	}
+
+	inline void Hash(std::size_t& seed, const BranchStatement::ConditionalStatement& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.condition, params);
+		Hash(seed, value.statement, params);
+	}
+
+	inline void Hash(std::size_t& seed, const CallFunctionExpression::Parameter& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.semantic, params);
+		Hash(seed, value.expr, params);
+	}
+
+	inline void Hash(std::size_t& seed, const DeclareExternalStatement::ExternalVar& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.bindingIndex, params);
+		Hash(seed, value.bindingSet, params);
+		Hash(seed, value.name, params);
+		Hash(seed, value.type, params);
+		if (params.compareSourceLoc)
+			Hash(seed, value.sourceLocation, params);
+		Hash(seed, value.tag, params);
+	}
+
+	inline void Hash(std::size_t& seed, const DeclareFunctionStatement::Parameter& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.semantic, params);
+		Hash(seed, value.name, params);
+		Hash(seed, value.type, params);
+		if (params.compareSourceLoc)
+			Hash(seed, value.sourceLocation, params);
+	}
+
+	inline void Hash(std::size_t& seed, const ImportStatement::Identifier& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.identifier, params);
+		if (params.compareSourceLoc)
+			Hash(seed, value.identifierLoc, params);
+		Hash(seed, value.renamedIdentifier, params);
+		if (params.compareSourceLoc)
+			Hash(seed, value.renamedIdentifierLoc, params);
+	}
+
+	inline void Hash(std::size_t& seed, const SourceLocation& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.endColumn, params);
+		Hash(seed, value.endLine, params);
+		Hash(seed, value.startColumn, params);
+		Hash(seed, value.startLine, params);
+		Hash(seed, value.fileIndex, params);
+	}
+
+	inline void Hash(std::size_t& seed, const StructDescription& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.layout, params);
+		Hash(seed, value.name, params);
+		Hash(seed, value.tag, params);
+		Hash(seed, value.members, params);
+	}
+
+	inline void Hash(std::size_t& seed, const StructDescription::StructMember& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.builtin, params);
+		Hash(seed, value.cond, params);
+		Hash(seed, value.interp, params);
+		Hash(seed, value.locationIndex, params);
+		Hash(seed, value.name, params);
+		Hash(seed, value.type, params);
+		if (params.compareSourceLoc)
+			Hash(seed, value.sourceLocation, params);
+		Hash(seed, value.tag, params);
+	}
+
+	inline void Hash(std::size_t& seed, const AccessFieldExpression& value, const ComparisonParams& params)
+	{
+		Hash(seed, *value.expr, params);
+		Hash(seed, value.fieldIndex, params);
+	}
+
+	inline void Hash(std::size_t& seed, const AccessIdentifierExpression& value, const ComparisonParams& params)
+	{
+		Hash(seed, *value.expr, params);
+		Hash(seed, value.identifiers, params);
+	}
+
+	inline void Hash(std::size_t& seed, const AccessIndexExpression& value, const ComparisonParams& params)
+	{
+		Hash(seed, *value.expr, params);
+		Hash(seed, value.indices, params);
+	}
+
+	inline void Hash(std::size_t& seed, const AssignExpression& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.op, params);
+		Hash(seed, value.left, params);
+		Hash(seed, value.right, params);
+	}
+
+	inline void Hash(std::size_t& seed, const BinaryExpression& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.op, params);
+		Hash(seed, value.left, params);
+		Hash(seed, value.right, params);
+	}
+
+	inline void Hash(std::size_t& seed, const CallFunctionExpression& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.targetFunction, params);
+		Hash(seed, value.parameters, params);
+	}
+
+	inline void Hash(std::size_t& seed, const CallMethodExpression& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.methodName, params);
+		Hash(seed, value.object, params);
+		Hash(seed, value.parameters, params);
+	}
+
+	inline void Hash(std::size_t& seed, const CastExpression& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.targetType, params);
+		Hash(seed, value.expressions, params);
+	}
+
+	inline void Hash(std::size_t& seed, const ConditionalExpression& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.condition, params);
+		Hash(seed, value.truePath, params);
+		Hash(seed, value.falsePath, params);
+	}
+
+	inline void Hash(std::size_t& seed, const ConstantArrayValueExpression& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.values, params);
+	}
+
+	inline void Hash(std::size_t& seed, const ConstantValueExpression& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.value, params);
+	}
+
+	inline void Hash(std::size_t& seed, const IdentifierExpression& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.identifier, params);
+	}
+
+	inline void Hash(std::size_t& seed, const IdentifierValueExpression& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.identifierType, params);
+		Hash(seed, value.identifierIndex, params);
+	}
+
+	inline void Hash(std::size_t& seed, const IntrinsicExpression& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.intrinsic, params);
+		Hash(seed, value.parameters, params);
+	}
+
+	inline void Hash(std::size_t& seed, const SwizzleExpression& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.componentCount, params);
+		Hash(seed, value.expression, params);
+		Hash(seed, value.components, params);
+	}
+
+	inline void Hash(std::size_t& seed, const TypeConstantExpression& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.typeConstant, params);
+		Hash(seed, value.type, params);
+	}
+
+	inline void Hash(std::size_t& seed, const UnaryExpression& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.op, params);
+		Hash(seed, value.expression, params);
+	}
+
+	inline void Hash(std::size_t& seed, const BranchStatement& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.isConst, params);
+		Hash(seed, value.elseStatement, params);
+		Hash(seed, value.condStatements, params);
+	}
+
+	inline void Hash(std::size_t& /*seed*/, const BreakStatement& /*value*/, const ComparisonParams& /*params*/)
+	{
+	}
+
+	inline void Hash(std::size_t& seed, const ConditionalStatement& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.condition, params);
+		Hash(seed, value.statement, params);
+	}
+
+	inline void Hash(std::size_t& /*seed*/, const ContinueStatement& /*value*/, const ComparisonParams& /*params*/)
+	{
+	}
+
+	inline void Hash(std::size_t& seed, const DeclareAliasStatement& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.name, params);
+		Hash(seed, value.expression, params);
+	}
+
+	inline void Hash(std::size_t& seed, const DeclareConstStatement& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.name, params);
+		Hash(seed, value.type, params);
+		Hash(seed, value.expression, params);
+	}
+
+	inline void Hash(std::size_t& seed, const DeclareExternalStatement& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.bindingSet, params);
+		Hash(seed, value.autoBinding, params);
+		Hash(seed, value.tag, params);
+		Hash(seed, value.name, params);
+		Hash(seed, value.externalVars, params);
+	}
+
+	inline void Hash(std::size_t& seed, const DeclareFunctionStatement& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.depthWrite, params);
+		Hash(seed, value.earlyFragmentTests, params);
+		Hash(seed, value.entryStage, params);
+		Hash(seed, value.isExported, params);
+		Hash(seed, value.name, params);
+		Hash(seed, value.parameters, params);
+		Hash(seed, value.returnType, params);
+		Nz::HashCombine(seed, value.deferredBody.get());
+		Hash(seed, (value.sharedBody) ? value.sharedBody->statements : value.statements, params);
+		Hash(seed, value.workgroupSize, params);
+	}
+
+	inline void Hash(std::size_t& seed, const DeclareOptionStatement& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.optName, params);
+		Hash(seed, value.optType, params);
+		Hash(seed, value.defaultValue, params);
+		Hash(seed, value.isCompileTimeUsed, params);
+	}
+
+	inline void Hash(std::size_t& seed, const DeclareStructStatement& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.description, params);
+	}
+
+	inline void Hash(std::size_t& seed, const DeclareVariableStatement& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.varName, params);
+		Hash(seed, value.varType, params);
+		Hash(seed, value.initialExpression, params);
+	}
+
+	inline void Hash(std::size_t& /*seed*/, const DiscardStatement& /*value*/, const ComparisonParams& /*params*/)
+	{
+	}
+
+	inline void Hash(std::size_t& seed, const ExpressionStatement& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.expression, params);
+	}
+
+	inline void Hash(std::size_t& seed, const ForStatement& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.varName, params);
+		Hash(seed, value.unroll, params);
+		Hash(seed, value.fromExpr, params);
+		Hash(seed, value.toExpr, params);
+		Hash(seed, value.stepExpr, params);
+		Hash(seed, value.statement, params);
+	}
+
+	inline void Hash(std::size_t& seed, const ForEachStatement& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.varName, params);
+		Hash(seed, value.unroll, params);
+		Hash(seed, value.expression, params);
+		Hash(seed, value.statement, params);
+	}
+
+	inline void Hash(std::size_t& seed, const ImportStatement& value, const ComparisonParams& params)
+	{
+		if (params.compareModuleName)
+			Hash(seed, value.moduleName, params);
+
+		Hash(seed, value.moduleIdentifier, params);
+		Hash(seed, value.identifiers, params);
+	}
+
+	inline void Hash(std::size_t& seed, const MultiStatement& value, const ComparisonParams& params)
+	{
+		std::size_t statementCount = 0;
+		for (const StatementPtr& statement : value.statements)
+		{
+			if (params.ignoreNoOp && statement->GetType() == NodeType::NoOpStatement)
+				continue;
+
+			Hash(seed, *statement, params);
+			statementCount++;
+		}
+
+		Nz::HashCombine(seed, statementCount);
+	}
+
+	inline void Hash(std::size_t& /*seed*/, const NoOpStatement& /*value*/, const ComparisonParams& /*params*/)
+	{
+	}
+
+	inline void Hash(std::size_t& seed, const ReturnStatement& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.returnExpr, params);
+	}
+
+	inline void Hash(std::size_t& seed, const ScopedStatement& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.statement, params);
+	}
+
+	inline void Hash(std::size_t& seed, const WhileStatement& value, const ComparisonParams& params)
+	{
+		Hash(seed, value.unroll, params);
+		Hash(seed, value.condition, params);
+		Hash(seed, value.body, params);
+	}
+}
@@ -10,8 +10,8 @@
 #include <NazaraUtils/Bitset.hpp>
 #include <NZSL/Config.hpp>
 #include <NZSL/Lang/SourceLocation.hpp>
+#include <deque>
 #include <optional>
-#include <unordered_map>
 
 namespace nzsl::Ast
 {
@@ -41,7 +41,8 @@ namespace nzsl::Ast
 		T& Retrieve(std::size_t index, const SourceLocation& sourceLocation);
 		T* TryRetrieve(std::size_t index, const SourceLocation& sourceLocation);
 
-		std::unordered_map<std::size_t, T> values;
+		Nz::Bitset<std::uint64_t> registeredValues;
+		std::deque<T> values; //< indexed by identifier index, only valid for indices set in registeredValues (a deque keeps references valid when growing)
 	};
 }
 
@@ -22,6 +22,7 @@ namespace nzsl::Ast
 	{
 		IdentifierList::Clear();
 
+		registeredValues.Clear();
 		values.clear();
 	}
 
@@ -31,8 +32,12 @@ namespace nzsl::Ast
 	{
 		std::size_t dataIndex = IdentifierList::Register(index, sourceLocation);
 
-		assert(values.find(dataIndex) == values.end());
-		values.emplace(dataIndex, std::forward<U>(data));
+		assert(!registeredValues.UnboundedTest(dataIndex));
+		if (dataIndex >= values.size())
+			values.resize(dataIndex + 1);
+
+		values[dataIndex] = std::forward<U>(data);
+		registeredValues.UnboundedSet(dataIndex);
 
 		return dataIndex;
 	}
@@ -40,18 +45,16 @@ namespace nzsl::Ast
 	template<typename T>
 	T& IdentifierListWithValues<T>::Retrieve(std::size_t index, const SourceLocation& sourceLocation)
 	{
-		auto it = values.find(index);
-		if (it == values.end())
+		if (!registeredValues.UnboundedTest(index))
 			throw AstInvalidIndexError{ sourceLocation, identifierName, index };
 
-		return it->second;
+		return values[index];
 	}
 
 	template<typename T>
 	T* IdentifierListWithValues<T>::TryRetrieve(std::size_t index, const SourceLocation& sourceLocation)
 	{
-		auto it = values.find(index);
-		if (it == values.end())
+		if (!registeredValues.UnboundedTest(index))
 		{
 			if (!preregisteredIndices.UnboundedTest(index))
 				throw AstInvalidIndexError{ sourceLocation, identifierName, index };
@@ -59,6 +62,6 @@ namespace nzsl::Ast
 			return nullptr;
 		}
 
-		return &it->second;
+		return &values[index];
 	}
 }
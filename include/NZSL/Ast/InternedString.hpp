@@ -0,0 +1,74 @@
+// Copyright (C) 2026 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NZSL_AST_INTERNEDSTRING_HPP
+#define NZSL_AST_INTERNEDSTRING_HPP
+
+#include <NZSL/Config.hpp>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace nzsl::Ast
+{
+	// Handle to a string stored once in a global table, used for identifiers which are compared and hashed a lot during compilation
+	// two interned strings are equal if and only if they point to the same entry
+	// the table is sharded and each thread caches the strings it already interned, entries are kept until ClearTable is called
+	class NZSL_API InternedString
+	{
+		public:
+			InternedString() = default;
+			explicit InternedString(std::string_view str);
+			InternedString(const InternedString&) = default;
+			InternedString(InternedString&&) noexcept = default;
+			~InternedString() = default;
+
+			inline std::size_t GetHash() const;
+			inline const std::string& GetString() const;
+
+			inline bool IsEmpty() const;
+
+			inline operator const std::string&() const;
+			inline operator std::string_view() const;
+
+			InternedString& operator=(const InternedString&) = default;
+			InternedString& operator=(InternedString&&) noexcept = default;
+
+			inline bool operator==(const InternedString& other) const;
+			inline bool operator!=(const InternedString& other) const;
+
+			// Releases every interned string, no handle (nor module holding one) created before may be used afterwards
+			// must not be called while another thread is interning strings
+			static void ClearTable();
+
+		private:
+			const std::string* m_str = nullptr; //< null for empty strings
+	};
+
+	inline bool operator==(const InternedString& lhs, std::string_view rhs);
+	inline bool operator==(std::string_view lhs, const InternedString& rhs);
+	inline bool operator!=(const InternedString& lhs, std::string_view rhs);
+	inline bool operator!=(std::string_view lhs, const InternedString& rhs);
+
+	inline std::ostream& operator<<(std::ostream& out, const InternedString& str);
+}
+
+namespace std
+{
+	template<>
+	struct hash<nzsl::Ast::InternedString>
+	{
+		std::size_t operator()(const nzsl::Ast::InternedString& str) const
+		{
+			return str.GetHash();
+		}
+	};
+}
+
+#include <NZSL/Ast/InternedString.inl>
+
+#endif // NZSL_AST_INTERNEDSTRING_HPP
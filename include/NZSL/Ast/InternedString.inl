@@ -0,0 +1,67 @@
+// Copyright (C) 2026 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+namespace nzsl::Ast
+{
+	inline std::size_t InternedString::GetHash() const
+	{
+		return std::hash<const std::string*>{}(m_str);
+	}
+
+	inline const std::string& InternedString::GetString() const
+	{
+		static const std::string emptyString;
+		return (m_str) ? *m_str : emptyString;
+	}
+
+	inline bool InternedString::IsEmpty() const
+	{
+		return m_str == nullptr;
+	}
+
+	inline InternedString::operator const std::string&() const
+	{
+		return GetString();
+	}
+
+	inline InternedString::operator std::string_view() const
+	{
+		return GetString();
+	}
+
+	inline bool InternedString::operator==(const InternedString& other) const
+	{
+		return m_str == other.m_str;
+	}
+
+	inline bool InternedString::operator!=(const InternedString& other) const
+	{
+		return !operator==(other);
+	}
+
+	inline bool operator==(const InternedString& lhs, std::string_view rhs)
+	{
+		return lhs.GetString() == rhs;
+	}
+
+	inline bool operator==(std::string_view lhs, const InternedString& rhs)
+	{
+		return lhs == rhs.GetString();
+	}
+
+	inline bool operator!=(const InternedString& lhs, std::string_view rhs)
+	{
+		return !operator==(lhs, rhs);
+	}
+
+	inline bool operator!=(std::string_view lhs, const InternedString& rhs)
+	{
+		return !operator==(lhs, rhs);
+	}
+
+	inline std::ostream& operator<<(std::ostream& out, const InternedString& str)
+	{
+		return out << str.GetString();
+	}
+}
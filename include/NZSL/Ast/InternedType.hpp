@@ -0,0 +1,78 @@
+// Copyright (C) 2026 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NZSL_AST_INTERNEDTYPE_HPP
+#define NZSL_AST_INTERNEDTYPE_HPP
+
+#include <NZSL/Config.hpp>
+#include <NZSL/Ast/ExpressionType.hpp>
+#include <functional>
+#include <optional>
+#include <type_traits>
+
+namespace nzsl::Ast
+{
+	// Immutable handle to an expression type stored once in a global table (or to no type at all)
+	// two interned types are equal if and only if they point to the same entry, copying one doesn't copy the type
+	// its interface mimics std::optional<ExpressionType> as it replaces it for cached expression types
+	// the table is sharded and each thread caches the types it already interned, entries are kept until ClearTable is called
+	class NZSL_API InternedType
+	{
+		public:
+			InternedType() = default;
+			inline InternedType(std::nullopt_t);
+			InternedType(const ExpressionType& type);
+			InternedType(ExpressionType&& type);
+			inline InternedType(const std::optional<ExpressionType>& type);
+			template<typename T, typename = std::enable_if_t<std::is_constructible_v<ExpressionType, T&&> && !std::is_same_v<std::decay_t<T>, ExpressionType> && !std::is_same_v<std::decay_t<T>, InternedType>>> InternedType(T&& type);
+			InternedType(const InternedType&) = default;
+			InternedType(InternedType&&) noexcept = default;
+			~InternedType() = default;
+
+			inline std::size_t GetHash() const;
+			inline const ExpressionType* GetType() const;
+
+			inline bool has_value() const;
+
+			inline void reset();
+
+			inline const ExpressionType& value() const;
+
+			inline explicit operator bool() const;
+
+			inline const ExpressionType& operator*() const;
+			inline const ExpressionType* operator->() const;
+
+			InternedType& operator=(const InternedType&) = default;
+			InternedType& operator=(InternedType&&) noexcept = default;
+
+			inline bool operator==(const InternedType& other) const;
+			inline bool operator!=(const InternedType& other) const;
+
+			// Releases every interned type, no handle (nor module holding one) created before may be used afterwards
+			// must not be called while another thread is interning types
+			static void ClearTable();
+
+		private:
+			const ExpressionType* m_type = nullptr;
+	};
+}
+
+namespace std
+{
+	template<>
+	struct hash<nzsl::Ast::InternedType>
+	{
+		std::size_t operator()(const nzsl::Ast::InternedType& type) const
+		{
+			return type.GetHash();
+		}
+	};
+}
+
+#include <NZSL/Ast/InternedType.inl>
+
+#endif // NZSL_AST_INTERNEDTYPE_HPP
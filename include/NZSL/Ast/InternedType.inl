@@ -0,0 +1,75 @@
+// Copyright (C) 2026 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <cassert>
+
+namespace nzsl::Ast
+{
+	inline InternedType::InternedType(std::nullopt_t)
+	{
+	}
+
+	inline InternedType::InternedType(const std::optional<ExpressionType>& type)
+	{
+		if (type)
+			*this = InternedType(*type);
+	}
+
+	template<typename T, typename>
+	InternedType::InternedType(T&& type) :
+	InternedType(ExpressionType(std::forward<T>(type)))
+	{
+	}
+
+	inline std::size_t InternedType::GetHash() const
+	{
+		return std::hash<const ExpressionType*>{}(m_type);
+	}
+
+	inline const ExpressionType* InternedType::GetType() const
+	{
+		return m_type;
+	}
+
+	inline bool InternedType::has_value() const
+	{
+		return m_type != nullptr;
+	}
+
+	inline void InternedType::reset()
+	{
+		m_type = nullptr;
+	}
+
+	inline const ExpressionType& InternedType::value() const
+	{
+		assert(m_type);
+		return *m_type;
+	}
+
+	inline InternedType::operator bool() const
+	{
+		return has_value();
+	}
+
+	inline const ExpressionType& InternedType::operator*() const
+	{
+		return value();
+	}
+
+	inline const ExpressionType* InternedType::operator->() const
+	{
+		return m_type;
+	}
+
+	inline bool InternedType::operator==(const InternedType& other) const
+	{
+		return m_type == other.m_type;
+	}
+
+	inline bool InternedType::operator!=(const InternedType& other) const
+	{
+		return !operator==(other);
+	}
+}
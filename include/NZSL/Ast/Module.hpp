@@ -9,6 +9,7 @@
 
 #include <NZSL/Config.hpp>
 #include <NZSL/Ast/Enums.hpp>
+#include <NZSL/Ast/NodeArena.hpp>
 #include <NZSL/Ast/Nodes.hpp>
 #include <memory>
 #include <vector>
@@ -53,6 +54,7 @@ namespace nzsl::Ast
 			};
 
 			std::shared_ptr<const Metadata> metadata;
+			std::shared_ptr<NodeArena> arena; //< if set, nodes created when transforming this module are allocated from it (and must not outlive it)
 			std::vector<ImportedModule> importedModules;
 			MultiStatementPtr rootNode;
 	};
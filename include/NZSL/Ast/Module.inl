@@ -6,7 +6,8 @@
 
 namespace nzsl::Ast
 {
-	inline Module::Module(std::uint32_t langVersion, std::string moduleName)
+	inline Module::Module(std::uint32_t langVersion, std::string moduleName) :
+	arena(NodeArena::GetCurrent())
 	{
 		auto mutMetadata = std::make_shared<Metadata>();
 		mutMetadata->moduleName = std::move(moduleName);
@@ -23,6 +24,7 @@ namespace nzsl::Ast
 
 	inline Module::Module(std::shared_ptr<const Metadata> Metadata, MultiStatementPtr RootNode, std::vector<ImportedModule> ImportedModules) :
 	metadata(std::move(Metadata)),
+	arena(NodeArena::GetCurrent()),
 	importedModules(std::move(ImportedModules)),
 	rootNode(std::move(RootNode))
 	{
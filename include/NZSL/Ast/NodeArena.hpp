@@ -0,0 +1,68 @@
+// Copyright (C) 2026 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NZSL_AST_NODEARENA_HPP
+#define NZSL_AST_NODEARENA_HPP
+
+#include <NZSL/Config.hpp>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace nzsl::Ast
+{
+	// Monotonic allocator for AST nodes, nodes allocated while a scope is active come from it and its memory is released at once with the arena
+	// Nodes don't keep their arena alive: the module created under the scope owns it and arena nodes must not outlive it
+	// An arena is not thread-safe and must only be used by one thread at a time (which is the case for a module being parsed or transformed)
+	class NZSL_API NodeArena
+	{
+		public:
+			class Scope;
+
+			inline NodeArena(std::size_t blockSize = DefaultBlockSize);
+			NodeArena(const NodeArena&) = delete;
+			NodeArena(NodeArena&&) = delete;
+			~NodeArena() = default;
+
+			void* Allocate(std::size_t size);
+
+			inline std::size_t GetAllocatedSize() const;
+			inline std::size_t GetBlockCount() const;
+
+			NodeArena& operator=(const NodeArena&) = delete;
+			NodeArena& operator=(NodeArena&&) = delete;
+
+			static const std::shared_ptr<NodeArena>& GetCurrent();
+
+			static constexpr std::size_t DefaultBlockSize = 64 * 1024;
+
+		private:
+			std::size_t m_allocatedSize;
+			std::size_t m_blockSize;
+			std::size_t m_freeOffset;
+			std::vector<std::unique_ptr<std::byte[]>> m_blocks;
+	};
+
+	// Makes an arena (or the heap if null) the source of nodes allocated on this thread, until the scope ends
+	class NZSL_API NodeArena::Scope
+	{
+		public:
+			explicit Scope(std::shared_ptr<NodeArena> arena);
+			Scope(const Scope&) = delete;
+			Scope(Scope&&) = delete;
+			~Scope();
+
+			Scope& operator=(const Scope&) = delete;
+			Scope& operator=(Scope&&) = delete;
+
+		private:
+			std::shared_ptr<NodeArena> m_previousArena;
+	};
+}
+
+#include <NZSL/Ast/NodeArena.inl>
+
+#endif // NZSL_AST_NODEARENA_HPP
@@ -0,0 +1,23 @@
+// Copyright (C) 2026 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+namespace nzsl::Ast
+{
+	inline NodeArena::NodeArena(std::size_t blockSize) :
+	m_allocatedSize(0),
+	m_blockSize(blockSize),
+	m_freeOffset(blockSize)
+	{
+	}
+
+	inline std::size_t NodeArena::GetAllocatedSize() const
+	{
+		return m_allocatedSize;
+	}
+
+	inline std::size_t NodeArena::GetBlockCount() const
+	{
+		return m_blocks.size();
+	}
+}
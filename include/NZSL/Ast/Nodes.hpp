@@ -12,6 +12,8 @@
 #include <NZSL/Ast/Enums.hpp>
 #include <NZSL/Ast/ExpressionType.hpp>
 #include <NZSL/Ast/ExpressionValue.hpp>
+#include <NZSL/Ast/InternedString.hpp>
+#include <NZSL/Ast/InternedType.hpp>
 #include <NZSL/Lang/SourceLocation.hpp>
 #include <array>
 #include <memory>
@@ -30,6 +32,7 @@ namespace nzsl::Ast
 		InOut,
 	};
 
+	struct DeferredFunctionBody;
 	struct Node;
 
 	using NodePtr = std::unique_ptr<Node>;
@@ -46,6 +49,14 @@ namespace nzsl::Ast
 		Node& operator=(const Node&) = delete;
 		Node& operator=(Node&&) noexcept = default;
 
+		// Nodes are allocated from the current NodeArena, if any
+		static void* operator new(std::size_t size);
+		static void operator delete(void* ptr);
+
+		// Number of nodes (and their size) allocated by the calling thread so far, for instrumentation purposes
+		static std::size_t GetThreadAllocatedBytes();
+		static std::size_t GetThreadAllocationCount();
+
 		SourceLocation sourceLocation;
 	};
 
@@ -67,7 +78,7 @@ namespace nzsl::Ast
 		Expression& operator=(const Expression&) = delete;
 		Expression& operator=(Expression&&) noexcept = default;
 
-		std::optional<ExpressionType> cachedExpressionType;
+		InternedType cachedExpressionType;
 	};
 
 	struct NZSL_API AccessFieldExpression : Expression
@@ -86,7 +97,7 @@ namespace nzsl::Ast
 
 		struct Identifier
 		{
-			std::string identifier;
+			InternedString identifier;
 			SourceLocation sourceLocation;
 		};
 
@@ -188,7 +199,7 @@ namespace nzsl::Ast
 		NodeType GetType() const override;
 		void Visit(ExpressionVisitor& visitor) override;
 
-		std::string identifier;
+		InternedString identifier;
 	};
 
 	struct NZSL_API IdentifierValueExpression : Expression
@@ -365,6 +376,8 @@ namespace nzsl::Ast
 		ExpressionValue<Vector3u32> workgroupSize;
 		ExpressionValue<bool> earlyFragmentTests;
 		ExpressionValue<bool> isExported;
+		std::shared_ptr<const DeferredFunctionBody> deferredBody; //< unparsed body tokens (statements is empty while set), see Parser::Options
+		std::shared_ptr<const DeclareFunctionStatement> sharedBody; //< function whose statements are shared until they have to be modified (statements is empty while set)
 	};
 
 	struct NZSL_API DeclareOptionStatement : Statement
@@ -376,6 +389,7 @@ namespace nzsl::Ast
 		std::string optName;
 		ExpressionPtr defaultValue;
 		ExpressionValue<ExpressionType> optType;
+		bool isCompileTimeUsed = false; //< value was required at compile time (const if, array sizes, ...), it cannot become a specialization constant
 	};
 
 	struct NZSL_API DeclareStructStatement : Statement
@@ -505,7 +519,6 @@ namespace nzsl::Ast
 
 	const ExpressionType& EnsureExpressionType(const Expression& expr);
 	inline const ExpressionType* GetExpressionType(const Expression& expr);
-	inline ExpressionType* GetExpressionTypeMut(Expression& expr);
 	inline bool IsExpression(NodeType nodeType);
 	inline bool IsStatement(NodeType nodeType);
 
@@ -7,12 +7,7 @@ namespace nzsl::Ast
 {
 	inline const ExpressionType* GetExpressionType(const Expression& expr)
 	{
-		return (expr.cachedExpressionType) ? &expr.cachedExpressionType.value() : nullptr;
-	}
-
-	inline ExpressionType* GetExpressionTypeMut(Expression& expr)
-	{
-		return (expr.cachedExpressionType) ? &expr.cachedExpressionType.value() : nullptr;
+		return expr.cachedExpressionType.GetType();
 	}
 
 	inline bool IsExpression(NodeType nodeType)
@@ -0,0 +1,77 @@
+// Copyright (C) 2026 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NZSL_AST_PASSINSTRUMENTATION_HPP
+#define NZSL_AST_PASSINSTRUMENTATION_HPP
+
+#include <NZSL/Config.hpp>
+#include <chrono>
+#include <functional>
+#include <string_view>
+
+namespace nzsl::Ast
+{
+	struct TransformerContext;
+
+	struct PassStatistics
+	{
+		std::chrono::nanoseconds duration;
+		std::size_t allocatedBytes;
+		std::size_t allocationCount;
+		std::size_t createdNodeCount;
+		std::size_t replacedNodeCount; //< nodes replaced or removed by transformers
+		std::size_t visitedNodeCount; //< nodes visited by transformers
+		std::string_view passName;
+	};
+
+	struct PassInstrumentation
+	{
+		class Scope;
+
+		struct AllocationCounters
+		{
+			std::size_t allocatedBytes = 0;
+			std::size_t allocationCount = 0;
+		};
+
+		inline bool IsEnabled() const;
+
+		// Returns the allocation counters of the calling thread, allows a custom allocator to report every allocation made by a pass (only node allocations are reported if unset)
+		std::function<AllocationCounters()> allocationCounters;
+
+		// Called once a pass is over, instrumentation is disabled if unset
+		std::function<void(const PassStatistics& statistics)> callback;
+	};
+
+	// Measures a pass from its construction to its destruction and reports it to the instrumentation callback
+	class NZSL_API PassInstrumentation::Scope
+	{
+		public:
+			Scope(const PassInstrumentation& instrumentation, std::string_view passName, const TransformerContext* context = nullptr);
+			Scope(const Scope&) = delete;
+			Scope(Scope&&) = delete;
+			~Scope();
+
+			Scope& operator=(const Scope&) = delete;
+			Scope& operator=(Scope&&) = delete;
+
+		private:
+			AllocationCounters QueryAllocationCounters() const;
+
+			std::chrono::steady_clock::time_point m_startTime;
+			std::size_t m_createdNodeCount;
+			std::size_t m_replacedNodeCount;
+			std::size_t m_visitedNodeCount;
+			std::string_view m_passName;
+			AllocationCounters m_allocationCounters;
+			const PassInstrumentation& m_instrumentation;
+			const TransformerContext* m_context;
+	};
+}
+
+#include <NZSL/Ast/PassInstrumentation.inl>
+
+#endif // NZSL_AST_PASSINSTRUMENTATION_HPP
@@ -0,0 +1,11 @@
+// Copyright (C) 2026 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+namespace nzsl::Ast
+{
+	inline bool PassInstrumentation::IsEnabled() const
+	{
+		return static_cast<bool>(callback);
+	}
+}
@@ -10,15 +10,20 @@
 #include <NZSL/Config.hpp>
 #include <NZSL/Ast/ExpressionVisitor.hpp>
 #include <NZSL/Ast/StatementVisitor.hpp>
+#include <NZSL/Ast/StaticRecursiveVisitor.hpp>
 
 namespace nzsl::Ast
 {
-	class NZSL_API RecursiveVisitor : public ExpressionVisitor, public StatementVisitor
+	class NZSL_API RecursiveVisitor : public ExpressionVisitor, public StatementVisitor, public StaticRecursiveVisitor<RecursiveVisitor>
 	{
 		public:
 			RecursiveVisitor() = default;
 			~RecursiveVisitor() = default;
 
+			// Visit methods are virtual anyway, so children are dispatched through Node::Visit rather than a switch on their type
+			inline void Dispatch(Expression& node);
+			inline void Dispatch(Statement& node);
+
 			void Visit(AccessFieldExpression& node) override;
 			void Visit(AccessIdentifierExpression& node) override;
 			void Visit(AccessIndexExpression& node) override;
@@ -3,6 +3,15 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 
-namespace nzsl
+namespace nzsl::Ast
 {
+	inline void RecursiveVisitor::Dispatch(Expression& node)
+	{
+		node.Visit(*this);
+	}
+
+	inline void RecursiveVisitor::Dispatch(Statement& node)
+	{
+		node.Visit(*this);
+	}
 }
@@ -0,0 +1,65 @@
+// Copyright (C) 2026 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NZSL_AST_RESOLVEDMODULECACHE_HPP
+#define NZSL_AST_RESOLVEDMODULECACHE_HPP
+
+#include <NZSL/Config.hpp>
+#include <NZSL/Ast/Module.hpp>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace nzsl::Ast
+{
+	// Keeps a pre-resolved (partially compiled) form of imported modules, so compilations importing the same module only have to relocate its indices
+	// Entries are keyed by module name and invalidated when the module content changes (i.e. when the module got updated, in place or not)
+	// If the module resolver reports a version for the module, it is recognized by its version instead of hashing and comparing its content
+	// A cache can be shared between compilations running on different threads, a module is only resolved once even if retrieved concurrently
+	class NZSL_API ResolvedModuleCache
+	{
+		public:
+			ResolvedModuleCache() = default;
+			ResolvedModuleCache(const ResolvedModuleCache&) = delete;
+			ResolvedModuleCache(ResolvedModuleCache&&) = delete;
+			~ResolvedModuleCache() = default;
+
+			void Clear();
+
+			inline std::size_t GetEntryCount() const;
+
+			void Invalidate(const std::string& moduleName);
+
+			std::shared_ptr<const Module> Retrieve(const ModulePtr& module, std::optional<std::uint64_t> moduleVersion = std::nullopt);
+
+			ResolvedModuleCache& operator=(const ResolvedModuleCache&) = delete;
+			ResolvedModuleCache& operator=(ResolvedModuleCache&&) = delete;
+
+		private:
+			static ModulePtr CloneModule(const Module& module);
+			static std::shared_ptr<const Module> ResolveModule(const Module& module);
+
+			struct Entry
+			{
+				std::shared_future<std::shared_ptr<const Module>> resolvedModule;
+				std::optional<std::uint64_t> moduleVersion;
+				std::size_t sourceHash;
+				std::weak_ptr<const Module> versionedModule; //< module the version was reported for, as the version of another module isn't related
+				ModulePtr sourceModule; //< copy of the module the entry was resolved from
+			};
+
+			mutable std::mutex m_mutex;
+			std::unordered_map<std::string, std::shared_ptr<Entry>> m_entries;
+	};
+}
+
+#include <NZSL/Ast/ResolvedModuleCache.inl>
+
+#endif // NZSL_AST_RESOLVEDMODULECACHE_HPP
@@ -0,0 +1,12 @@
+// Copyright (C) 2026 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+namespace nzsl::Ast
+{
+	inline std::size_t ResolvedModuleCache::GetEntryCount() const
+	{
+		std::lock_guard lock(m_mutex);
+		return m_entries.size();
+	}
+}
@@ -0,0 +1,72 @@
+// Copyright (C) 2026 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NZSL_AST_STATICRECURSIVEVISITOR_HPP
+#define NZSL_AST_STATICRECURSIVEVISITOR_HPP
+
+#include <NZSL/Config.hpp>
+#include <NZSL/Ast/StaticVisitor.hpp>
+
+namespace nzsl::Ast
+{
+	// Statically dispatched counterpart of RecursiveVisitor, Derived hides the Visit overloads it wants to handle
+	// and calls StaticRecursiveVisitor::Visit to visit children (children go through Derived::Dispatch, which can be hidden as well)
+	template<typename Derived>
+	class StaticRecursiveVisitor : public StaticVisitor<Derived>
+	{
+		public:
+			inline void Visit(AccessFieldExpression& node);
+			inline void Visit(AccessIdentifierExpression& node);
+			inline void Visit(AccessIndexExpression& node);
+			inline void Visit(AssignExpression& node);
+			inline void Visit(BinaryExpression& node);
+			inline void Visit(CallFunctionExpression& node);
+			inline void Visit(CallMethodExpression& node);
+			inline void Visit(CastExpression& node);
+			inline void Visit(ConditionalExpression& node);
+			inline void Visit(ConstantArrayValueExpression& node);
+			inline void Visit(ConstantValueExpression& node);
+			inline void Visit(IdentifierExpression& node);
+			inline void Visit(IdentifierValueExpression& node);
+			inline void Visit(IntrinsicExpression& node);
+			inline void Visit(SwizzleExpression& node);
+			inline void Visit(TypeConstantExpression& node);
+			inline void Visit(UnaryExpression& node);
+
+			inline void Visit(BranchStatement& node);
+			inline void Visit(BreakStatement& node);
+			inline void Visit(ConditionalStatement& node);
+			inline void Visit(ContinueStatement& node);
+			inline void Visit(DeclareAliasStatement& node);
+			inline void Visit(DeclareConstStatement& node);
+			inline void Visit(DeclareExternalStatement& node);
+			inline void Visit(DeclareFunctionStatement& node);
+			inline void Visit(DeclareOptionStatement& node);
+			inline void Visit(DeclareStructStatement& node);
+			inline void Visit(DeclareVariableStatement& node);
+			inline void Visit(DiscardStatement& node);
+			inline void Visit(ExpressionStatement& node);
+			inline void Visit(ForStatement& node);
+			inline void Visit(ForEachStatement& node);
+			inline void Visit(ImportStatement& node);
+			inline void Visit(MultiStatement& node);
+			inline void Visit(NoOpStatement& node);
+			inline void Visit(ReturnStatement& node);
+			inline void Visit(ScopedStatement& node);
+			inline void Visit(WhileStatement& node);
+
+		protected:
+			StaticRecursiveVisitor() = default;
+			~StaticRecursiveVisitor() = default;
+
+		private:
+			template<typename T> void DispatchChild(T& node);
+	};
+}
+
+#include <NZSL/Ast/StaticRecursiveVisitor.inl>
+
+#endif // NZSL_AST_STATICRECURSIVEVISITOR_HPP
@@ -0,0 +1,288 @@
+// Copyright (C) 2026 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+
+namespace nzsl::Ast
+{
+	template<typename Derived>
+	template<typename T>
+	void StaticRecursiveVisitor<Derived>::DispatchChild(T& node)
+	{
+		static_cast<Derived&>(*this).Dispatch(node);
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(AccessFieldExpression& node)
+	{
+		DispatchChild(*node.expr);
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(AccessIdentifierExpression& node)
+	{
+		DispatchChild(*node.expr);
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(AccessIndexExpression& node)
+	{
+		DispatchChild(*node.expr);
+		for (auto& index : node.indices)
+			DispatchChild(*index);
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(AssignExpression& node)
+	{
+		DispatchChild(*node.left);
+		DispatchChild(*node.right);
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(BinaryExpression& node)
+	{
+		DispatchChild(*node.left);
+		DispatchChild(*node.right);
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(CallFunctionExpression& node)
+	{
+		for (auto& param : node.parameters)
+			DispatchChild(*param.expr);
+
+		DispatchChild(*node.targetFunction);
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(CallMethodExpression& node)
+	{
+		DispatchChild(*node.object);
+
+		for (auto& param : node.parameters)
+			DispatchChild(*param);
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(CastExpression& node)
+	{
+		for (auto& expr : node.expressions)
+			DispatchChild(*expr);
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(ConditionalExpression& node)
+	{
+		DispatchChild(*node.truePath);
+		DispatchChild(*node.falsePath);
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(ConstantArrayValueExpression& /*node*/)
+	{
+		/* Nothing to do */
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(ConstantValueExpression& /*node*/)
+	{
+		/* Nothing to do */
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(IdentifierExpression& /*node*/)
+	{
+		/* Nothing to do */
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(IdentifierValueExpression& /*node*/)
+	{
+		/* Nothing to do */
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(IntrinsicExpression& node)
+	{
+		for (auto& param : node.parameters)
+			DispatchChild(*param);
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(SwizzleExpression& node)
+	{
+		if (node.expression)
+			DispatchChild(*node.expression);
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(TypeConstantExpression& /*node*/)
+	{
+		/* Nothing to do */
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(UnaryExpression& node)
+	{
+		if (node.expression)
+			DispatchChild(*node.expression);
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(BranchStatement& node)
+	{
+		for (auto& cond : node.condStatements)
+		{
+			DispatchChild(*cond.condition);
+			DispatchChild(*cond.statement);
+		}
+
+		if (node.elseStatement)
+			DispatchChild(*node.elseStatement);
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(BreakStatement& /*node*/)
+	{
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(ConditionalStatement& node)
+	{
+		DispatchChild(*node.statement);
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(ContinueStatement& /*node*/)
+	{
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(DeclareAliasStatement& node)
+	{
+		if (node.expression)
+			DispatchChild(*node.expression);
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(DeclareConstStatement& node)
+	{
+		if (node.expression)
+			DispatchChild(*node.expression);
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(DeclareExternalStatement& /*node*/)
+	{
+		/* Nothing to do */
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(DeclareFunctionStatement& node)
+	{
+		for (auto& statement : node.statements)
+			DispatchChild(*statement);
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(DeclareOptionStatement& node)
+	{
+		if (node.defaultValue)
+			DispatchChild(*node.defaultValue);
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(DeclareStructStatement& /*node*/)
+	{
+		/* Nothing to do */
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(DeclareVariableStatement& node)
+	{
+		if (node.initialExpression)
+			DispatchChild(*node.initialExpression);
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(DiscardStatement& /*node*/)
+	{
+		/* Nothing to do */
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(ExpressionStatement& node)
+	{
+		DispatchChild(*node.expression);
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(ForStatement& node)
+	{
+		if (node.fromExpr)
+			DispatchChild(*node.fromExpr);
+
+		if (node.toExpr)
+			DispatchChild(*node.toExpr);
+
+		if (node.stepExpr)
+			DispatchChild(*node.stepExpr);
+
+		if (node.statement)
+			DispatchChild(*node.statement);
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(ForEachStatement& node)
+	{
+		if (node.expression)
+			DispatchChild(*node.expression);
+
+		if (node.statement)
+			DispatchChild(*node.statement);
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(ImportStatement& /*node*/)
+	{
+		/* nothing to do */
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(MultiStatement& node)
+	{
+		for (auto& statement : node.statements)
+			DispatchChild(*statement);
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(NoOpStatement& /*node*/)
+	{
+		/* Nothing to do */
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(ReturnStatement& node)
+	{
+		if (node.returnExpr)
+			DispatchChild(*node.returnExpr);
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(ScopedStatement& node)
+	{
+		if (node.statement)
+			DispatchChild(*node.statement);
+	}
+
+	template<typename Derived>
+	void StaticRecursiveVisitor<Derived>::Visit(WhileStatement& node)
+	{
+		if (node.condition)
+			DispatchChild(*node.condition);
+
+		if (node.body)
+			DispatchChild(*node.body);
+	}
+}
@@ -0,0 +1,38 @@
+// Copyright (C) 2026 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NZSL_AST_STATICVISITOR_HPP
+#define NZSL_AST_STATICVISITOR_HPP
+
+#include <NZSL/Config.hpp>
+#include <NZSL/Ast/Nodes.hpp>
+
+namespace nzsl::Ast
+{
+	// Dispatches nodes to Derived::Visit(ConcreteNode&) with a switch on their type instead of double virtual dispatch,
+	// allowing the compiler to inline handlers (Derived has to befriend this class if its Visit methods aren't public)
+	// Dispatch itself is never inlined, as inlining it in handlers recursively bloats them and was measured slower
+	template<typename Derived>
+	class StaticVisitor
+	{
+		public:
+			void Dispatch(Expression& node);
+			void Dispatch(Statement& node);
+
+		protected:
+			StaticVisitor() = default;
+			StaticVisitor(const StaticVisitor&) = default;
+			StaticVisitor(StaticVisitor&&) = default;
+			~StaticVisitor() = default;
+
+			StaticVisitor& operator=(const StaticVisitor&) = default;
+			StaticVisitor& operator=(StaticVisitor&&) = default;
+	};
+}
+
+#include <NZSL/Ast/StaticVisitor.inl>
+
+#endif // NZSL_AST_STATICVISITOR_HPP
@@ -0,0 +1,35 @@
+// Copyright (C) 2026 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+
+namespace nzsl::Ast
+{
+	template<typename Derived>
+	NZSL_NOINLINE void StaticVisitor<Derived>::Dispatch(Expression& node)
+	{
+		Derived& derived = static_cast<Derived&>(*this);
+		switch (node.GetType())
+		{
+#define NZSL_SHADERAST_EXPRESSION(Node) case NodeType::Node##Expression: return derived.Visit(static_cast<Node##Expression&>(node));
+#include <NZSL/Ast/NodeList.hpp>
+
+			default:
+				NAZARA_UNREACHABLE();
+		}
+	}
+
+	template<typename Derived>
+	NZSL_NOINLINE void StaticVisitor<Derived>::Dispatch(Statement& node)
+	{
+		Derived& derived = static_cast<Derived&>(*this);
+		switch (node.GetType())
+		{
+#define NZSL_SHADERAST_STATEMENT(Node) case NodeType::Node##Statement: return derived.Visit(static_cast<Node##Statement&>(node));
+#include <NZSL/Ast/NodeList.hpp>
+
+			default:
+				NAZARA_UNREACHABLE();
+		}
+	}
+}
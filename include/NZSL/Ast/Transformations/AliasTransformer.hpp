@@ -26,6 +26,8 @@ namespace nzsl::Ast
 				bool removeAliases = true;
 			};
 
+			static constexpr std::string_view PassName = "Alias";
+
 		private:
 			using Transformer::Transform;
 
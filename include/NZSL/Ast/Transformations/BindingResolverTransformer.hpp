@@ -29,6 +29,8 @@ namespace nzsl::Ast
 				bool forceAutoBindingResolve = false;
 			};
 
+			static constexpr std::string_view PassName = "BindingResolver";
+
 		private:
 			using Transformer::Transform;
 
@@ -25,6 +25,10 @@ namespace nzsl::Ast
 			{
 			};
 
+			static constexpr NodeTypeFlags FusableNodes = NodeType::BranchStatement;
+			static constexpr NodeTypeFlags ProducedNodes = NodeType::BranchStatement;
+			static constexpr std::string_view PassName = "BranchSplitter";
+
 		private:
 			using Transformer::Transform;
 
@@ -26,6 +26,11 @@ namespace nzsl::Ast
 				bool removeCompoundAssignment = false;
 			};
 
+			static constexpr NodeTypeFlags FusableNodes = NodeType::AssignExpression;
+			static constexpr NodeTypeFlags ProducedNodes = NodeType::BinaryExpression;
+			static constexpr NodeTraitFlags ProducedTraits = NodeTrait::MatrixAddSub; //< from compound assignments of matrices
+			static constexpr std::string_view PassName = "CompoundAssignment";
+
 		private:
 			using Transformer::Transform;
 			ExpressionTransformation Transform(AssignExpression&& assign) override;
@@ -40,6 +40,8 @@ namespace nzsl::Ast
 
 			template<typename T, typename Other> static auto ResolveUntypedIfNecessary(T value);
 
+			static constexpr std::string_view PassName = "ConstantPropagation";
+
 		protected:
 			using Transformer::Transform;
 
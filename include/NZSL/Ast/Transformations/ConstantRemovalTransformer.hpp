@@ -23,13 +23,18 @@ namespace nzsl::Ast
 
 			struct Options
 			{
+				bool keepUnsetScalarOptions = false; //< scalar options without a value are kept (with their default value resolved) instead of being replaced, unless their value was required at compile time
 				bool removeConstArraySize = true;
 				bool removeConstantDeclaration = true;
 				bool removeOptionDeclaration = true;
 				bool removeTypeConstant = true;
 				bool replaceExpressionWithValue = true;
+				bool replaceOptionsOnly = false; //< only options with a value are replaced, constants and other options are left as is (the context doesn't have to be the one which resolved the module)
 			};
 
+			static constexpr NodeTypeFlags ProducedNodes = NodeType::ConstantArrayValueExpression | NodeType::ConstantValueExpression | NodeType::NoOpStatement;
+			static constexpr std::string_view PassName = "ConstantRemoval";
+
 		private:
 			using Transformer::Transform;
 
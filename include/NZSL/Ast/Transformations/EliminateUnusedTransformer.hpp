@@ -28,6 +28,8 @@ namespace nzsl::Ast
 			EliminateUnusedTransformer& operator=(const EliminateUnusedTransformer&) = delete;
 			EliminateUnusedTransformer& operator=(EliminateUnusedTransformer&&) = delete;
 
+			static constexpr std::string_view PassName = "EliminateUnused";
+
 		private:
 			using Transformer::Transform;
 
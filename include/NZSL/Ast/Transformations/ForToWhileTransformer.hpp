@@ -27,6 +27,9 @@ namespace nzsl::Ast
 				bool reduceForLoopsToWhile = true;
 			};
 
+			static constexpr NodeTypeFlags TriggerNodes = NodeType::ForStatement | NodeType::ForEachStatement;
+			static constexpr std::string_view PassName = "ForToWhile";
+
 		private:
 			using Transformer::Transform;
 			StatementTransformation Transform(ContinueStatement&& statement) override;
@@ -0,0 +1,52 @@
+// Copyright (C) 2026 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NZSL_AST_TRANSFORMATIONS_FUSEDTRANSFORMER_HPP
+#define NZSL_AST_TRANSFORMATIONS_FUSEDTRANSFORMER_HPP
+
+#include <NZSL/Ast/Transformations/Transformer.hpp>
+#include <array>
+#include <vector>
+
+namespace nzsl::Ast
+{
+	// Runs multiple transformers in a single traversal of the module, each node being handed to the member transforming its type.
+	// Members must declare the node types they transform (and no two members can transform the same node type), must not override
+	// scope or type hooks and must traverse every node they create (through HandleExpression/HandleStatement or by visiting children)
+	class NZSL_API FusedTransformer final : public Transformer
+	{
+		public:
+			FusedTransformer() = default;
+			FusedTransformer(const FusedTransformer&) = delete;
+			FusedTransformer(FusedTransformer&&) = delete;
+			~FusedTransformer();
+
+			void AddTransformer(Transformer& transformer, NodeTypeFlags transformedNodes);
+
+			bool Transform(Module& module, TransformerContext& context, std::string* error = nullptr);
+
+			FusedTransformer& operator=(const FusedTransformer&) = delete;
+			FusedTransformer& operator=(FusedTransformer&&) = delete;
+
+		private:
+			using Transformer::Transform;
+
+#define NZSL_SHADERAST_NODE(Node, Type) Type##Transformation Transform(Node##Type&& node) override;
+#include <NZSL/Ast/NodeList.hpp>
+
+			struct Member
+			{
+				Transformer* transformer;
+				TransformerFlags flags;
+			};
+
+			std::array<Transformer*, NodeTypeCount> m_nodeTransformers = {};
+			std::vector<Member> m_members;
+			NodeTypeFlags m_transformedNodes;
+	};
+}
+
+#endif // NZSL_AST_TRANSFORMATIONS_FUSEDTRANSFORMER_HPP
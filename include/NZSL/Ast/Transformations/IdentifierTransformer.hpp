@@ -27,6 +27,8 @@ namespace nzsl::Ast
 				bool makeVariableNameUnique = true;
 			};
 
+			static constexpr std::string_view PassName = "Identifier";
+
 		private:
 			using Transformer::Transform;
 
@@ -10,6 +10,7 @@
 #include <NZSL/Config.hpp>
 #include <NZSL/Ast/Transformations/Transformer.hpp>
 #include <functional>
+#include <optional>
 
 namespace nzsl::Ast
 {
@@ -31,10 +32,15 @@ namespace nzsl::Ast
 			struct Options
 			{
 				std::function<std::size_t(IdentifierType identifierType, std::size_t previousIndex)> indexGenerator;
+				std::function<std::optional<std::size_t>(IdentifierType identifierType, std::size_t previousIndex)> indexLookup; //< optional, used for indices which aren't declared in the remapped statement
 				bool forceIndexGeneration = false;
 			};
 
+			static constexpr std::string_view PassName = "IndexRemapper";
+
 		private:
+			bool ShouldTransformType(const ExpressionType& expressionType) const override;
+
 			void Transform(ExpressionType& expressionType, const SourceLocation& sourceLocation) override;
 
 			ExpressionTransformation Transform(IdentifierValueExpression&& node) override;
@@ -49,6 +55,8 @@ namespace nzsl::Ast
 			StatementTransformation Transform(ForStatement&& node) override;
 			StatementTransformation Transform(ForEachStatement&& node) override;
 
+			std::optional<std::size_t> FindNewIndex(IdentifierType identifierType, std::size_t previousIndex) const;
+
 			struct Context;
 			Context* m_context;
 	};
@@ -26,6 +26,9 @@ namespace nzsl::Ast
 				bool resolveUntypedLiterals = true;
 			};
 
+			static constexpr NodeTypeFlags ProducedNodes = {};
+			static constexpr std::string_view PassName = "Literal";
+
 		private:
 			using Transformer::Transform;
 
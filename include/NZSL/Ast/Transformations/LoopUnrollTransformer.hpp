@@ -28,6 +28,10 @@ namespace nzsl::Ast
 				bool unrollForEachLoops = true;
 			};
 
+			static constexpr NodeTypeFlags TriggerNodes = NodeType::ForStatement | NodeType::ForEachStatement;
+			static constexpr NodeTraitFlags TriggerTraits = NodeTrait::UnrolledLoop;
+			static constexpr std::string_view PassName = "LoopUnroll";
+
 		private:
 			using Transformer::Transform;
 
@@ -27,6 +27,13 @@ namespace nzsl::Ast
 				bool removeMatrixCast = false;
 			};
 
+			static constexpr NodeTypeFlags FusableNodes = NodeType::BinaryExpression | NodeType::CastExpression;
+			static constexpr NodeTypeFlags ProducedNodes = NodeType::AccessIndexExpression | NodeType::AssignExpression | NodeType::BinaryExpression | NodeType::CastExpression | NodeType::ConstantValueExpression
+			                                             | NodeType::IdentifierValueExpression | NodeType::SwizzleExpression | NodeType::DeclareVariableStatement | NodeType::ExpressionStatement;
+			static constexpr NodeTraitFlags TriggerTraits = NodeTrait::MatrixAddSub | NodeTrait::MatrixCast;
+
+			static constexpr std::string_view PassName = "Matrix";
+
 		private:
 			using Transformer::Transform;
 
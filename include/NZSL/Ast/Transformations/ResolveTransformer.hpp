@@ -17,6 +17,7 @@ namespace nzsl
 
 namespace nzsl::Ast
 {
+	class ResolvedModuleCache;
 	struct PartialType;
 
 	class NZSL_API ResolveTransformer final : public Transformer
@@ -33,8 +34,11 @@ namespace nzsl::Ast
 			{
 				// TODO: Turn all of theses into separate passes
 				std::shared_ptr<ModuleResolver> moduleResolver;
+				std::shared_ptr<ResolvedModuleCache> resolvedModuleCache; //< if set, imported modules are resolved once and reused by every compilation sharing the cache
 			};
 
+			static constexpr std::string_view PassName = "Resolve";
+
 		private:
 			struct Environment;
 			struct NamedExternalBlock;
@@ -50,9 +54,10 @@ namespace nzsl::Ast
 			void EnsureLiteralValue(const ExpressionType& expressionType, ConstantValue& constantValue, const SourceLocation& sourceLocation);
 
 			const TransformerContext::IdentifierData* FindIdentifier(std::string_view identifierName) const;
-			template<typename F> const TransformerContext::IdentifierData* FindIdentifier(std::string_view identifierName, F&& functor) const;
-			const TransformerContext::IdentifierData* FindIdentifier(const Environment& environment, std::string_view identifierName) const;
-			template<typename F> const TransformerContext::IdentifierData* FindIdentifier(const Environment& environment, std::string_view identifierName, F&& functor) const;
+			const TransformerContext::IdentifierData* FindIdentifier(const InternedString& identifierName) const;
+			template<typename F> const TransformerContext::IdentifierData* FindIdentifier(const InternedString& identifierName, F&& functor) const;
+			const TransformerContext::IdentifierData* FindIdentifier(const Environment& environment, const InternedString& identifierName) const;
+			template<typename F> const TransformerContext::IdentifierData* FindIdentifier(const Environment& environment, const InternedString& identifierName, F&& functor) const;
 
 			ExpressionPtr HandleIdentifier(const TransformerContext::IdentifierData* identifierData, const SourceLocation& sourceLocation);
 
@@ -68,6 +73,7 @@ namespace nzsl::Ast
 			std::size_t RegisterConstant(std::string name, std::optional<TransformerContext::ConstantData>&& value, std::optional<std::size_t> index, const SourceLocation& sourceLocation);
 			std::size_t RegisterExternalBlock(std::string name, TransformerContext::ExternalBlockData&& namedExternalBlock, std::optional<std::size_t> index, const SourceLocation& sourceLocation);
 			std::size_t RegisterFunction(std::string name, std::optional<TransformerContext::FunctionData>&& funcData, std::optional<std::size_t> index, const SourceLocation& sourceLocation);
+			void RegisterIdentifier(InternedString name, const TransformerContext::IdentifierData& identifierData);
 			std::size_t RegisterIntrinsic(std::string name, TransformerContext::IntrinsicData&& intrinsicData, std::optional<std::size_t> index, const SourceLocation& sourceLocation);
 			std::size_t RegisterModule(std::string moduleIdentifier, TransformerContext::ModuleData&& moduleData, std::optional<std::size_t> index, const SourceLocation& sourceLocation);
 			std::size_t RegisterStruct(std::string name, std::optional<TransformerContext::StructData>&& description, std::optional<std::size_t> index, const SourceLocation& sourceLocation);
@@ -77,7 +83,11 @@ namespace nzsl::Ast
 
 			void PreregisterIndices(const Module& module);
 
+			void RemapImportedIndices(StatementPtr& statement, Environment& moduleEnvironment);
+
 			const TransformerContext::Identifier* ResolveAliasIdentifier(const TransformerContext::Identifier* identifier, const SourceLocation& sourceLocation) const;
+			void ResolveDeferredFunctions();
+			void ResolveFunctionBody(DeclareFunctionStatement& func);
 			void ResolveFunctions();
 			std::size_t ResolveStructIndex(const ExpressionType& exprType, const SourceLocation& sourceLocation);
 			ExpressionType ResolveType(const ExpressionType& exprType, bool resolveAlias, const SourceLocation& sourceLocation);
@@ -113,6 +123,8 @@ namespace nzsl::Ast
 			StatementTransformation Transform(ForStatement&& forStatement) override;
 			StatementTransformation Transform(ImportStatement&& importStatement) override;
 
+			bool ShouldTransformType(const ExpressionType& expressionType) const override;
+
 			void Transform(ExpressionType& expressionType, const SourceLocation& sourceLocation) override;
 			void Transform(ExpressionValue<ExpressionType>& expressionType, const SourceLocation& sourceLocation) override;
 
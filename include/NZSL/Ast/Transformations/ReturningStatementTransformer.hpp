@@ -25,6 +25,8 @@ namespace nzsl::Ast
 			{
 			};
 
+			static constexpr std::string_view PassName = "ReturningStatement";
+
 		private:
 			using Transformer::Transform;
 
@@ -27,6 +27,8 @@ namespace nzsl::Ast
 				bool splitWrappedStructAssignation = false;
 			};
 
+			static constexpr std::string_view PassName = "StructAssignment";
+
 		private:
 			using Transformer::Transform;
 
@@ -26,6 +26,10 @@ namespace nzsl::Ast
 				bool removeScalarSwizzling = false;
 			};
 
+			static constexpr NodeTypeFlags ProducedNodes = NodeType::CastExpression | NodeType::IdentifierValueExpression | NodeType::DeclareVariableStatement;
+			static constexpr NodeTypeFlags TriggerNodes = NodeType::SwizzleExpression;
+			static constexpr std::string_view PassName = "Swizzle";
+
 		private:
 			using Transformer::Transform;
 
@@ -10,10 +10,10 @@
 #include <NazaraUtils/Bitset.hpp>
 #include <NazaraUtils/FunctionRef.hpp>
 #include <NZSL/Config.hpp>
-#include <NZSL/Ast/ExpressionVisitor.hpp>
 #include <NZSL/Ast/Module.hpp>
 #include <NZSL/Ast/Option.hpp>
-#include <NZSL/Ast/StatementVisitor.hpp>
+#include <NZSL/Ast/StaticVisitor.hpp>
+#include <string_view>
 #include <unordered_map>
 
 namespace nzsl::Ast
@@ -34,7 +34,7 @@ namespace nzsl::Ast
 
 	using TransformerFlags = Nz::Flags<TransformerFlag>;
 
-	class NZSL_API Transformer : ExpressionVisitor, StatementVisitor
+	class NZSL_API Transformer : StaticVisitor<Transformer>
 	{
 		protected:
 			struct DontVisitChildren {};
@@ -121,10 +121,13 @@ namespace nzsl::Ast
 			virtual void PopScope();
 			virtual void PushScope();
 
-			void PropagateConstants(ExpressionPtr& expr) const;
+			void PropagateConstants(ExpressionPtr& expr, bool compileTimeUse = false) const;
 
 			inline void SetFlags(TransformerFlags flags);
 
+			// Cached expression types are interned, they are only copied and transformed if this returns true for them
+			virtual bool ShouldTransformType(const ExpressionType& expressionType) const;
+
 			std::string ToString(const ExpressionType& exprType, const SourceLocation& sourceLocation) const;
 
 #define NZSL_SHADERAST_NODE(Node, Type) virtual Type##Transformation Transform(Node##Type&& node);
@@ -132,6 +135,7 @@ namespace nzsl::Ast
 
 			virtual void Transform(ExpressionType& expressionType, const SourceLocation& sourceLocation);
 			virtual void Transform(ExpressionValue<ExpressionType>& expressionValue, const SourceLocation& sourceLocation);
+			void Transform(InternedType& type, const SourceLocation& sourceLocation);
 
 			bool TransformExpression(ExpressionPtr& expression, TransformerContext& context, std::string* error);
 			bool TransformImportedModules(Module& module, TransformerContext& context, std::string* error);
@@ -141,10 +145,13 @@ namespace nzsl::Ast
 			TransformerContext* m_context;
 
 		private:
+			friend class FusedTransformer;
+			friend StaticVisitor<Transformer>;
+
 			template<typename T> bool TransformCurrentExpression();
 			template<typename T> bool TransformCurrentStatement();
 
-#define NZSL_SHADERAST_NODE(Node, Type) void Visit(Node##Type& node) override;
+#define NZSL_SHADERAST_NODE(Node, Type) void Visit(Node##Type& node);
 #include <NZSL/Ast/NodeList.hpp>
 
 			std::size_t m_currentStatementListIndex;
@@ -152,6 +159,7 @@ namespace nzsl::Ast
 			std::vector<StatementPtr*> m_statementStack;
 			std::vector<StatementPtr>* m_currentStatementList;
 			TransformerFlags m_flags;
+			Transformer* m_traversalOwner; //< when set, the traversal is done by another transformer (see FusedTransformer)
 	};
 }
 
@@ -5,7 +5,9 @@
 namespace nzsl::Ast
 {
 	inline Transformer::Transformer(TransformerFlags flags) :
-	m_flags(flags)
+	m_context(nullptr),
+	m_flags(flags),
+	m_traversalOwner(nullptr)
 	{
 	}
 
@@ -29,6 +31,9 @@ namespace nzsl::Ast
 	template<bool Single, typename F>
 	void Transformer::HandleStatementList(std::vector<StatementPtr>& statementList, F&& callback)
 	{
+		if (m_traversalOwner)
+			return m_traversalOwner->HandleStatementList<Single>(statementList, std::forward<F>(callback));
+
 		std::vector<StatementPtr>* previousStatementList = m_currentStatementList;
 		std::size_t previousListIndex = m_currentStatementListIndex;
 
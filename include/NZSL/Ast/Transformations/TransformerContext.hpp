@@ -11,9 +11,12 @@
 #include <NZSL/Ast/ConstantValue.hpp>
 #include <NZSL/Ast/Enums.hpp>
 #include <NZSL/Ast/IdentifierList.hpp>
+#include <NZSL/Ast/InternedString.hpp>
+#include <NZSL/Ast/InternedType.hpp>
 #include <NZSL/Ast/Option.hpp>
 #include <NZSL/Ast/Types.hpp>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace nzsl::Ast
 {
@@ -30,7 +33,7 @@ namespace nzsl::Ast
 
 		struct Identifier
 		{
-			std::string name;
+			InternedString name;
 			IdentifierData target;
 		};
 
@@ -84,7 +87,7 @@ namespace nzsl::Ast
 
 		struct VariableData
 		{
-			ExpressionType type;
+			InternedType type;
 		};
 
 		TransformerContext();
@@ -107,6 +110,9 @@ namespace nzsl::Ast
 		IdentifierListWithValues<StructData> structs;
 		IdentifierListWithValues<TypeData> types;
 		IdentifierListWithValues<VariableData> variables;
+		std::unordered_set<std::size_t> compileTimeConstants; //< constants whose value was required at compile time (const if, const_select, array sizes, ...)
+		std::size_t replacedNodeCount = 0; //< nodes replaced or removed by transformers so far, for instrumentation purposes
+		std::size_t visitedNodeCount = 0; //< nodes visited by transformers so far, for instrumentation purposes
 		bool allowUnknownIdentifiers = false;
 		bool partialCompilation = false;
 	};
@@ -29,6 +29,8 @@ namespace nzsl::Ast
 				bool checkIndices = true;
 			};
 
+			static constexpr std::string_view PassName = "Validation";
+
 		private:
 			enum class ValidationResult;
 			struct FunctionData;
@@ -103,6 +105,8 @@ namespace nzsl::Ast
 			StatementTransformation Transform(ScopedStatement&& node) override;
 			StatementTransformation Transform(WhileStatement&& node) override;
 
+			bool ShouldTransformType(const ExpressionType& expressionType) const override;
+
 			void Transform(ExpressionType& expressionType, const SourceLocation& sourceLocation) override;
 
 			bool TransformModule(Module& module, TransformerContext& context, std::string* error, Nz::FunctionRef<void()> postCallback = nullptr) override;
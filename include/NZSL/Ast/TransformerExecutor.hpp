@@ -9,9 +9,15 @@
 
 #include <NazaraUtils/FunctionRef.hpp>
 #include <NZSL/Config.hpp>
+#include <NZSL/Ast/PassInstrumentation.hpp>
+#include <NZSL/Ast/Utils.hpp>
+#include <NZSL/Ast/Transformations/FusedTransformer.hpp>
 #include <NZSL/Ast/Transformations/TransformerContext.hpp>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 namespace nzsl::Ast
@@ -31,6 +37,17 @@ namespace nzsl::Ast
 			template<typename T> void AddPassAt(std::size_t index, const typename T::Options& options = {});
 			template<typename T> void AddPassAt(std::size_t index, Nz::FunctionRef<void(typename T::Options&)> callback);
 
+			inline void EnablePassFusion(bool enable);
+			inline void EnablePassSkipping(bool enable);
+
+			inline const PassInstrumentation& GetInstrumentation() const;
+			inline std::size_t GetTraversalCount() const;
+
+			inline bool IsPassFusionEnabled() const;
+			inline bool IsPassSkippingEnabled() const;
+
+			inline void SetInstrumentation(PassInstrumentation instrumentation);
+
 			inline bool Transform(Module& module, std::string* error = nullptr) const;
 			inline bool Transform(Module& module, TransformerContext& context, std::string* error = nullptr) const;
 
@@ -42,19 +59,66 @@ namespace nzsl::Ast
 			{
 				virtual ~PassInterface() = default;
 
+				virtual Transformer& GetTransformer() = 0;
+				virtual NodeTypeFlags GetFusableNodes() const = 0;
+				virtual std::string_view GetName() const = 0;
+				virtual std::optional<NodeTypeFlags> GetProducedNodes() const = 0;
+				virtual NodeTraitFlags GetProducedTraits() const = 0;
+				virtual std::optional<NodeTypeFlags> GetTriggerNodes() const = 0;
+				virtual std::optional<NodeTraitFlags> GetTriggerTraits() const = 0;
+				virtual bool IsFusable() const = 0;
+
 				virtual bool Transform(Module& module, TransformerContext& context, std::string* error = nullptr) = 0;
 			};
 
+			// Transformers declaring the node types they transform (FusableNodes) can share their traversal with neighboring passes
+			template<typename T, typename = void> struct IsFusableTransformer : std::false_type {};
+			template<typename T> struct IsFusableTransformer<T, std::void_t<decltype(T::FusableNodes)>> : std::true_type {};
+
+			// Transformers declaring the node types they can introduce (ProducedNodes) keep the node type summary of the module valid
+			template<typename T, typename = void> struct HasProducedNodes : std::false_type {};
+			template<typename T> struct HasProducedNodes<T, std::void_t<decltype(T::ProducedNodes)>> : std::true_type {};
+
+			// Along with them, transformers can declare the node traits they may introduce (ProducedTraits), none by default
+			template<typename T, typename = void> struct HasProducedTraits : std::false_type {};
+			template<typename T> struct HasProducedTraits<T, std::void_t<decltype(T::ProducedTraits)>> : std::true_type {};
+
+			// Transformers declaring the node types they act on (TriggerNodes, or FusableNodes) are skipped if none of them are present
+			template<typename T, typename = void> struct HasTriggerNodes : std::false_type {};
+			template<typename T> struct HasTriggerNodes<T, std::void_t<decltype(T::TriggerNodes)>> : std::true_type {};
+
+			// Transformers acting only on some operators or attributes of those nodes (TriggerTraits) are skipped if none of them are present
+			template<typename T, typename = void> struct HasTriggerTraits : std::false_type {};
+			template<typename T> struct HasTriggerTraits<T, std::void_t<decltype(T::TriggerTraits)>> : std::true_type {};
+
+			// Transformers declaring a name (PassName) are reported under it by instrumentation
+			template<typename T, typename = void> struct HasPassName : std::false_type {};
+			template<typename T> struct HasPassName<T, std::void_t<decltype(T::PassName)>> : std::true_type {};
+
 			template<typename T>
 			struct Pass : PassInterface
 			{
+				Transformer& GetTransformer() override;
+				NodeTypeFlags GetFusableNodes() const override;
+				std::string_view GetName() const override;
+				std::optional<NodeTypeFlags> GetProducedNodes() const override;
+				NodeTraitFlags GetProducedTraits() const override;
+				std::optional<NodeTypeFlags> GetTriggerNodes() const override;
+				std::optional<NodeTraitFlags> GetTriggerTraits() const override;
+				bool IsFusable() const override;
+
 				bool Transform(Module& module, TransformerContext& context, std::string* error) override;
 
 				T transformer;
 				typename T::Options options;
 			};
 
+			template<typename F> bool ForEachPassGroup(Module* module, F&& callback) const;
+
 			std::vector<std::unique_ptr<PassInterface>> m_passes;
+			PassInstrumentation m_instrumentation;
+			bool m_passFusion = true;
+			bool m_passSkipping = true;
 	};
 }
 
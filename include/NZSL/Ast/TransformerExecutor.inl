@@ -34,6 +34,49 @@ namespace nzsl::Ast
 		m_passes.emplace(m_passes.begin() + index, std::move(passPtr));
 	}
 
+	inline void TransformerExecutor::EnablePassFusion(bool enable)
+	{
+		m_passFusion = enable;
+	}
+
+	inline void TransformerExecutor::EnablePassSkipping(bool enable)
+	{
+		m_passSkipping = enable;
+	}
+
+	inline const PassInstrumentation& TransformerExecutor::GetInstrumentation() const
+	{
+		return m_instrumentation;
+	}
+
+	inline std::size_t TransformerExecutor::GetTraversalCount() const
+	{
+		// Passes skipped depending on the module content are not taken into account
+		std::size_t traversalCount = 0;
+		ForEachPassGroup(nullptr, [&](const std::vector<PassInterface*>& /*passGroup*/)
+		{
+			traversalCount++;
+			return true;
+		});
+
+		return traversalCount;
+	}
+
+	inline bool TransformerExecutor::IsPassFusionEnabled() const
+	{
+		return m_passFusion;
+	}
+
+	inline bool TransformerExecutor::IsPassSkippingEnabled() const
+	{
+		return m_passSkipping;
+	}
+
+	inline void TransformerExecutor::SetInstrumentation(PassInstrumentation instrumentation)
+	{
+		m_instrumentation = std::move(instrumentation);
+	}
+
 	inline bool TransformerExecutor::Transform(Module& module, std::string* error) const
 	{
 		TransformerContext context;
@@ -42,15 +85,205 @@ namespace nzsl::Ast
 
 	inline bool TransformerExecutor::Transform(Module& module, TransformerContext& context, std::string* error) const
 	{
-		for (auto& passPtr : m_passes)
+		return ForEachPassGroup(&module, [&](const std::vector<PassInterface*>& passGroup)
+		{
+			if (passGroup.size() == 1)
+			{
+				PassInstrumentation::Scope instrumentationScope(m_instrumentation, passGroup.front()->GetName(), &context);
+				return passGroup.front()->Transform(module, context, error);
+			}
+
+			// Fused passes are measured as a whole, under their joined names
+			std::string groupName;
+			if (m_instrumentation.IsEnabled())
+			{
+				for (PassInterface* pass : passGroup)
+				{
+					if (!groupName.empty())
+						groupName += '+';
+
+					groupName += pass->GetName();
+				}
+			}
+
+			PassInstrumentation::Scope instrumentationScope(m_instrumentation, groupName, &context);
+
+			FusedTransformer fusedTransformer;
+			for (PassInterface* pass : passGroup)
+				fusedTransformer.AddTransformer(pass->GetTransformer(), pass->GetFusableNodes());
+
+			// Running a fused pass only sets it up (options and context), the module is traversed once by the fused transformer
+			for (PassInterface* pass : passGroup)
+			{
+				if (!pass->Transform(module, context, error))
+					return false;
+			}
+
+			return fusedTransformer.Transform(module, context, error);
+		});
+	}
+
+	template<typename F>
+	bool TransformerExecutor::ForEachPassGroup(Module* module, F&& callback) const
+	{
+		// Superset of the node types present in the module (and its imported modules), gathered when needed and kept up to date
+		// with the node types passes can introduce until a pass not declaring them runs, node traits are valid along with them
+		std::optional<NodeTypeFlags> nodeTypes;
+		NodeTraitFlags nodeTraits;
+		bool canGatherNodeTypes = true;
+
+		auto IsPassRequired = [&](const PassInterface& pass)
+		{
+			if (!module || !m_passSkipping)
+				return true;
+
+			std::optional<NodeTypeFlags> triggerNodes = pass.GetTriggerNodes();
+			if (!triggerNodes)
+				return true;
+
+			if (!nodeTypes)
+			{
+				// Node types can only be gathered from the module before a pass group runs
+				if (!canGatherNodeTypes)
+					return true;
+
+				nodeTypes = GetNodeTypes(*module, &nodeTraits);
+			}
+
+			if (!(*triggerNodes & *nodeTypes))
+				return false;
+
+			if (std::optional<NodeTraitFlags> triggerTraits = pass.GetTriggerTraits())
+				return static_cast<bool>(*triggerTraits & nodeTraits);
+
+			return true;
+		};
+
+		auto UpdateNodeTypes = [&](const PassInterface& pass)
 		{
-			if (!passPtr->Transform(module, context, error))
+			if (!nodeTypes)
+				return;
+
+			if (std::optional<NodeTypeFlags> producedNodes = pass.GetProducedNodes())
+			{
+				*nodeTypes |= *producedNodes;
+				nodeTraits |= pass.GetProducedTraits();
+			}
+			else
+				nodeTypes.reset();
+		};
+
+		std::vector<PassInterface*> passGroup;
+
+		std::size_t passIndex = 0;
+		while (passIndex < m_passes.size())
+		{
+			PassInterface& pass = *m_passes[passIndex++];
+
+			canGatherNodeTypes = true;
+			if (!IsPassRequired(pass))
+				continue;
+
+			passGroup.clear();
+			passGroup.push_back(&pass);
+
+			// Following fusable passes run in the same traversal, as long as they don't transform the same node types
+			canGatherNodeTypes = false;
+			UpdateNodeTypes(pass);
+
+			if (m_passFusion && pass.IsFusable())
+			{
+				NodeTypeFlags groupNodes = pass.GetFusableNodes();
+				for (; passIndex < m_passes.size(); ++passIndex)
+				{
+					PassInterface& nextPass = *m_passes[passIndex];
+					if (!nextPass.IsFusable() || (groupNodes & nextPass.GetFusableNodes()))
+						break;
+
+					if (!IsPassRequired(nextPass))
+						continue;
+
+					passGroup.push_back(&nextPass);
+					groupNodes |= nextPass.GetFusableNodes();
+					UpdateNodeTypes(nextPass);
+				}
+			}
+
+			if (!callback(passGroup))
 				return false;
 		}
 
 		return true;
 	}
 
+	template<typename T>
+	Transformer& TransformerExecutor::Pass<T>::GetTransformer()
+	{
+		return transformer;
+	}
+
+	template<typename T>
+	NodeTypeFlags TransformerExecutor::Pass<T>::GetFusableNodes() const
+	{
+		if constexpr (IsFusableTransformer<T>::value)
+			return T::FusableNodes;
+		else
+			return {};
+	}
+
+	template<typename T>
+	std::string_view TransformerExecutor::Pass<T>::GetName() const
+	{
+		if constexpr (HasPassName<T>::value)
+			return T::PassName;
+		else
+			return "<unnamed>";
+	}
+
+	template<typename T>
+	std::optional<NodeTypeFlags> TransformerExecutor::Pass<T>::GetProducedNodes() const
+	{
+		if constexpr (HasProducedNodes<T>::value)
+			return T::ProducedNodes;
+		else
+			return std::nullopt;
+	}
+
+	template<typename T>
+	NodeTraitFlags TransformerExecutor::Pass<T>::GetProducedTraits() const
+	{
+		if constexpr (HasProducedTraits<T>::value)
+			return T::ProducedTraits;
+		else
+			return {};
+	}
+
+	template<typename T>
+	std::optional<NodeTypeFlags> TransformerExecutor::Pass<T>::GetTriggerNodes() const
+	{
+		if constexpr (HasTriggerNodes<T>::value)
+			return T::TriggerNodes;
+		else if constexpr (IsFusableTransformer<T>::value)
+			return T::FusableNodes; //< fusable transformers only act on the nodes they transform
+		else
+			return std::nullopt;
+	}
+
+	template<typename T>
+	std::optional<NodeTraitFlags> TransformerExecutor::Pass<T>::GetTriggerTraits() const
+	{
+		if constexpr (HasTriggerTraits<T>::value)
+			return T::TriggerTraits;
+		else
+			return std::nullopt;
+	}
+
+	template<typename T>
+	bool TransformerExecutor::Pass<T>::IsFusable() const
+	{
+		return IsFusableTransformer<T>::value;
+	}
+
 	template<typename T>
 	bool TransformerExecutor::Pass<T>::Transform(Module& module, TransformerContext& context, std::string* error)
 	{
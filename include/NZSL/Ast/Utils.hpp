@@ -14,6 +14,8 @@
 
 namespace nzsl::Ast
 {
+	class Module;
+
 	NZSL_API std::optional<ExpressionType> ComputeExpressionType(const IntrinsicExpression& intrinsicExpr, const Stringifier& typeStringifier);
 	NZSL_API std::optional<ExpressionType> ComputeExpressionType(const SwizzleExpression& swizzleExpr, const Stringifier& typeStringifier);
 	NZSL_API std::optional<ExpressionType> ComputeExpressionType(const UnaryExpression& unaryExpr, const Stringifier& typeStringifier);
@@ -37,6 +39,7 @@ namespace nzsl::Ast
 
 	NZSL_API ExpressionCategory GetExpressionCategory(Expression& expression);
 	inline std::optional<PrimitiveType> GetInnerPrimitiveType(const ExpressionType& expressionType);
+	NZSL_API NodeTypeFlags GetNodeTypes(Module& module, NodeTraitFlags* nodeTraits = nullptr);
 
 	NZSL_API Expression& MandatoryExpr(const ExpressionPtr& node, const SourceLocation& sourceLocation);
 	NZSL_API Statement& MandatoryStatement(const StatementPtr& node, const SourceLocation& sourceLocation);
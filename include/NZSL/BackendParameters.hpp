@@ -11,18 +11,28 @@
 #include <NZSL/Config.hpp>
 #include <NZSL/Enums.hpp>
 #include <NZSL/Ast/ConstantValue.hpp>
+#include <NZSL/Ast/PassInstrumentation.hpp>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace nzsl
 {
 	class ModuleResolver;
 
+	namespace Ast
+	{
+		class ResolvedModuleCache;
+	}
+
 	enum class BackendPass
 	{
 		Optimize,
+		OptimizeSpirv, //< SPIR-V: runs SpirvOptimizer on the generated module (dead code, redundant loads, duplicate constants and id compaction)
+		PromoteVariables, //< SPIR-V: keeps scalar and vector local variables as SSA values instead of Function storage variables
 		RemoveDeadCode,
 		Resolve,
+		SpecializationConstants, //< SPIR-V: scalar options without a value in optionValues become specialization constants (SpecId is the option hash), options also used at compile time (const if, const_select, array sizes, const) are replaced by their default value
 		TargetRequired,
 		Validate,
 
@@ -33,13 +43,24 @@ namespace nzsl
 
 	using BackendPasses = Nz::Flags<BackendPass>;
 
+	using OptionValues = std::unordered_map<std::uint32_t, Ast::ConstantValue>;
+
 	struct BackendParameters
 	{
 		std::shared_ptr<ModuleResolver> shaderModuleResolver;
-		std::unordered_map<std::uint32_t, Ast::ConstantValue> optionValues;
+		std::shared_ptr<Ast::ResolvedModuleCache> resolvedModuleCache;
+		OptionValues optionValues;
+		Ast::PassInstrumentation passInstrumentation; //< reports statistics about every pass run by the backend (including dead code removal and code generation)
 		BackendPasses backendPasses = BackendPass::Resolve | BackendPass::TargetRequired | BackendPass::Validate;
 		DebugLevel debugLevel = DebugLevel::Minimal;
 	};
+
+	template<typename T>
+	struct PermutationOutputs
+	{
+		std::vector<T> outputs; //< one output per distinct permutation
+		std::vector<std::size_t> outputIndices; //< index of the output shared by each option permutation
+	};
 }
 
 #endif // NZSL_BACKENDPARAMETERS_HPP
@@ -0,0 +1,80 @@
+// Copyright (C) 2026 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NZSL_COMPILATIONSESSION_HPP
+#define NZSL_COMPILATIONSESSION_HPP
+
+#include <NZSL/BackendParameters.hpp>
+#include <NZSL/Config.hpp>
+#include <NZSL/GlslWriter.hpp>
+#include <NZSL/SpirvWriter.hpp>
+#include <NZSL/Ast/Module.hpp>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace nzsl
+{
+	// Compiles a (resolved) module for multiple stages, option sets and backends, running jobs in parallel on a work-stealing thread pool
+	// Each job works on its own copy of the module (allocated from its own node arena), the module itself is never modified
+	// Results are returned in the order jobs were added, whatever the thread count and the order in which jobs ran
+	class NZSL_API CompilationSession
+	{
+		public:
+			enum class Backend;
+			struct Job;
+			struct Result;
+
+			inline CompilationSession(std::shared_ptr<const Ast::Module> module);
+			CompilationSession(const CompilationSession&) = delete;
+			CompilationSession(CompilationSession&&) noexcept = default;
+			~CompilationSession() = default;
+
+			inline std::size_t AddJob(Job job);
+
+			inline std::size_t GetJobCount() const;
+
+			std::vector<Result> Run(unsigned int threadCount = 0) const;
+
+			CompilationSession& operator=(const CompilationSession&) = delete;
+			CompilationSession& operator=(CompilationSession&&) noexcept = default;
+
+			enum class Backend
+			{
+				Glsl,
+				Spirv
+			};
+
+			// Jobs may run concurrently: module resolvers and pass instrumentation callbacks they use must be thread-safe
+			struct Job
+			{
+				Backend backend;
+				BackendParameters parameters;
+				std::optional<ShaderStageType> shaderStage; //< GLSL only, SPIR-V modules include every entry point
+				GlslWriter::Environment glslEnvironment;
+				GlslWriter::Parameters glslParameters;
+				SpirvWriter::Environment spirvEnvironment;
+			};
+
+			struct Result
+			{
+				std::exception_ptr error; //< set if the job failed (output is then empty)
+				GlslWriter::Output glslOutput;
+				std::vector<std::uint32_t> spirv;
+			};
+
+		private:
+			Result RunJob(const Job& job) const;
+
+			std::shared_ptr<const Ast::Module> m_module;
+			std::vector<Job> m_jobs;
+	};
+}
+
+#include <NZSL/CompilationSession.inl>
+
+#endif // NZSL_COMPILATIONSESSION_HPP
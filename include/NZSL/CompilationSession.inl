@@ -0,0 +1,24 @@
+// Copyright (C) 2026 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+namespace nzsl
+{
+	inline CompilationSession::CompilationSession(std::shared_ptr<const Ast::Module> module) :
+	m_module(std::move(module))
+	{
+	}
+
+	inline std::size_t CompilationSession::AddJob(Job job)
+	{
+		std::size_t jobIndex = m_jobs.size();
+		m_jobs.push_back(std::move(job));
+
+		return jobIndex;
+	}
+
+	inline std::size_t CompilationSession::GetJobCount() const
+	{
+		return m_jobs.size();
+	}
+}
@@ -45,6 +45,14 @@
 	#define NZSL_API
 #endif
 
+#if defined(NAZARA_COMPILER_MSVC)
+	#define NZSL_NOINLINE __declspec(noinline)
+#elif defined(__GNUC__) || defined(__clang__)
+	#define NZSL_NOINLINE __attribute__((noinline))
+#else
+	#define NZSL_NOINLINE
+#endif
+
 #include <cstdint>
 
 #endif // NZSL_CONFIG_HPP
@@ -10,6 +10,7 @@
 #include <NazaraUtils/MovablePtr.hpp>
 #include <NZSL/Config.hpp>
 #include <NZSL/ModuleResolver.hpp>
+#include <NZSL/Parser.hpp>
 #include <filesystem>
 #include <mutex>
 #include <string>
@@ -33,8 +34,12 @@ namespace nzsl
 			void RegisterModule(std::string_view moduleSource);
 			void RegisterModule(Ast::ModulePtr module);
 
+			std::optional<std::uint64_t> GetModuleVersion(const std::string& moduleName) override;
+
 			Ast::ModulePtr Resolve(const std::string& moduleName) override;
 
+			inline void SetParserOptions(const Parser::Options& options);
+
 			FilesystemModuleResolver& operator=(const FilesystemModuleResolver&) = delete;
 			FilesystemModuleResolver& operator=(FilesystemModuleResolver&&) noexcept = delete;
 
@@ -50,10 +55,18 @@ namespace nzsl
 
 			static bool CheckExtension(std::string_view filename);
 
+			struct ModuleEntry
+			{
+				Ast::ModulePtr module;
+				std::uint64_t version;
+			};
+
 			std::recursive_mutex m_moduleLock;
 			std::unordered_map<std::string, std::string> m_moduleByFilepath;
-			std::unordered_map<std::string, Ast::ModulePtr> m_modules;
+			std::unordered_map<std::string, ModuleEntry> m_modules;
+			std::uint64_t m_nextModuleVersion = 0;
 			Nz::MovablePtr<void> m_fileWatcher;
+			Parser::Options m_parserOptions;
 	};
 }
 
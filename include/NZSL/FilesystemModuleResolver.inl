@@ -5,4 +5,8 @@
 
 namespace nzsl
 {
+	inline void FilesystemModuleResolver::SetParserOptions(const Parser::Options& options)
+	{
+		m_parserOptions = options;
+	}
 }
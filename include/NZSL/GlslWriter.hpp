@@ -34,7 +34,10 @@ namespace nzsl
 			~GlslWriter() = default;
 
 			inline Output Generate(Ast::Module& module, const BackendParameters& parameters = {}, const Parameters& glslParameters = {});
+			inline Output Generate(const Ast::Module& module, const BackendParameters& parameters = {}, const Parameters& glslParameters = {}); //< performs a full clone of the module, see below
 			Output Generate(std::optional<ShaderStageType> shaderStage, Ast::Module& module, const BackendParameters& parameters = {}, const Parameters& glslParameters = {});
+			Output Generate(std::optional<ShaderStageType> shaderStage, const Ast::Module& module, const BackendParameters& parameters = {}, const Parameters& glslParameters = {}); //< performs a full clone of the module and transforms it, prefer the non-const overload when the module may be modified
+			PermutationOutputs<Output> GeneratePermutations(std::optional<ShaderStageType> shaderStage, const Ast::Module& module, const std::vector<OptionValues>& optionPermutations, const BackendParameters& parameters = {}, const Parameters& glslParameters = {});
 
 			void SetEnv(Environment environment);
 
@@ -69,7 +72,7 @@ namespace nzsl
 			static std::string_view GetDrawParameterBaseVertexUniformName();
 			static std::string_view GetDrawParameterDrawIndexUniformName();
 			static std::string_view GetFlipYUniformName();
-			static void RegisterPasses(Ast::TransformerExecutor& executor);
+			static void RegisterPasses(Ast::TransformerExecutor& executor, bool keepUnsetScalarOptions = false);
 
 		private:
 			void Append(const Ast::AliasType& aliasType);
@@ -125,6 +128,8 @@ namespace nzsl
 			void RegisterStruct(std::size_t structIndex, Ast::StructDescription* desc, std::string structName);
 			void RegisterVariable(std::size_t varIndex, std::string varName);
 
+			void RunPasses(std::optional<ShaderStageType> shaderStage, Ast::Module& module, const BackendParameters& parameters, bool keepUnsetScalarOptions = false);
+
 			void ScopeVisit(Ast::Statement& node);
 
 			void Visit(Ast::ExpressionPtr& expr, bool encloseIfRequired = false);
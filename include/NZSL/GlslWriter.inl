@@ -13,4 +13,9 @@ namespace nzsl
 	{
 		return Generate(std::nullopt, shader, parameters, glslParameters);
 	}
+
+	inline auto GlslWriter::Generate(const Ast::Module& shader, const BackendParameters& parameters, const Parameters& glslParameters) -> Output
+	{
+		return Generate(std::nullopt, shader, parameters, glslParameters);
+	}
 }
@@ -8,21 +8,25 @@
 #define NZSL_LANG_SOURCELOCATION_HPP
 
 #include <NZSL/Config.hpp>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <string_view>
 
 namespace nzsl
 {
 	struct SourceLocation
 	{
 		inline SourceLocation();
-		inline SourceLocation(unsigned int line, unsigned int column, std::shared_ptr<const std::string> file);
-		inline SourceLocation(unsigned int line, unsigned int startColumn, unsigned int endColumn, std::shared_ptr<const std::string> file);
-		inline SourceLocation(unsigned int startLine, unsigned int endLine, unsigned int startColumn, unsigned int endColumn, std::shared_ptr<const std::string> file);
+		inline SourceLocation(unsigned int line, unsigned int column, std::uint32_t fileIndex);
+		inline SourceLocation(unsigned int line, unsigned int startColumn, unsigned int endColumn, std::uint32_t fileIndex);
+		inline SourceLocation(unsigned int startLine, unsigned int endLine, unsigned int startColumn, unsigned int endColumn, std::uint32_t fileIndex);
 
 		inline void ExtendToLeft(const SourceLocation& leftLocation);
 		inline void ExtendToRight(const SourceLocation& rightLocation);
 
+		inline const std::shared_ptr<const std::string>& GetFile() const;
+
 		inline bool IsValid() const;
 
 		bool operator==(const SourceLocation& other) const;
@@ -30,9 +34,16 @@ namespace nzsl
 
 		static inline SourceLocation BuildFromTo(const SourceLocation& leftSource, const SourceLocation& rightSource);
 
-		std::shared_ptr<const std::string> file; //< Since the same file will be used for every node, prevent storing X time the same path
+		// Source file paths are stored once in a global file table, locations only reference them by index (0 meaning no file)
+		// ClearFileTable releases every registered path, locations (and modules holding them) created before must not be used afterwards
+		// it must not be called while another thread is registering or resolving files
+		static NZSL_API void ClearFileTable();
+		static NZSL_API std::uint32_t RegisterFile(std::string_view filePath);
+		static NZSL_API const std::shared_ptr<const std::string>& ResolveFile(std::uint32_t fileIndex);
+
 		std::uint32_t endColumn;
 		std::uint32_t endLine;
+		std::uint32_t fileIndex; //< Since the same file will be used for every node, only store its index in the file table (see RegisterFile)
 		std::uint32_t startColumn;
 		std::uint32_t startLine;
 	};
@@ -9,33 +9,34 @@ namespace nzsl
 	inline SourceLocation::SourceLocation() :
 	endColumn(0),
 	endLine(0),
+	fileIndex(0),
 	startColumn(0),
 	startLine(0)
 	{
 	}
 
-	inline SourceLocation::SourceLocation(unsigned int Line, unsigned int Column, std::shared_ptr<const std::string> File) :
-	file(std::move(File)),
+	inline SourceLocation::SourceLocation(unsigned int Line, unsigned int Column, std::uint32_t FileIndex) :
 	endColumn(Column),
 	endLine(Line),
+	fileIndex(FileIndex),
 	startColumn(Column),
 	startLine(Line)
 	{
 	}
 
-	inline SourceLocation::SourceLocation(unsigned int Line, unsigned int StartColumn, unsigned int EndColumn, std::shared_ptr<const std::string> File) :
-	file(std::move(File)),
+	inline SourceLocation::SourceLocation(unsigned int Line, unsigned int StartColumn, unsigned int EndColumn, std::uint32_t FileIndex) :
 	endColumn(EndColumn),
 	endLine(Line),
+	fileIndex(FileIndex),
 	startColumn(StartColumn),
 	startLine(Line)
 	{
 	}
 
-	inline SourceLocation::SourceLocation(unsigned int StartLine, unsigned int EndLine, unsigned int StartColumn, unsigned int EndColumn, std::shared_ptr<const std::string> File) :
-	file(std::move(File)),
+	inline SourceLocation::SourceLocation(unsigned int StartLine, unsigned int EndLine, unsigned int StartColumn, unsigned int EndColumn, std::uint32_t FileIndex) :
 	endColumn(EndColumn),
 	endLine(EndLine),
+	fileIndex(FileIndex),
 	startColumn(StartColumn),
 	startLine(StartLine)
 	{
@@ -43,7 +44,7 @@ namespace nzsl
 
 	inline void SourceLocation::ExtendToLeft(const SourceLocation& leftLocation)
 	{
-		assert(file == leftLocation.file);
+		assert(fileIndex == leftLocation.fileIndex);
 		assert(leftLocation.startLine <= endLine);
 		startLine = leftLocation.startLine;
 		assert(leftLocation.startLine < endLine || leftLocation.startColumn <= endColumn);
@@ -52,7 +53,7 @@ namespace nzsl
 
 	inline void SourceLocation::ExtendToRight(const SourceLocation& rightLocation)
 	{
-		assert(file == rightLocation.file);
+		assert(fileIndex == rightLocation.fileIndex);
 		assert(rightLocation.endLine >= startLine);
 		endLine = rightLocation.endLine;
 		assert(rightLocation.endLine > startLine || rightLocation.endColumn >= startColumn);
@@ -61,12 +62,12 @@ namespace nzsl
 
 	inline SourceLocation SourceLocation::BuildFromTo(const SourceLocation& leftSource, const SourceLocation& rightSource)
 	{
-		assert(leftSource.file == rightSource.file);
+		assert(leftSource.fileIndex == rightSource.fileIndex);
 		assert(leftSource.startLine <= rightSource.endLine);
 		assert(leftSource.startLine < rightSource.endLine || leftSource.startColumn <= rightSource.endColumn);
 
 		SourceLocation sourceLoc;
-		sourceLoc.file = leftSource.file;
+		sourceLoc.fileIndex = leftSource.fileIndex;
 		sourceLoc.startLine = leftSource.startLine;
 		sourceLoc.startColumn = leftSource.startColumn;
 		sourceLoc.endLine = rightSource.endLine;
@@ -75,6 +76,11 @@ namespace nzsl
 		return sourceLoc;
 	}
 
+	inline const std::shared_ptr<const std::string>& SourceLocation::GetFile() const
+	{
+		return ResolveFile(fileIndex);
+	}
+
 	inline bool SourceLocation::IsValid() const
 	{
 		return startLine != 0 || endLine != 0 || endColumn != 0 || startColumn != 0;
@@ -82,7 +88,7 @@ namespace nzsl
 
 	inline bool SourceLocation::operator==(const SourceLocation& other) const
 	{
-		return file == other.file && endColumn == other.endColumn && endLine == other.endLine && startColumn == other.startColumn && startLine == other.startLine;
+		return fileIndex == other.fileIndex && endColumn == other.endColumn && endLine == other.endLine && startColumn == other.startColumn && startLine == other.startLine;
 	}
 
 	inline bool SourceLocation::operator!=(const SourceLocation& other) const
@@ -9,9 +9,11 @@
 
 #include <NZSL/Config.hpp>
 #include <NZSL/Lang/SourceLocation.hpp>
+#include <array>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <variant>
 #include <vector>
 
@@ -31,11 +33,65 @@ namespace nzsl
 		std::variant<double, std::int64_t, std::string> data;
 	};
 
+	// Token produced by TokenStream, identifiers and string literals are views into the tokenized source which has to outlive them
+	// String literals are stored as they appear in the source (without quotes), use UnescapeString to retrieve their value
+	struct TokenView
+	{
+		SourceLocation location;
+		TokenType type;
+		std::variant<double, std::int64_t, std::string_view> data;
+	};
+
+	// Tokenizes the source on demand (tokens are only lexed when peeked), or reads from already tokenized input (which has to outlive the stream)
+	// Tokens returned by Advance/Peek live in a small ring buffer and stay valid until two more tokens have been consumed
+	class NZSL_API TokenStream
+	{
+		public:
+			explicit TokenStream(std::string_view source, const std::string& filePath = std::string{});
+			explicit TokenStream(const std::vector<Token>& tokens);
+			explicit TokenStream(const std::vector<TokenView>& tokens);
+			TokenStream(const TokenStream&) = delete;
+			TokenStream(TokenStream&&) noexcept = default;
+			~TokenStream() = default;
+
+			inline const TokenView& Advance();
+			inline void Consume(std::size_t count = 1);
+
+			inline const TokenView& Peek(std::size_t advance = 0);
+
+			TokenStream& operator=(const TokenStream&) = delete;
+			TokenStream& operator=(TokenStream&&) noexcept = default;
+
+			static constexpr std::size_t MaxLookahead = 1;
+
+		private:
+			void LexToken(TokenView& token);
+
+			static constexpr std::size_t LookaheadBufferSize = MaxLookahead + 3; //< current token + lookahead + two last consumed tokens
+
+			std::array<TokenView, LookaheadBufferSize> m_lookaheadBuffer;
+			std::size_t m_bufferedTokenCount;
+			std::size_t m_currentPos;
+			std::size_t m_lineStartPos;
+			std::size_t m_lookaheadIndex;
+			std::size_t m_tokenCount;
+			std::size_t m_tokenIndex;
+			std::string m_literalTemp;
+			std::string_view m_source;
+			std::vector<std::string> m_escapedStrings; //< string literals of owning tokens, escaped back as the parser expects them
+			std::vector<TokenView> m_tokenViews; //< views over owning tokens
+			std::uint32_t m_currentFileIndex;
+			std::uint32_t m_currentLine;
+			const TokenView* m_tokens;
+	};
+
 	NZSL_API std::string EscapeString(std::string_view str, bool quote = true);
+	NZSL_API std::string UnescapeString(std::string_view str);
 
-	NZSL_API std::vector<Token> Tokenize(std::string_view str, const std::string& filePath = std::string{});
+	NZSL_API std::vector<Token> Tokenize(std::string_view str, const std::string& filePath = std::string{}); //< string literals are unescaped
 	NZSL_API const char* ToString(TokenType tokenType);
 	NZSL_API std::string ToString(const std::vector<Token>& tokens, bool pretty = true);
+	NZSL_API std::string ToString(TokenStream& tokenStream, bool pretty = true);
 }
 
 #include <NZSL/Lexer.inl>
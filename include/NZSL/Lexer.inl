@@ -2,7 +2,53 @@
 // This file is part of the "Nazara Shading Language" project
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
+#include <cassert>
 
 namespace nzsl
 {
+	inline const TokenView& TokenStream::Advance()
+	{
+		const TokenView& token = Peek();
+		if (m_tokens)
+			m_tokenIndex++;
+		else
+		{
+			m_lookaheadIndex = (m_lookaheadIndex + 1) % LookaheadBufferSize;
+			m_bufferedTokenCount--;
+		}
+
+		return token;
+	}
+
+	inline void TokenStream::Consume(std::size_t count)
+	{
+		if (m_tokens)
+		{
+			assert(m_tokenIndex + count < m_tokenCount);
+			m_tokenIndex += count;
+		}
+		else
+		{
+			for (std::size_t i = 0; i < count; ++i)
+				Advance();
+		}
+	}
+
+	inline const TokenView& TokenStream::Peek(std::size_t advance)
+	{
+		if (m_tokens)
+		{
+			assert(m_tokenIndex + advance < m_tokenCount);
+			return m_tokens[m_tokenIndex + advance];
+		}
+
+		assert(advance <= MaxLookahead);
+		while (m_bufferedTokenCount <= advance)
+		{
+			LexToken(m_lookaheadBuffer[(m_lookaheadIndex + m_bufferedTokenCount) % LookaheadBufferSize]);
+			m_bufferedTokenCount++;
+		}
+
+		return m_lookaheadBuffer[(m_lookaheadIndex + advance) % LookaheadBufferSize];
+	}
 }
@@ -9,7 +9,9 @@
 
 #include <NazaraUtils/Signal.hpp>
 #include <NZSL/Config.hpp>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 
 namespace nzsl
@@ -27,6 +29,10 @@ namespace nzsl
 			ModuleResolver(ModuleResolver&&) = default;
 			virtual ~ModuleResolver();
 
+			// Version of the module currently resolved by this name, changing every time the module is updated, which lets caches recognize it without comparing its content
+			// A module must not be modified once returned with a version, resolvers which can't guarantee it (or don't track modules) return nothing
+			virtual std::optional<std::uint64_t> GetModuleVersion(const std::string& moduleName);
+
 			virtual Ast::ModulePtr Resolve(const std::string& /*moduleName*/) = 0;
 
 			ModuleResolver& operator=(const ModuleResolver&) = default;
@@ -14,15 +14,31 @@
 #include <filesystem>
 #include <optional>
 
+namespace nzsl::Ast
+{
+	// Tokens of a function body whose parsing was deferred, identifiers and strings are views into stringStorage
+	struct DeferredFunctionBody
+	{
+		std::string stringStorage;
+		std::uint32_t langVersion;
+		std::vector<TokenView> tokens; //< from the opening to the closing curly bracket, followed by an end of stream token
+	};
+}
+
 namespace nzsl
 {
 	class NZSL_API Parser
 	{
 		public:
+			struct Options;
+
 			inline Parser();
+			inline explicit Parser(const Options& options);
 			~Parser() = default;
 
 			Ast::ModulePtr Parse(const std::vector<Token>& tokens);
+			Ast::ModulePtr Parse(TokenStream& tokenStream);
+			void ParseDeferredFunctionBody(Ast::DeclareFunctionStatement& function);
 
 			static std::string_view ToString(Ast::AttributeType attributeType);
 			static std::string_view ToString(Ast::BuiltinEntry builtinEntry);
@@ -34,6 +50,11 @@ namespace nzsl
 			static std::string_view ToString(Ast::TypeConstant typeConstant);
 			static std::string_view ToString(ShaderStageType shaderStage);
 
+			struct Options
+			{
+				bool deferFunctionBodies = false; //< only store function body tokens, parsing them when the function is resolved (syntax errors in unused functions are no longer reported)
+			};
+
 		private:
 			struct Attribute
 			{
@@ -43,12 +64,12 @@ namespace nzsl
 			};
 
 			// Flow control
-			const Token& Advance();
+			const TokenView& Advance();
 			void Consume(std::size_t count = 1);
-			const Token& Expect(const Token& token, TokenType type);
-			const Token& ExpectNot(const Token& token, TokenType type);
-			const Token& Expect(TokenType type);
-			const Token& Peek(std::size_t advance = 0);
+			const TokenView& Expect(const TokenView& token, TokenType type);
+			const TokenView& ExpectNot(const TokenView& token, TokenType type);
+			const TokenView& Expect(TokenType type);
+			const TokenView& Peek(std::size_t advance = 0);
 
 			std::vector<Attribute> ParseAttributes();
 			void ParseModuleStatement(std::vector<Attribute> attributes);
@@ -77,6 +98,7 @@ namespace nzsl
 			Ast::StatementPtr ParseSingleStatement();
 			Ast::StatementPtr ParseStatement();
 			std::vector<Ast::StatementPtr> ParseStatementList(SourceLocation* sourceLocation);
+			std::shared_ptr<const Ast::DeferredFunctionBody> SkipStatementList(SourceLocation* sourceLocation);
 			Ast::StatementPtr ParseStructDeclaration(std::vector<Attribute> attributes = {});
 			Ast::StatementPtr ParseVariableDeclaration();
 			Ast::StatementPtr ParseWhileStatement(std::vector<Attribute> attributes);
@@ -95,7 +117,7 @@ namespace nzsl
 			Ast::ExpressionPtr ParsePrimaryExpression();
 			Ast::ExpressionPtr ParseStringExpression();
 
-			const std::string& ParseIdentifierAsName(SourceLocation* sourceLocation);
+			std::string_view ParseIdentifierAsName(SourceLocation* sourceLocation);
 			std::string ParseModuleName(SourceLocation* sourceLocation);
 			Ast::ExpressionPtr ParseType();
 
@@ -109,18 +131,19 @@ namespace nzsl
 
 			struct Context
 			{
-				std::size_t tokenCount;
-				std::size_t tokenIndex = 0;
 				Ast::ModulePtr module;
-				const Token* tokens;
+				TokenStream* tokenStream;
 				bool parsingImportedModule = false;
 			};
 
 			Context* m_context;
+			Options m_options;
 	};
 
 	inline Ast::ModulePtr Parse(std::string_view source, const std::string& filePath = std::string{});
 	inline Ast::ModulePtr Parse(const std::vector<Token>& tokens);
+	inline Ast::ModulePtr Parse(TokenStream& tokenStream);
+	inline void ParseDeferredFunctionBody(Ast::DeclareFunctionStatement& function);
 	NZSL_API Ast::ModulePtr ParseFromFile(const std::filesystem::path& sourcePath);
 }
 
@@ -10,9 +10,16 @@ namespace nzsl
 	{
 	}
 
+	inline Parser::Parser(const Options& options) :
+	m_context(nullptr),
+	m_options(options)
+	{
+	}
+
 	inline Ast::ModulePtr Parse(std::string_view source, const std::string& filePath)
 	{
-		return Parse(Tokenize(source, filePath));
+		TokenStream tokenStream(source, filePath);
+		return Parse(tokenStream);
 	}
 
 	inline Ast::ModulePtr Parse(const std::vector<Token>& tokens)
@@ -20,4 +27,16 @@ namespace nzsl
 		Parser parser;
 		return parser.Parse(tokens);
 	}
+
+	inline Ast::ModulePtr Parse(TokenStream& tokenStream)
+	{
+		Parser parser;
+		return parser.Parse(tokenStream);
+	}
+
+	inline void ParseDeferredFunctionBody(Ast::DeclareFunctionStatement& function)
+	{
+		Parser parser;
+		parser.ParseDeferredFunctionBody(function);
+	}
 }
@@ -32,7 +32,8 @@ namespace nzsl::ShaderBuilder
 
 		struct AccessMember
 		{
-			inline Ast::AccessIdentifierExpressionPtr operator()(Ast::ExpressionPtr expr, std::string memberIdentifier, const SourceLocation& sourceLocation) const;
+			inline Ast::AccessIdentifierExpressionPtr operator()(Ast::ExpressionPtr expr, std::string_view memberIdentifier, const SourceLocation& sourceLocation) const;
+			inline Ast::AccessIdentifierExpressionPtr operator()(Ast::ExpressionPtr expr, Ast::InternedString memberIdentifier, const SourceLocation& sourceLocation) const;
 			inline Ast::AccessIdentifierExpressionPtr operator()(Ast::ExpressionPtr expr, std::vector<std::string> memberIdentifiers) const;
 		};
 
@@ -141,7 +142,8 @@ namespace nzsl::ShaderBuilder
 
 		struct Identifier
 		{
-			inline Ast::IdentifierExpressionPtr operator()(std::string name) const;
+			inline Ast::IdentifierExpressionPtr operator()(std::string_view name) const;
+			inline Ast::IdentifierExpressionPtr operator()(Ast::InternedString name) const;
 		};
 
 		struct IdentifierValue
@@ -157,8 +159,8 @@ namespace nzsl::ShaderBuilder
 		{
 			inline Ast::IdentifierValueExpressionPtr operator()(std::size_t id) const;
 			inline Ast::IdentifierValueExpressionPtr operator()(std::size_t id, const SourceLocation& sourceLocation) const;
-			inline Ast::IdentifierValueExpressionPtr operator()(std::size_t id, Ast::ExpressionType expressionType) const;
-			inline Ast::IdentifierValueExpressionPtr operator()(std::size_t id, Ast::ExpressionType expressionType, const SourceLocation& sourceLocation) const;
+			inline Ast::IdentifierValueExpressionPtr operator()(std::size_t id, Ast::InternedType expressionType) const;
+			inline Ast::IdentifierValueExpressionPtr operator()(std::size_t id, Ast::InternedType expressionType, const SourceLocation& sourceLocation) const;
 		};
 
 		struct Import
@@ -15,7 +15,12 @@ namespace nzsl::ShaderBuilder
 		return accessFieldNode;
 	}
 
-	inline Ast::AccessIdentifierExpressionPtr Impl::AccessMember::operator()(Ast::ExpressionPtr expr, std::string memberIdentifier, const SourceLocation& sourceLocation) const
+	inline Ast::AccessIdentifierExpressionPtr Impl::AccessMember::operator()(Ast::ExpressionPtr expr, std::string_view memberIdentifier, const SourceLocation& sourceLocation) const
+	{
+		return operator()(std::move(expr), Ast::InternedString(memberIdentifier), sourceLocation);
+	}
+
+	inline Ast::AccessIdentifierExpressionPtr Impl::AccessMember::operator()(Ast::ExpressionPtr expr, Ast::InternedString memberIdentifier, const SourceLocation& sourceLocation) const
 	{
 		auto accessMemberNode = std::make_unique<Ast::AccessIdentifierExpression>();
 		accessMemberNode->expr = std::move(expr);
@@ -34,7 +39,7 @@ namespace nzsl::ShaderBuilder
 		for (std::string& identifier : memberIdentifiers)
 		{
 			auto& identifierEntry = accessMemberNode->identifiers.emplace_back();
-			identifierEntry.identifier = std::move(identifier);
+			identifierEntry.identifier = Ast::InternedString(identifier);
 		}
 
 		return accessMemberNode;
@@ -402,7 +407,12 @@ namespace nzsl::ShaderBuilder
 		return forEachNode;
 	}
 
-	inline Ast::IdentifierExpressionPtr Impl::Identifier::operator()(std::string name) const
+	inline Ast::IdentifierExpressionPtr Impl::Identifier::operator()(std::string_view name) const
+	{
+		return operator()(Ast::InternedString(name));
+	}
+
+	inline Ast::IdentifierExpressionPtr Impl::Identifier::operator()(Ast::InternedString name) const
 	{
 		auto identifierNode = std::make_unique<Ast::IdentifierExpression>();
 		identifierNode->identifier = std::move(name);
@@ -512,7 +522,7 @@ namespace nzsl::ShaderBuilder
 	}
 
 	template<Ast::IdentifierType Type>
-	Ast::IdentifierValueExpressionPtr Impl::IdentifierValueWithType<Type>::operator()(std::size_t id, Ast::ExpressionType expressionType) const
+	Ast::IdentifierValueExpressionPtr Impl::IdentifierValueWithType<Type>::operator()(std::size_t id, Ast::InternedType expressionType) const
 	{
 		auto identifierValue = std::make_unique<Ast::IdentifierValueExpression>();
 		identifierValue->identifierType = Type;
@@ -523,7 +533,7 @@ namespace nzsl::ShaderBuilder
 	}
 
 	template<Ast::IdentifierType Type>
-	Ast::IdentifierValueExpressionPtr Impl::IdentifierValueWithType<Type>::operator()(std::size_t id, Ast::ExpressionType expressionType, const SourceLocation& sourceLocation) const
+	Ast::IdentifierValueExpressionPtr Impl::IdentifierValueWithType<Type>::operator()(std::size_t id, Ast::InternedType expressionType, const SourceLocation& sourceLocation) const
 	{
 		auto identifierValue = std::make_unique<Ast::IdentifierValueExpression>();
 		identifierValue->identifierType = Type;
@@ -16,6 +16,7 @@
 #include <functional>
 #include <optional>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace nzsl
@@ -140,6 +141,7 @@ namespace nzsl
 					std::uint32_t varId;
 					SpirvConstantCache::TypePtr typePtr;
 					SourceLocation sourceLocation;
+					bool isPromoted = false; //< kept as a SSA value, no OpVariable is emitted
 				};
 
 				std::optional<EntryPoint> entryPointData;
@@ -157,9 +159,25 @@ namespace nzsl
 			};
 
 		private:
+			struct PromotedValue
+			{
+				std::uint32_t typeId;
+				std::uint32_t valueId;
+			};
+
+			using PromotedValues = std::unordered_map<std::size_t /*varIndex*/, PromotedValue>;
+
+			struct PromotedValuesEdge
+			{
+				std::uint32_t predecessorLabelId;
+				PromotedValues values;
+			};
+
 			void HandleSourceLocation(const SourceLocation& sourceLocation);
 			void HandleStatementList(const std::vector<Ast::StatementPtr>& statements);
 
+			void MergePromotedValues(const std::vector<PromotedValuesEdge>& edges);
+
 			void PushResultId(std::uint32_t value);
 			std::uint32_t PopResultId();
 
@@ -167,15 +185,22 @@ namespace nzsl
 
 			void ResetSourceLocation();
 
+			void StoreExpression(Ast::ExpressionPtr& target, std::uint32_t valueId);
+
 			std::function<FuncData& (std::size_t)> m_functionRetriever;
 			std::optional<std::uint32_t> m_breakTarget;
 			std::optional<std::uint32_t> m_continueTarget;
 			std::size_t m_funcCallIndex;
+			std::unordered_map<const Ast::WhileStatement*, std::vector<std::size_t>> m_loopStoredVariables;
 			std::unordered_map<std::size_t, SpirvVariable> m_variables;
+			std::unordered_set<std::size_t> m_promotedVariables;
+			std::vector<PromotedValuesEdge>* m_breakEdges;
+			std::vector<PromotedValuesEdge>* m_continueEdges;
 			std::vector<std::size_t> m_scopeSizes;
 			std::vector<std::unique_ptr<SpirvBlock>> m_functionBlocks;
 			std::vector<std::uint32_t> m_resultIds;
 			FuncData* m_currentFunc;
+			PromotedValues m_promotedValues;
 			SpirvBlock* m_currentBlock;
 			SpirvSection& m_instructions;
 			SpirvWriter& m_writer;
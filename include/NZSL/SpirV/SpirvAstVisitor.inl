@@ -8,6 +8,8 @@ namespace nzsl
 {
 	inline SpirvAstVisitor::SpirvAstVisitor(SpirvWriter& writer, SpirvSection& instructions, std::function<FuncData& (std::size_t)> functionRetriever) :
 	m_functionRetriever(std::move(functionRetriever)),
+	m_breakEdges(nullptr),
+	m_continueEdges(nullptr),
 	m_currentBlock(nullptr),
 	m_instructions(instructions),
 	m_writer(writer),
@@ -139,7 +139,14 @@ namespace nzsl
 				std::variant<float, double, std::int32_t, std::int64_t, std::uint32_t, std::uint64_t> value;
 			};
 
-			using AnyConstant = std::variant<ConstantBool, ConstantComposite, ConstantScalar>;
+			// Value can be overridden at pipeline creation through its SpecId decoration
+			struct ConstantSpec
+			{
+				ConstantPtr defaultValue; //< ConstantBool or ConstantScalar
+				std::uint32_t specId;
+			};
+
+			using AnyConstant = std::variant<ConstantBool, ConstantComposite, ConstantScalar, ConstantSpec>;
 
 			struct Variable
 			{
@@ -156,28 +163,39 @@ namespace nzsl
 			using PrimitiveType = std::variant<Bool, Float, Integer>;
 			using ScalarType = std::variant<Float, Integer>;
 
+			// Constants and types built by the cache are interned (equal nodes share the same pointer) and store their hash,
+			// which only depends on the hash of their direct children. Interned nodes also remember their id once registered.
 			struct Constant
 			{
 				explicit Constant(AnyConstant c) :
-				constant(std::move(c))
+				constant(std::move(c)),
+				hash(ComputeHash(constant))
 				{
 				}
 
 				AnyConstant constant;
+				std::size_t hash;
+				mutable const void* owner = nullptr; //< cache internals which interned this node
+				mutable std::uint32_t id = 0; //< result id in the owner cache, 0 until registered
 			};
 
 			struct Type
 			{
 				explicit Type(AnyType c) :
-				type(std::move(c))
+				type(std::move(c)),
+				hash(ComputeHash(type))
 				{
 				}
 
 				AnyType type;
+				std::size_t hash;
+				mutable const void* owner = nullptr; //< cache internals which interned this node
+				mutable std::uint32_t id = 0; //< result id in the owner cache, 0 until registered
 			};
 
 			ConstantPtr BuildArrayConstant(const Ast::ConstantArrayValue& value) const;
 			ConstantPtr BuildConstant(const Ast::ConstantSingleValue& value) const;
+			ConstantPtr BuildSpecConstant(const Ast::ConstantSingleValue& defaultValue, std::uint32_t specId) const;
 			FieldOffsets BuildFieldOffsets(const Structure& structData) const;
 			TypePtr BuildFunctionType(const Ast::ExpressionType& retType, const std::vector<Ast::ExpressionType>& parameters) const;
 			TypePtr BuildFunctionType(TypePtr retType, std::vector<TypePtr> parameterTypes) const;
@@ -206,8 +224,8 @@ namespace nzsl
 			std::uint32_t GetId(const Type& t);
 
 			std::uint32_t Register(std::string debugString);
-			std::uint32_t Register(Constant c);
-			std::uint32_t Register(Type t);
+			std::uint32_t Register(const Constant& c);
+			std::uint32_t Register(const Type& t);
 			std::uint32_t Register(Variable v);
 
 			void RegisterSource(SpirvSourceLanguage sourceLang, std::uint32_t version, std::uint32_t fileNameId = 0, std::string source = "");
@@ -244,13 +262,19 @@ namespace nzsl
 			struct Internal;
 			template<typename T, typename Enable = void> struct TypeBuilder;
 
-			template<typename T> static Type BuildSingleType();
+			template<typename T> TypePtr BuildSingleType() const;
 
-			void Write(const AnyConstant& constant, std::uint32_t resultId, SpirvSection& constants);
+			ConstantPtr InternConstant(AnyConstant constant) const;
+			TypePtr InternType(AnyType type) const;
+
+			void Write(const AnyConstant& constant, std::uint32_t resultId, SpirvSection& annotations, SpirvSection& constants);
 			void Write(const AnyType& type, std::uint32_t resultId, SpirvSection& annotations, SpirvSection& constants, SpirvSection& debugInfos, DebugLevel debugInfo);
 
 			void WriteStruct(const Structure& structData, std::uint32_t resultId, SpirvSection& annotations, SpirvSection& constants, SpirvSection& debugInfos, DebugLevel debugInfo);
 
+			static std::size_t ComputeHash(const AnyConstant& constant);
+			static std::size_t ComputeHash(const AnyType& type);
+
 			mutable Nz::PrivateImpl<Internal> m_internal;
 	};
 }
@@ -7,41 +7,41 @@ namespace nzsl
 	template<>
 	struct SpirvConstantCache::TypeBuilder<bool>
 	{
-		static Type Build()
+		static AnyType Build(const SpirvConstantCache& /*cache*/)
 		{
-			return Type{ Bool{} };
+			return Bool{};
 		}
 	};
 
 	template<typename T>
 	struct SpirvConstantCache::TypeBuilder<T, std::enable_if_t<std::is_floating_point_v<T>>>
 	{
-		static Type Build()
+		static AnyType Build(const SpirvConstantCache& /*cache*/)
 		{
-			return Type{ Float{ sizeof(T) * CHAR_BIT } };
+			return Float{ sizeof(T) * CHAR_BIT };
 		}
 	};
 
 	template<typename T>
 	struct SpirvConstantCache::TypeBuilder<T, std::enable_if_t<std::is_integral_v<T>>>
 	{
-		static Type Build()
+		static AnyType Build(const SpirvConstantCache& /*cache*/)
 		{
-			return Type{ Integer{ sizeof(T) * CHAR_BIT, std::is_signed_v<T> } };
+			return Integer{ sizeof(T) * CHAR_BIT, std::is_signed_v<T> };
 		}
 	};
 
 	template<typename T, std::size_t N>
 	struct SpirvConstantCache::TypeBuilder<Vector<T, N>>
 	{
-		static Type Build()
+		static AnyType Build(const SpirvConstantCache& cache)
 		{
-			return Type{ Vector{ std::make_shared<Type>(BuildSingleType<T>()), Nz::SafeCast<std::uint32_t>(N) } };
+			return Vector{ cache.BuildSingleType<T>(), Nz::SafeCast<std::uint32_t>(N) };
 		}
 	};
 
 	template<typename T>
-	auto SpirvConstantCache::BuildSingleType() -> Type
+	auto SpirvConstantCache::BuildSingleType() const -> TypePtr
 	{
 		if constexpr (std::is_same_v<T, Ast::NoValue>)
 			throw std::runtime_error("invalid type (value expected)");
@@ -50,6 +50,6 @@ namespace nzsl
 		else if constexpr (std::is_same_v<T, std::string>)
 			throw std::runtime_error("unexpected string literal");
 		else
-			return TypeBuilder<T>::Build();
+			return InternType(TypeBuilder<T>::Build(*this));
 	}
 }
@@ -24,6 +24,7 @@ namespace nzsl
 			~SpirvDecoder() = default;
 
 			void Decode(const std::uint32_t* codepoints, std::size_t count);
+			bool DecodeInstructions(const std::uint32_t* codepoints, std::size_t count); //< decodes instructions following the header (for modules split in several parts), returns false if stopped by HandleOpcode
 
 			SpirvDecoder& operator=(const SpirvDecoder&) = default;
 			SpirvDecoder& operator=(SpirvDecoder&&) = default;
@@ -0,0 +1,74 @@
+// Copyright (C) 2026 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NZSL_SPIRV_SPIRVOPTIMIZER_HPP
+#define NZSL_SPIRV_SPIRVOPTIMIZER_HPP
+
+#include <NZSL/Config.hpp>
+#include <NZSL/SpirV/SpirvDecoder.hpp>
+#include <functional>
+#include <vector>
+
+namespace nzsl
+{
+	class SpirvSection;
+
+	// Decodes a SPIR-V module into a light IR and runs simple cleanup passes on it before encoding it back
+	class NZSL_API SpirvOptimizer : SpirvDecoder
+	{
+		public:
+			struct Output;
+			struct Settings;
+
+			inline SpirvOptimizer();
+			SpirvOptimizer(const SpirvOptimizer&) = default;
+			SpirvOptimizer(SpirvOptimizer&&) = default;
+			~SpirvOptimizer() = default;
+
+			inline std::vector<std::uint32_t> Optimize(const std::vector<std::uint32_t>& codepoints);
+			inline std::vector<std::uint32_t> Optimize(const std::uint32_t* codepoints, std::size_t count);
+			inline std::vector<std::uint32_t> Optimize(const std::vector<std::uint32_t>& codepoints, const Settings& settings);
+			std::vector<std::uint32_t> Optimize(const std::uint32_t* codepoints, std::size_t count, const Settings& settings);
+			void Optimize(const SpirvSection* const* sections, std::size_t sectionCount, const Settings& settings, const Output& output); //< module split in consecutive sections (the first starting with the header), written directly to the output
+
+			SpirvOptimizer& operator=(const SpirvOptimizer&) = default;
+			SpirvOptimizer& operator=(SpirvOptimizer&&) = default;
+
+			struct Output
+			{
+				std::function<void(std::size_t wordCount)> reserve; //< optional, called once with the total word count before any append
+				std::function<void(const std::uint32_t* words, std::size_t wordCount)> append; //< called with consecutive chunks of the module, in order
+			};
+
+			struct Settings
+			{
+				bool compactIds = true;
+				bool deduplicateConstants = true;
+				bool eliminateDeadCode = true;
+				bool eliminateRedundantLoads = true;
+			};
+
+		private:
+			void CompactIds();
+			void DeduplicateConstants();
+			void EliminateDeadCode();
+			void EliminateRedundantLoads();
+			void RemapIds();
+			void RunPasses();
+			void StripUnusedDecorations();
+			void WriteModule(const Output& output) const;
+
+			bool HandleHeader(const SpirvHeader& header) override;
+			bool HandleOpcode(const SpirvInstruction& instruction, std::uint32_t wordCount) override;
+
+			struct State;
+			State* m_currentState;
+	};
+}
+
+#include <NZSL/SpirV/SpirvOptimizer.inl>
+
+#endif // NZSL_SPIRV_SPIRVOPTIMIZER_HPP
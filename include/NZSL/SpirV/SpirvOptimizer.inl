@@ -0,0 +1,28 @@
+// Copyright (C) 2026 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+
+namespace nzsl
+{
+	inline SpirvOptimizer::SpirvOptimizer() :
+	m_currentState(nullptr)
+	{
+	}
+
+	inline std::vector<std::uint32_t> SpirvOptimizer::Optimize(const std::vector<std::uint32_t>& codepoints)
+	{
+		return Optimize(codepoints.data(), codepoints.size());
+	}
+
+	inline std::vector<std::uint32_t> SpirvOptimizer::Optimize(const std::uint32_t* codepoints, std::size_t count)
+	{
+		Settings settings;
+		return Optimize(codepoints, count, settings);
+	}
+
+	inline std::vector<std::uint32_t> SpirvOptimizer::Optimize(const std::vector<std::uint32_t>& codepoints, const Settings& settings)
+	{
+		return Optimize(codepoints.data(), codepoints.size(), settings);
+	}
+}
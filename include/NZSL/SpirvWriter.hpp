@@ -14,6 +14,8 @@
 #include <NZSL/Ast/TransformerExecutor.hpp>
 #include <NZSL/SpirV/SpirvConstantCache.hpp>
 #include <NZSL/SpirV/SpirvVariable.hpp>
+#include <functional>
+#include <optional>
 #include <string>
 #include <unordered_map>
 
@@ -32,6 +34,7 @@ namespace nzsl
 
 		public:
 			struct Environment;
+			struct OutputSink;
 
 			SpirvWriter();
 			SpirvWriter(const SpirvWriter&) = delete;
@@ -39,6 +42,9 @@ namespace nzsl
 			~SpirvWriter() = default;
 
 			std::vector<std::uint32_t> Generate(Ast::Module& module, const BackendParameters& parameters = {});
+			std::vector<std::uint32_t> Generate(const Ast::Module& module, const BackendParameters& parameters = {}); //< performs a full clone of the module and transforms it, prefer the non-const overload when the module may be modified
+			void Generate(Ast::Module& module, const OutputSink& sink, const BackendParameters& parameters = {});
+			PermutationOutputs<std::vector<std::uint32_t>> GeneratePermutations(const Ast::Module& module, const std::vector<OptionValues>& optionPermutations, const BackendParameters& parameters = {});
 
 			const SpirvVariable& GetConstantVariable(std::size_t constIndex) const;
 
@@ -52,8 +58,15 @@ namespace nzsl
 				std::uint32_t spvMinorVersion = 0;
 			};
 
+			// Receives the generated words directly from the writer sections, no intermediate buffer is built
+			struct OutputSink
+			{
+				std::function<void(std::size_t wordCount)> reserve; //< optional, called once with the total word count before any append
+				std::function<void(const std::uint32_t* words, std::size_t wordCount)> append; //< called with consecutive chunks of the module, in order
+			};
+
 			static std::pair<std::uint32_t, std::uint32_t> GetMaximumSupportedVersion(std::uint32_t vkMajorVersion, std::uint32_t vkMinorVersion);
-			static void RegisterPasses(Ast::TransformerExecutor& executor);
+			static void RegisterPasses(Ast::TransformerExecutor& executor, bool specializationConstants = false);
 
 		private:
 			struct FunctionParameter;
@@ -73,7 +86,8 @@ namespace nzsl
 			std::uint32_t GetFunctionTypeId(const Ast::DeclareFunctionStatement& functionNode);
 			std::uint32_t GetPointerTypeId(const SpirvConstantCache::TypePtr& typePtr, SpirvStorageClass storageClass) const;
 			std::uint32_t GetPointerTypeId(const Ast::ExpressionType& type, SpirvStorageClass storageClass) const;
-			std::uint32_t GetSourceFileId(const std::shared_ptr<const std::string>& filepathPtr);
+			std::uint32_t GetSourceFileId(std::uint32_t fileIndex);
+			std::optional<std::uint32_t> GetSpecConstantId(std::size_t constIndex) const;
 			std::uint32_t GetTypeId(const SpirvConstantCache::Type& type) const;
 			std::uint32_t GetTypeId(const Ast::ExpressionType& type) const;
 
@@ -86,7 +100,7 @@ namespace nzsl
 			std::uint32_t RegisterSingleConstant(const Ast::ConstantSingleValue& value);
 			std::uint32_t RegisterType(Ast::ExpressionType type);
 
-			static void MergeSections(std::vector<std::uint32_t>& output, const SpirvSection& from);
+			void RunPasses(Ast::Module& module, const BackendParameters& parameters, bool keepUnsetScalarOptions = false);
 
 			struct Context
 			{
@@ -49,6 +49,22 @@ extern "C"
 			parameters->backendPasses &= ~nzsl::BackendPass::Resolve;
 	}
 
+	CNZSL_API void nzslBackendParametersEnableSpecializationConstants(nzslBackendParameters* parameters, nzslBool enable)
+	{
+		if (enable)
+			parameters->backendPasses |= nzsl::BackendPass::SpecializationConstants;
+		else
+			parameters->backendPasses &= ~nzsl::BackendPass::SpecializationConstants;
+	}
+
+	CNZSL_API void nzslBackendParametersEnableSpirvOptimization(nzslBackendParameters* parameters, nzslBool enable)
+	{
+		if (enable)
+			parameters->backendPasses |= nzsl::BackendPass::OptimizeSpirv;
+		else
+			parameters->backendPasses &= ~nzsl::BackendPass::OptimizeSpirv;
+	}
+
 	CNZSL_API void nzslBackendParametersEnableTargetRequired(nzslBackendParameters* parameters, nzslBool enable)
 	{
 		if (enable)
@@ -65,6 +81,14 @@ extern "C"
 			parameters->backendPasses &= ~nzsl::BackendPass::Validate;
 	}
 
+	CNZSL_API void nzslBackendParametersEnableVariablePromotion(nzslBackendParameters* parameters, nzslBool enable)
+	{
+		if (enable)
+			parameters->backendPasses |= nzsl::BackendPass::PromoteVariables;
+		else
+			parameters->backendPasses &= ~nzsl::BackendPass::PromoteVariables;
+	}
+
 	CNZSL_API void nzslBackendParametersSetDebugLevel(nzslBackendParameters* parameters, nzslDebugLevel debugLevel)
 	{
 		constexpr std::array s_debugLevels = {
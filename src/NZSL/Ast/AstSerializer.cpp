@@ -4,7 +4,9 @@
 
 #include <NZSL/Ast/AstSerializer.hpp>
 #include <NazaraUtils/TypeTag.hpp>
+#include <NZSL/Parser.hpp>
 #include <NZSL/ShaderBuilder.hpp>
+#include <NZSL/Ast/Cloner.hpp>
 #include <NZSL/Ast/ExpressionVisitor.hpp>
 #include <NZSL/Ast/StatementVisitor.hpp>
 #include <NZSL/Lang/Version.hpp>
@@ -49,7 +51,7 @@ namespace nzsl::Ast
 	namespace
 	{
 		constexpr std::uint32_t s_shaderAstMagicNumber = 0x4E534852;
-		constexpr std::uint32_t s_shaderAstCurrentVersion = 17;
+		constexpr std::uint32_t s_shaderAstCurrentVersion = 18;
 
 		class ShaderSerializerVisitor : public ExpressionVisitor, public StatementVisitor
 		{
@@ -392,6 +394,29 @@ namespace nzsl::Ast
 				Enum(parameter.semantic);
 		}
 
+		// Function bodies are always serialized as statements, deferred and shared bodies are built into a copy
+		// as the serialized module must be left untouched
+		if (IsWriting() && (node.deferredBody || node.sharedBody))
+		{
+			DeclareFunctionStatement bodyHolder;
+			bodyHolder.deferredBody = node.deferredBody;
+			ParseDeferredFunctionBody(bodyHolder);
+
+			std::vector<StatementPtr> statements = std::move(bodyHolder.statements);
+			if (node.sharedBody)
+			{
+				statements.reserve(statements.size() + node.sharedBody->statements.size());
+				for (const auto& statement : node.sharedBody->statements)
+					statements.push_back(Ast::Clone(*statement));
+			}
+
+			Container(statements);
+			for (auto& statement : statements)
+				Node(statement);
+
+			return;
+		}
+
 		Container(node.statements);
 		for (auto& statement : node.statements)
 			Node(statement);
@@ -403,6 +428,9 @@ namespace nzsl::Ast
 		Value(node.optName);
 		ExprValue(node.optType);
 		Node(node.defaultValue);
+
+		if (IsVersionGreaterOrEqual(18))
+			Value(node.isCompileTimeUsed);
 	}
 
 	void SerializerBase::Serialize(DeclareStructStatement& node)
@@ -5,6 +5,7 @@
 #include <NZSL/Ast/Cloner.hpp>
 #include <NZSL/Ast/Module.hpp>
 #include <memory>
+#include <optional>
 #include <stdexcept>
 
 namespace nzsl::Ast
@@ -23,6 +24,11 @@ namespace nzsl::Ast
 
 	ModulePtr Cloner::Clone(const Module& module)
 	{
+		// a module clone gets its own arena, so both modules can be transformed concurrently
+		std::optional<NodeArena::Scope> arenaScope;
+		if (module.arena)
+			arenaScope.emplace(std::make_shared<NodeArena>());
+
 		MultiStatementPtr rootNode = Nz::StaticUniquePointerCast<MultiStatement>(CloneStatement(*module.rootNode));
 		std::vector<Module::ImportedModule> importedModules(module.importedModules.size());
 		for (std::size_t i = 0; i < importedModules.size(); ++i)
@@ -56,6 +62,16 @@ namespace nzsl::Ast
 		return Clone(statement);
 	}
 
+	void Cloner::CloneFunctionBody(DeclareFunctionStatement& node, DeclareFunctionStatement& clone)
+	{
+		clone.deferredBody = node.deferredBody;
+		clone.sharedBody = node.sharedBody;
+
+		clone.statements.reserve(node.statements.size());
+		for (auto& statement : node.statements)
+			clone.statements.push_back(CloneStatement(statement));
+	}
+
 	ExpressionValue<ExpressionType> Cloner::CloneType(const ExpressionValue<ExpressionType>& exprType)
 	{
 		if (!exprType.HasValue())
@@ -178,9 +194,7 @@ namespace nzsl::Ast
 			cloneParam.sourceLocation = parameter.sourceLocation;
 		}
 
-		clone->statements.reserve(node.statements.size());
-		for (auto& statement : node.statements)
-			clone->statements.push_back(CloneStatement(statement));
+		CloneFunctionBody(node, *clone);
 
 		return clone;
 	}
@@ -189,6 +203,7 @@ namespace nzsl::Ast
 	{
 		auto clone = std::make_unique<DeclareOptionStatement>();
 		clone->defaultValue = CloneExpression(node.defaultValue);
+		clone->isCompileTimeUsed = node.isCompileTimeUsed;
 		clone->optIndex = node.optIndex;
 		clone->optName = node.optName;
 		clone->optType = Clone(node.optType);
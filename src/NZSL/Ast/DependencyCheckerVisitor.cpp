@@ -12,6 +12,21 @@ namespace nzsl::Ast
 		statement.Visit(*this);
 	}
 
+	void DependencyCheckerVisitor::UpdateFunction(DeclareFunctionStatement& node)
+	{
+		// Forget previously registered dependencies of the function (used when its body changed after registration)
+		assert(node.funcIndex);
+		m_functionUsages.erase(*node.funcIndex);
+
+		for (auto& parameter : node.parameters)
+		{
+			assert(parameter.varIndex);
+			m_variableUsages.erase(*parameter.varIndex);
+		}
+
+		node.Visit(*this);
+	}
+
 	auto DependencyCheckerVisitor::GetContextUsageSet() -> UsageSet&
 	{
 		if (m_currentAliasDeclIndex)
@@ -0,0 +1,89 @@
+// Copyright (C) 2026 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <NZSL/Ast/InternedString.hpp>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace nzsl::Ast
+{
+	namespace
+	{
+		// The table is split in shards with their own lock, so threads interning different names rarely wait on each other
+		constexpr std::size_t ShardCount = 16;
+
+		struct StringTableShard
+		{
+			std::deque<std::string> strings; //< deque never moves its elements, so handles stay valid
+			std::mutex mutex;
+			std::unordered_map<std::string_view, const std::string*> stringByView; //< views into strings
+		};
+
+		std::array<StringTableShard, ShardCount>& GetStringTable()
+		{
+			static std::array<StringTableShard, ShardCount> stringTable;
+			return stringTable;
+		}
+
+		// Incremented when the table is cleared, invalidating thread caches
+		std::atomic_uint64_t s_tableGeneration = 0;
+
+		// Strings already interned by this thread, entries are only removed from the table by ClearTable so they can be looked up without locking
+		struct ThreadCache
+		{
+			std::uint64_t generation = 0;
+			std::unordered_map<std::string_view, const std::string*> stringByView;
+		};
+
+		thread_local ThreadCache s_threadCache;
+	}
+
+	InternedString::InternedString(std::string_view str)
+	{
+		if (str.empty())
+			return;
+
+		std::uint64_t generation = s_tableGeneration.load(std::memory_order_acquire);
+		if (s_threadCache.generation != generation)
+		{
+			s_threadCache.stringByView.clear();
+			s_threadCache.generation = generation;
+		}
+
+		if (auto it = s_threadCache.stringByView.find(str); it != s_threadCache.stringByView.end())
+		{
+			m_str = it->second;
+			return;
+		}
+
+		StringTableShard& shard = GetStringTable()[std::hash<std::string_view>{}(str) % ShardCount];
+		{
+			std::lock_guard lock(shard.mutex);
+			if (auto it = shard.stringByView.find(str); it != shard.stringByView.end())
+				m_str = it->second;
+			else
+			{
+				m_str = &shard.strings.emplace_back(str);
+				shard.stringByView.emplace(*m_str, m_str);
+			}
+		}
+
+		s_threadCache.stringByView.emplace(*m_str, m_str);
+	}
+
+	void InternedString::ClearTable()
+	{
+		for (StringTableShard& shard : GetStringTable())
+		{
+			std::lock_guard lock(shard.mutex);
+			shard.stringByView.clear();
+			shard.strings.clear();
+		}
+
+		s_tableGeneration.fetch_add(1, std::memory_order_acq_rel);
+	}
+}
@@ -0,0 +1,112 @@
+// Copyright (C) 2026 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <NZSL/Ast/InternedType.hpp>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace nzsl::Ast
+{
+	namespace
+	{
+		// The table is split in shards with their own lock, so threads interning different types rarely wait on each other
+		constexpr std::size_t ShardCount = 16;
+
+		// Entries are indexed by the hash of their type, which is computed once per lookup
+		using TypeIndex = std::unordered_multimap<std::size_t, const ExpressionType*>;
+
+		struct TypeTableShard
+		{
+			std::deque<ExpressionType> types; //< deque never moves its elements, so handles stay valid
+			std::mutex mutex;
+			TypeIndex typeByHash;
+		};
+
+		std::array<TypeTableShard, ShardCount>& GetTypeTable()
+		{
+			static std::array<TypeTableShard, ShardCount> typeTable;
+			return typeTable;
+		}
+
+		// Incremented when the table is cleared, invalidating thread caches
+		std::atomic_uint64_t s_tableGeneration = 0;
+
+		// Types already interned by this thread, entries are only removed from the table by ClearTable so they can be looked up without locking
+		struct ThreadCache
+		{
+			std::uint64_t generation = 0;
+			TypeIndex typeByHash;
+		};
+
+		thread_local ThreadCache s_threadCache;
+
+		const ExpressionType* FindType(const TypeIndex& typeIndex, std::size_t hash, const ExpressionType& type)
+		{
+			auto range = typeIndex.equal_range(hash);
+			for (auto it = range.first; it != range.second; ++it)
+			{
+				if (*it->second == type)
+					return it->second;
+			}
+
+			return nullptr;
+		}
+
+		template<typename T>
+		const ExpressionType* Intern(T&& type)
+		{
+			std::uint64_t generation = s_tableGeneration.load(std::memory_order_acquire);
+			if (s_threadCache.generation != generation)
+			{
+				s_threadCache.typeByHash.clear();
+				s_threadCache.generation = generation;
+			}
+
+			std::size_t hash = std::hash<ExpressionType>{}(type);
+			if (const ExpressionType* cachedType = FindType(s_threadCache.typeByHash, hash, type))
+				return cachedType;
+
+			TypeTableShard& shard = GetTypeTable()[hash % ShardCount];
+
+			const ExpressionType* internedType;
+			{
+				std::lock_guard lock(shard.mutex);
+				internedType = FindType(shard.typeByHash, hash, type);
+				if (!internedType)
+				{
+					internedType = &shard.types.emplace_back(std::forward<T>(type));
+					shard.typeByHash.emplace(hash, internedType);
+				}
+			}
+
+			s_threadCache.typeByHash.emplace(hash, internedType);
+			return internedType;
+		}
+	}
+
+	InternedType::InternedType(const ExpressionType& type) :
+	m_type(Intern(type))
+	{
+	}
+
+	InternedType::InternedType(ExpressionType&& type) :
+	m_type(Intern(std::move(type)))
+	{
+	}
+
+	void InternedType::ClearTable()
+	{
+		for (TypeTableShard& shard : GetTypeTable())
+		{
+			std::lock_guard lock(shard.mutex);
+			shard.typeByHash.clear();
+			shard.types.clear();
+		}
+
+		s_tableGeneration.fetch_add(1, std::memory_order_acq_rel);
+	}
+}
@@ -0,0 +1,57 @@
+// Copyright (C) 2026 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <NZSL/Ast/NodeArena.hpp>
+#include <iterator>
+#include <utility>
+
+namespace nzsl::Ast
+{
+	namespace
+	{
+		thread_local std::shared_ptr<NodeArena> s_currentArena;
+	}
+
+	void* NodeArena::Allocate(std::size_t size)
+	{
+		constexpr std::size_t alignment = alignof(std::max_align_t);
+		size = (size + alignment - 1) / alignment * alignment;
+
+		if (size > m_blockSize - m_freeOffset)
+		{
+			if (size > m_blockSize / 2)
+			{
+				// big allocations get their own block, so the current one (always the last) can still be filled
+				auto blockIt = m_blocks.emplace((m_blocks.empty()) ? m_blocks.end() : std::prev(m_blocks.end()), new std::byte[size]);
+				m_allocatedSize += size;
+
+				return blockIt->get();
+			}
+
+			m_blocks.emplace_back(new std::byte[m_blockSize]);
+			m_freeOffset = 0;
+		}
+
+		void* ptr = m_blocks.back().get() + m_freeOffset;
+		m_freeOffset += size;
+		m_allocatedSize += size;
+
+		return ptr;
+	}
+
+	const std::shared_ptr<NodeArena>& NodeArena::GetCurrent()
+	{
+		return s_currentArena;
+	}
+
+	NodeArena::Scope::Scope(std::shared_ptr<NodeArena> arena) :
+	m_previousArena(std::exchange(s_currentArena, std::move(arena)))
+	{
+	}
+
+	NodeArena::Scope::~Scope()
+	{
+		s_currentArena = std::move(m_previousArena);
+	}
+}
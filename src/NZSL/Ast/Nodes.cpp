@@ -5,13 +5,58 @@
 #include <NZSL/Ast/Nodes.hpp>
 #include <NazaraUtils/Algorithm.hpp>
 #include <NZSL/Ast/ExpressionVisitor.hpp>
+#include <NZSL/Ast/NodeArena.hpp>
 #include <NZSL/Ast/StatementVisitor.hpp>
+#include <new>
 #include <stdexcept>
 
 namespace nzsl::Ast
 {
+	namespace
+	{
+		// Every node is prefixed by the arena it was allocated from (null if allocated on the heap), the arena is not owned by its nodes
+		using NodeHeader = NodeArena*;
+
+		constexpr std::size_t NodeHeaderSize = (sizeof(NodeHeader) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+		thread_local std::size_t s_allocatedBytes = 0;
+		thread_local std::size_t s_allocationCount = 0;
+	}
+
 	Node::~Node() = default;
 
+	void* Node::operator new(std::size_t size)
+	{
+		NodeArena* arena = NodeArena::GetCurrent().get();
+
+		void* memory = (arena) ? arena->Allocate(NodeHeaderSize + size) : ::operator new(NodeHeaderSize + size);
+		new (memory) NodeHeader(arena);
+
+		s_allocatedBytes += NodeHeaderSize + size;
+		s_allocationCount++;
+
+		return static_cast<std::byte*>(memory) + NodeHeaderSize;
+	}
+
+	void Node::operator delete(void* ptr)
+	{
+		void* memory = static_cast<std::byte*>(ptr) - NodeHeaderSize;
+
+		// arena memory is only released with the arena itself
+		if (!*static_cast<NodeHeader*>(memory))
+			::operator delete(memory);
+	}
+
+	std::size_t Node::GetThreadAllocatedBytes()
+	{
+		return s_allocatedBytes;
+	}
+
+	std::size_t Node::GetThreadAllocationCount()
+	{
+		return s_allocationCount;
+	}
+
 	std::string_view ToString(FunctionParameterSemantic semantic)
 	{
 		switch (semantic)
@@ -0,0 +1,59 @@
+// Copyright (C) 2026 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <NZSL/Ast/PassInstrumentation.hpp>
+#include <NZSL/Ast/Nodes.hpp>
+#include <NZSL/Ast/Transformations/TransformerContext.hpp>
+
+namespace nzsl::Ast
+{
+	PassInstrumentation::Scope::Scope(const PassInstrumentation& instrumentation, std::string_view passName, const TransformerContext* context) :
+	m_passName(passName),
+	m_instrumentation(instrumentation),
+	m_context(context)
+	{
+		if (!m_instrumentation.IsEnabled())
+			return;
+
+		m_createdNodeCount = Node::GetThreadAllocationCount();
+		m_replacedNodeCount = (m_context) ? m_context->replacedNodeCount : 0;
+		m_visitedNodeCount = (m_context) ? m_context->visitedNodeCount : 0;
+		m_allocationCounters = QueryAllocationCounters();
+
+		// Query time last so the measure doesn't include instrumentation
+		m_startTime = std::chrono::steady_clock::now();
+	}
+
+	PassInstrumentation::Scope::~Scope()
+	{
+		if (!m_instrumentation.IsEnabled())
+			return;
+
+		auto endTime = std::chrono::steady_clock::now();
+		AllocationCounters allocationCounters = QueryAllocationCounters();
+
+		PassStatistics statistics;
+		statistics.duration = std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - m_startTime);
+		statistics.allocatedBytes = allocationCounters.allocatedBytes - m_allocationCounters.allocatedBytes;
+		statistics.allocationCount = allocationCounters.allocationCount - m_allocationCounters.allocationCount;
+		statistics.createdNodeCount = Node::GetThreadAllocationCount() - m_createdNodeCount;
+		statistics.replacedNodeCount = (m_context) ? m_context->replacedNodeCount - m_replacedNodeCount : 0;
+		statistics.visitedNodeCount = (m_context) ? m_context->visitedNodeCount - m_visitedNodeCount : 0;
+		statistics.passName = m_passName;
+
+		m_instrumentation.callback(statistics);
+	}
+
+	auto PassInstrumentation::Scope::QueryAllocationCounters() const -> AllocationCounters
+	{
+		if (m_instrumentation.allocationCounters)
+			return m_instrumentation.allocationCounters();
+
+		AllocationCounters nodeCounters;
+		nodeCounters.allocatedBytes = Node::GetThreadAllocatedBytes();
+		nodeCounters.allocationCount = Node::GetThreadAllocationCount();
+
+		return nodeCounters;
+	}
+}
@@ -8,237 +8,191 @@ namespace nzsl::Ast
 {
 	void RecursiveVisitor::Visit(AccessFieldExpression& node)
 	{
-		node.expr->Visit(*this);
+		StaticRecursiveVisitor::Visit(node);
 	}
 
 	void RecursiveVisitor::Visit(AccessIdentifierExpression& node)
 	{
-		node.expr->Visit(*this);
+		StaticRecursiveVisitor::Visit(node);
 	}
 
 	void RecursiveVisitor::Visit(AccessIndexExpression& node)
 	{
-		node.expr->Visit(*this);
-		for (auto& index : node.indices)
-			index->Visit(*this);
+		StaticRecursiveVisitor::Visit(node);
 	}
 
 	void RecursiveVisitor::Visit(AssignExpression& node)
 	{
-		node.left->Visit(*this);
-		node.right->Visit(*this);
+		StaticRecursiveVisitor::Visit(node);
 	}
 
 	void RecursiveVisitor::Visit(BinaryExpression& node)
 	{
-		node.left->Visit(*this);
-		node.right->Visit(*this);
+		StaticRecursiveVisitor::Visit(node);
 	}
 
 	void RecursiveVisitor::Visit(CallFunctionExpression& node)
 	{
-		for (auto& param : node.parameters)
-			param.expr->Visit(*this);
-
-		node.targetFunction->Visit(*this);
+		StaticRecursiveVisitor::Visit(node);
 	}
 
 	void RecursiveVisitor::Visit(CallMethodExpression& node)
 	{
-		node.object->Visit(*this);
-
-		for (auto& param : node.parameters)
-			param->Visit(*this);
+		StaticRecursiveVisitor::Visit(node);
 	}
 
 	void RecursiveVisitor::Visit(CastExpression& node)
 	{
-		for (auto& expr : node.expressions)
-			expr->Visit(*this);
+		StaticRecursiveVisitor::Visit(node);
 	}
 
 	void RecursiveVisitor::Visit(ConditionalExpression& node)
 	{
-		node.truePath->Visit(*this);
-		node.falsePath->Visit(*this);
+		StaticRecursiveVisitor::Visit(node);
 	}
 
-	void RecursiveVisitor::Visit(ConstantArrayValueExpression& /*node*/)
+	void RecursiveVisitor::Visit(ConstantArrayValueExpression& node)
 	{
-		/* Nothing to do */
+		StaticRecursiveVisitor::Visit(node);
 	}
 
-	void RecursiveVisitor::Visit(ConstantValueExpression& /*node*/)
+	void RecursiveVisitor::Visit(ConstantValueExpression& node)
 	{
-		/* Nothing to do */
+		StaticRecursiveVisitor::Visit(node);
 	}
 
-	void RecursiveVisitor::Visit(IdentifierExpression& /*node*/)
+	void RecursiveVisitor::Visit(IdentifierExpression& node)
 	{
-		/* Nothing to do */
+		StaticRecursiveVisitor::Visit(node);
 	}
 
-	void RecursiveVisitor::Visit(IdentifierValueExpression& /*node*/)
+	void RecursiveVisitor::Visit(IdentifierValueExpression& node)
 	{
-		/* Nothing to do */
+		StaticRecursiveVisitor::Visit(node);
 	}
 
 	void RecursiveVisitor::Visit(IntrinsicExpression& node)
 	{
-		for (auto& param : node.parameters)
-			param->Visit(*this);
+		StaticRecursiveVisitor::Visit(node);
 	}
 
 	void RecursiveVisitor::Visit(SwizzleExpression& node)
 	{
-		if (node.expression)
-			node.expression->Visit(*this);
+		StaticRecursiveVisitor::Visit(node);
 	}
 
-	void RecursiveVisitor::Visit(TypeConstantExpression& /*node*/)
+	void RecursiveVisitor::Visit(TypeConstantExpression& node)
 	{
-		/* Nothing to do */
+		StaticRecursiveVisitor::Visit(node);
 	}
 
 	void RecursiveVisitor::Visit(UnaryExpression& node)
 	{
-		if (node.expression)
-			node.expression->Visit(*this);
+		StaticRecursiveVisitor::Visit(node);
 	}
 
 	void RecursiveVisitor::Visit(BranchStatement& node)
 	{
-		for (auto& cond : node.condStatements)
-		{
-			cond.condition->Visit(*this);
-			cond.statement->Visit(*this);
-		}
-
-		if (node.elseStatement)
-			node.elseStatement->Visit(*this);
+		StaticRecursiveVisitor::Visit(node);
 	}
 
-	void RecursiveVisitor::Visit(BreakStatement& /*node*/)
+	void RecursiveVisitor::Visit(BreakStatement& node)
 	{
+		StaticRecursiveVisitor::Visit(node);
 	}
 
 	void RecursiveVisitor::Visit(ConditionalStatement& node)
 	{
-		node.statement->Visit(*this);
+		StaticRecursiveVisitor::Visit(node);
 	}
 
-	void RecursiveVisitor::Visit(ContinueStatement& /*node*/)
+	void RecursiveVisitor::Visit(ContinueStatement& node)
 	{
+		StaticRecursiveVisitor::Visit(node);
 	}
 
 	void RecursiveVisitor::Visit(DeclareAliasStatement& node)
 	{
-		if (node.expression)
-			node.expression->Visit(*this);
+		StaticRecursiveVisitor::Visit(node);
 	}
 
 	void RecursiveVisitor::Visit(DeclareConstStatement& node)
 	{
-		if (node.expression)
-			node.expression->Visit(*this);
+		StaticRecursiveVisitor::Visit(node);
 	}
 
-	void RecursiveVisitor::Visit(DeclareExternalStatement& /*node*/)
+	void RecursiveVisitor::Visit(DeclareExternalStatement& node)
 	{
-		/* Nothing to do */
+		StaticRecursiveVisitor::Visit(node);
 	}
 
 	void RecursiveVisitor::Visit(DeclareFunctionStatement& node)
 	{
-		for (auto& statement : node.statements)
-			statement->Visit(*this);
+		StaticRecursiveVisitor::Visit(node);
 	}
 
 	void RecursiveVisitor::Visit(DeclareOptionStatement& node)
 	{
-		if (node.defaultValue)
-			node.defaultValue->Visit(*this);
+		StaticRecursiveVisitor::Visit(node);
 	}
 
-	void RecursiveVisitor::Visit(DeclareStructStatement& /*node*/)
+	void RecursiveVisitor::Visit(DeclareStructStatement& node)
 	{
-		/* Nothing to do */
+		StaticRecursiveVisitor::Visit(node);
 	}
 
 	void RecursiveVisitor::Visit(DeclareVariableStatement& node)
 	{
-		if (node.initialExpression)
-			node.initialExpression->Visit(*this);
+		StaticRecursiveVisitor::Visit(node);
 	}
 
-	void RecursiveVisitor::Visit(DiscardStatement& /*node*/)
+	void RecursiveVisitor::Visit(DiscardStatement& node)
 	{
-		/* Nothing to do */
+		StaticRecursiveVisitor::Visit(node);
 	}
 
 	void RecursiveVisitor::Visit(ExpressionStatement& node)
 	{
-		node.expression->Visit(*this);
+		StaticRecursiveVisitor::Visit(node);
 	}
 
 	void RecursiveVisitor::Visit(ForStatement& node)
 	{
-		if (node.fromExpr)
-			node.fromExpr->Visit(*this);
-
-		if (node.toExpr)
-			node.toExpr->Visit(*this);
-
-		if (node.stepExpr)
-			node.stepExpr->Visit(*this);
-
-		if (node.statement)
-			node.statement->Visit(*this);
+		StaticRecursiveVisitor::Visit(node);
 	}
 
 	void RecursiveVisitor::Visit(ForEachStatement& node)
 	{
-		if (node.expression)
-			node.expression->Visit(*this);
-
-		if (node.statement)
-			node.statement->Visit(*this);
+		StaticRecursiveVisitor::Visit(node);
 	}
 
-	void RecursiveVisitor::Visit(ImportStatement& /*node*/)
+	void RecursiveVisitor::Visit(ImportStatement& node)
 	{
-		/* nothing to do */
+		StaticRecursiveVisitor::Visit(node);
 	}
 
 	void RecursiveVisitor::Visit(MultiStatement& node)
 	{
-		for (auto& statement : node.statements)
-			statement->Visit(*this);
+		StaticRecursiveVisitor::Visit(node);
 	}
 
-	void RecursiveVisitor::Visit(NoOpStatement& /*node*/)
+	void RecursiveVisitor::Visit(NoOpStatement& node)
 	{
-		/* Nothing to do */
+		StaticRecursiveVisitor::Visit(node);
 	}
 
 	void RecursiveVisitor::Visit(ReturnStatement& node)
 	{
-		if (node.returnExpr)
-			node.returnExpr->Visit(*this);
+		StaticRecursiveVisitor::Visit(node);
 	}
 
 	void RecursiveVisitor::Visit(ScopedStatement& node)
 	{
-		if (node.statement)
-			node.statement->Visit(*this);
+		StaticRecursiveVisitor::Visit(node);
 	}
 
 	void RecursiveVisitor::Visit(WhileStatement& node)
 	{
-		if (node.condition)
-			node.condition->Visit(*this);
-
-		if (node.body)
-			node.body->Visit(*this);
+		StaticRecursiveVisitor::Visit(node);
 	}
 }
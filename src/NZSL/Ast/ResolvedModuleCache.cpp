@@ -0,0 +1,120 @@
+// Copyright (C) 2026 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <NZSL/Ast/ResolvedModuleCache.hpp>
+#include <NZSL/Ast/Cloner.hpp>
+#include <NZSL/Ast/Compare.hpp>
+#include <NZSL/Ast/Hash.hpp>
+#include <NZSL/Ast/NodeArena.hpp>
+#include <NZSL/Ast/Transformations/ResolveTransformer.hpp>
+#include <algorithm>
+#include <cassert>
+
+namespace nzsl::Ast
+{
+	void ResolvedModuleCache::Clear()
+	{
+		std::lock_guard lock(m_mutex);
+		m_entries.clear();
+	}
+
+	void ResolvedModuleCache::Invalidate(const std::string& moduleName)
+	{
+		std::lock_guard lock(m_mutex);
+		m_entries.erase(moduleName);
+	}
+
+	std::shared_ptr<const Module> ResolvedModuleCache::Retrieve(const ModulePtr& module, std::optional<std::uint64_t> moduleVersion)
+	{
+		assert(module);
+
+		// Without a version, entries are matched on the module content and not its address, as a module can be modified in place
+		std::optional<std::size_t> sourceHash;
+		if (!moduleVersion)
+			sourceHash = Hash(*module);
+
+		std::shared_ptr<Entry> entry;
+		std::promise<std::shared_ptr<const Module>> resolvePromise;
+		bool resolve = false;
+		{
+			std::lock_guard lock(m_mutex);
+
+			std::shared_ptr<Entry>& cachedEntry = m_entries[module->metadata->moduleName];
+
+			bool upToDate;
+			if (moduleVersion)
+				upToDate = cachedEntry && cachedEntry->moduleVersion == moduleVersion && cachedEntry->versionedModule.lock() == module;
+			else
+				upToDate = cachedEntry && cachedEntry->sourceHash == *sourceHash && Compare(*cachedEntry->sourceModule, *module);
+
+			if (!upToDate)
+			{
+				// The module is resolved anyway, keep what's needed to recognize it from retrievals without a version
+				if (!sourceHash)
+					sourceHash = Hash(*module);
+
+				cachedEntry = std::make_shared<Entry>();
+				cachedEntry->resolvedModule = resolvePromise.get_future().share();
+				cachedEntry->moduleVersion = moduleVersion;
+				cachedEntry->sourceHash = *sourceHash;
+				cachedEntry->sourceModule = CloneModule(*module);
+				if (moduleVersion)
+					cachedEntry->versionedModule = module;
+
+				resolve = true;
+			}
+
+			entry = cachedEntry;
+		}
+
+		// Resolution happens outside of the lock, other threads retrieving the same module wait for it
+		if (resolve)
+		{
+			try
+			{
+				resolvePromise.set_value(ResolveModule(*module));
+			}
+			catch (...)
+			{
+				resolvePromise.set_exception(std::current_exception());
+				throw;
+			}
+		}
+
+		return entry->resolvedModule.get();
+	}
+
+	ModulePtr ResolvedModuleCache::CloneModule(const Module& module)
+	{
+		// Cached modules outlive the compilation retrieving them, don't allocate their nodes from its arena
+		NodeArena::Scope arenaScope(std::make_shared<NodeArena>());
+
+		return Clone(module);
+	}
+
+	std::shared_ptr<const Module> ResolvedModuleCache::ResolveModule(const Module& module)
+	{
+		// Modules importing other modules depend on what they resolve to in each compilation, don't cache them
+		bool hasImports = std::any_of(module.rootNode->statements.begin(), module.rootNode->statements.end(), [](const StatementPtr& statement)
+		{
+			return statement->GetType() == NodeType::ImportStatement;
+		});
+
+		if (hasImports || !module.importedModules.empty())
+			return nullptr;
+
+		ModulePtr resolvedModule = CloneModule(module);
+
+		// Options values and everything depending on them are only known once imported, partial compilation leaves them unresolved
+		TransformerContext context;
+		context.partialCompilation = true;
+
+		std::string error;
+		ResolveTransformer resolver;
+		if (!resolver.Transform(*resolvedModule, context, &error))
+			return nullptr; //< errors will be reported by the compilation importing it
+
+		return resolvedModule;
+	}
+}
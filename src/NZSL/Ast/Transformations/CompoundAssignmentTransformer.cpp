@@ -23,8 +23,6 @@ namespace nzsl::Ast
 		if (assign.op == AssignType::Simple || !m_options->removeCompoundAssignment)
 			return VisitChildren{};
 
-		HandleChildren(assign);
-
 		BinaryType binaryType;
 		switch (assign.op)
 		{
@@ -42,6 +40,7 @@ namespace nzsl::Ast
 		assign.right = ShaderBuilder::Binary(binaryType, Clone(*assign.left), std::move(assign.right));
 		assign.right->cachedExpressionType = assign.left->cachedExpressionType;
 
-		return DontVisitChildren{};
+		// Visit children after the rewrite so the generated binary expression gets transformed as well
+		return VisitChildren{};
 	}
 }
@@ -27,6 +27,12 @@ namespace nzsl::Ast
 
 			using type = T;
 		};
+
+		bool IsSpecializableValue(const ConstantSingleValue& value)
+		{
+			return std::holds_alternative<bool>(value) || std::holds_alternative<float>(value) || std::holds_alternative<double>(value) ||
+			       std::holds_alternative<std::int32_t>(value) || std::holds_alternative<std::uint32_t>(value);
+		}
 	}
 
 	bool ConstantRemovalTransformer::Transform(Module& module, TransformerContext& context, const Options& options, std::string* error)
@@ -75,7 +81,7 @@ namespace nzsl::Ast
 
 	auto ConstantRemovalTransformer::Transform(IntrinsicExpression&& intrinsicExpr) -> ExpressionTransformation
 	{
-		if (!m_options->removeConstArraySize)
+		if (!m_options->removeConstArraySize || m_options->replaceOptionsOnly)
 			return VisitChildren{};
 
 		HandleChildren(intrinsicExpr);
@@ -99,7 +105,7 @@ namespace nzsl::Ast
 
 	auto ConstantRemovalTransformer::Transform(TypeConstantExpression&& typeConstantExpr) -> ExpressionTransformation
 	{
-		if (!m_options->removeTypeConstant)
+		if (!m_options->removeTypeConstant || m_options->replaceOptionsOnly)
 			return VisitChildren{};
 
 		HandleChildren(typeConstantExpr);
@@ -111,6 +117,9 @@ namespace nzsl::Ast
 		if (!declConst.constIndex)
 			return VisitChildren{}; //< option has not been resolved yet
 
+		if (m_options->replaceOptionsOnly)
+			return VisitChildren{};
+
 		HandleChildren(declConst);
 
 		const auto& constantData = m_context->constants.Retrieve(*declConst.constIndex, declConst.sourceLocation);
@@ -140,6 +149,8 @@ namespace nzsl::Ast
 
 	auto ConstantRemovalTransformer::Transform(DeclareOptionStatement&& declOption) -> StatementTransformation
 	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
 		if (!declOption.optIndex)
 			return VisitChildren{}; //< option has not been resolved yet
 
@@ -151,7 +162,7 @@ namespace nzsl::Ast
 			m_optionValues.emplace(*declOption.optIndex, optionValueIt->second);
 		else
 		{
-			if (m_context->partialCompilation)
+			if (m_context->partialCompilation || m_options->replaceOptionsOnly)
 				return DontVisitChildren{}; //< option has no value in partial compilation, don't remove
 
 			if (!declOption.defaultValue)
@@ -159,7 +170,19 @@ namespace nzsl::Ast
 
 			const auto& constantData = m_context->constants.Retrieve(*declOption.optIndex, declOption.sourceLocation);
 			if (IsSingleConstant(*constantData.value))
-				m_constantSingleValues.emplace(*declOption.optIndex, ToSingleConstantValue(*constantData.value));
+			{
+				ConstantSingleValue defaultValue = ToSingleConstantValue(*constantData.value);
+				// options whose value was required at compile time (const if, array sizes, ...) already have their default value baked in the module
+				bool compileTimeUse = declOption.isCompileTimeUsed || m_context->compileTimeConstants.find(*declOption.optIndex) != m_context->compileTimeConstants.end();
+				if (m_options->keepUnsetScalarOptions && !compileTimeUse && IsSpecializableValue(defaultValue))
+				{
+					// keep the declaration and its identifiers, only its default value is resolved
+					declOption.defaultValue = ShaderBuilder::ConstantValue(std::move(defaultValue), declOption.defaultValue->sourceLocation);
+					return DontVisitChildren{};
+				}
+
+				m_constantSingleValues.emplace(*declOption.optIndex, std::move(defaultValue));
+			}
 		}
 
 		if (m_options->removeOptionDeclaration)
@@ -0,0 +1,62 @@
+// Copyright (C) 2026 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <NZSL/Ast/Transformations/FusedTransformer.hpp>
+#include <cassert>
+
+namespace nzsl::Ast
+{
+	FusedTransformer::~FusedTransformer()
+	{
+		for (Member& member : m_members)
+		{
+			member.transformer->m_flags = member.flags;
+			member.transformer->m_traversalOwner = nullptr;
+		}
+	}
+
+	void FusedTransformer::AddTransformer(Transformer& transformer, NodeTypeFlags transformedNodes)
+	{
+		assert(!transformer.m_traversalOwner);
+		assert(!(m_transformedNodes & transformedNodes));
+
+		for (std::size_t i = 0; i < NodeTypeCount; ++i)
+		{
+			if (transformedNodes.Test(static_cast<NodeType>(i)))
+				m_nodeTransformers[i] = &transformer;
+		}
+
+		// Children are only skipped if every member would skip them
+		if (m_members.empty())
+			m_flags = transformer.m_flags;
+		else
+			m_flags &= transformer.m_flags;
+
+		transformer.m_traversalOwner = this;
+		m_members.push_back({ &transformer, transformer.m_flags });
+		m_transformedNodes |= transformedNodes;
+	}
+
+	bool FusedTransformer::Transform(Module& module, TransformerContext& context, std::string* error)
+	{
+		// Members may handle children themselves, make them visit the same nodes as the owner (their flags are restored on destruction)
+		for (Member& member : m_members)
+			member.transformer->m_flags = m_flags;
+
+		if (!TransformImportedModules(module, context, error))
+			return false;
+
+		return TransformModule(module, context, error);
+	}
+
+#define NZSL_SHADERAST_NODE(Node, Type) \
+	auto FusedTransformer::Transform(Node##Type&& node) -> Type##Transformation \
+	{ \
+		if (Transformer* transformer = m_nodeTransformers[static_cast<std::size_t>(NodeType::Node##Type)]) \
+			return transformer->Transform(std::move(node)); \
+\
+		return VisitChildren{}; \
+	}
+#include <NZSL/Ast/NodeList.hpp>
+}
@@ -44,6 +44,24 @@ namespace nzsl::Ast
 		HandleStatement(statement);
 	}
 
+	std::optional<std::size_t> IndexRemapperTransformer::FindNewIndex(IdentifierType identifierType, std::size_t previousIndex) const
+	{
+		auto it = m_context->newIndices.find({ identifierType, previousIndex });
+		if (it != m_context->newIndices.end())
+			return it->second;
+
+		if (m_context->options->indexLookup)
+			return m_context->options->indexLookup(identifierType, previousIndex);
+
+		return std::nullopt;
+	}
+
+	bool IndexRemapperTransformer::ShouldTransformType(const ExpressionType& /*expressionType*/) const
+	{
+		// Most types hold an index which may be remapped
+		return true;
+	}
+
 	void IndexRemapperTransformer::Transform(ExpressionType& expressionType, const SourceLocation& sourceLocation)
 	{
 		// ArrayType and DynArrayType inner types are handled here
@@ -52,16 +70,14 @@ namespace nzsl::Ast
 		if (IsAliasType(expressionType))
 		{
 			AliasType& aliasType = std::get<AliasType>(expressionType);
-			auto it = m_context->newIndices.find({ IdentifierType::Alias, aliasType.aliasIndex });
-			if (it != m_context->newIndices.end())
-				aliasType.aliasIndex = it->second;
+			if (std::optional<std::size_t> newIndex = FindNewIndex(IdentifierType::Alias, aliasType.aliasIndex))
+				aliasType.aliasIndex = *newIndex;
 		}
 		else if (IsFunctionType(expressionType))
 		{
 			FunctionType& funcType = std::get<FunctionType>(expressionType);
-			auto it = m_context->newIndices.find({ IdentifierType::Function, funcType.funcIndex });
-			if (it != m_context->newIndices.end())
-				funcType.funcIndex = it->second;
+			if (std::optional<std::size_t> newIndex = FindNewIndex(IdentifierType::Function, funcType.funcIndex))
+				funcType.funcIndex = *newIndex;
 		}
 		else if (IsMethodType(expressionType))
 		{
@@ -71,9 +87,8 @@ namespace nzsl::Ast
 		else if (IsPushConstantType(expressionType))
 		{
 			PushConstantType& pushConstantType = std::get<PushConstantType>(expressionType);
-			auto it = m_context->newIndices.find({ IdentifierType::Struct, pushConstantType.containedType.structIndex });
-			if (it != m_context->newIndices.end())
-				pushConstantType.containedType.structIndex = it->second;
+			if (std::optional<std::size_t> newIndex = FindNewIndex(IdentifierType::Struct, pushConstantType.containedType.structIndex))
+				pushConstantType.containedType.structIndex = *newIndex;
 		}
 		else if (IsStorageType(expressionType))
 		{
@@ -83,24 +98,21 @@ namespace nzsl::Ast
 		else if (IsStructType(expressionType))
 		{
 			StructType& structType = std::get<StructType>(expressionType);
-			auto it = m_context->newIndices.find({ IdentifierType::Struct, structType.structIndex });
-			if (it != m_context->newIndices.end())
-				structType.structIndex = it->second;
+			if (std::optional<std::size_t> newIndex = FindNewIndex(IdentifierType::Struct, structType.structIndex))
+				structType.structIndex = *newIndex;
 		}
 		else if (IsUniformType(expressionType))
 		{
 			UniformType& uniformType = std::get<UniformType>(expressionType);
-			auto it = m_context->newIndices.find({ IdentifierType::Struct, uniformType.containedType.structIndex });
-			if (it != m_context->newIndices.end())
-				uniformType.containedType.structIndex = it->second;
+			if (std::optional<std::size_t> newIndex = FindNewIndex(IdentifierType::Struct, uniformType.containedType.structIndex))
+				uniformType.containedType.structIndex = *newIndex;
 		}
 	}
 
 	auto IndexRemapperTransformer::Transform(IdentifierValueExpression&& node) -> ExpressionTransformation
 	{
-		auto it = m_context->newIndices.find({ node.identifierType, node.identifierIndex });
-		if (it != m_context->newIndices.end())
-			node.identifierIndex = it->second;
+		if (std::optional<std::size_t> newIndex = FindNewIndex(node.identifierType, node.identifierIndex))
+			node.identifierIndex = *newIndex;
 
 		return VisitChildren{};
 	}
@@ -355,6 +355,8 @@ namespace nzsl::Ast
 
 		HandleChildren(assignExpr);
 
+		leftExprType = GetResolvedExpressionType(*assignExpr.left); //< may have been resolved by children handling
+
 		ResolveLiteral(assignExpr.right, *leftExprType, assignExpr.sourceLocation);
 
 		return DontVisitChildren{};
@@ -375,6 +377,10 @@ namespace nzsl::Ast
 
 		HandleChildren(binaryExpr);
 
+		// children types may have been resolved
+		leftExprType = GetExpressionType(*binaryExpr.left);
+		rightExprType = GetExpressionType(*binaryExpr.right);
+
 		const ExpressionType& resolvedLeftExprType = ResolveAlias(*leftExprType);
 		const ExpressionType& resolvedRightExprType = ResolveAlias(*rightExprType);
 
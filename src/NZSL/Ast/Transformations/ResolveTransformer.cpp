@@ -3,10 +3,12 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <NZSL/Ast/Transformations/ResolveTransformer.hpp>
+#include <NazaraUtils/Algorithm.hpp>
 #include <NazaraUtils/Bitset.hpp>
 #include <NazaraUtils/CallOnExit.hpp>
 #include <NazaraUtils/StackVector.hpp>
 #include <NZSL/ModuleResolver.hpp>
+#include <NZSL/Parser.hpp>
 #include <NZSL/Ast/Cloner.hpp>
 #include <NZSL/Ast/DependencyCheckerVisitor.hpp>
 #include <NZSL/Ast/ExportVisitor.hpp>
@@ -14,6 +16,7 @@
 #include <NZSL/Ast/Nodes.hpp>
 #include <NZSL/Ast/Option.hpp>
 #include <NZSL/Ast/ReflectVisitor.hpp>
+#include <NZSL/Ast/ResolvedModuleCache.hpp>
 #include <NZSL/Ast/Types.hpp>
 #include <NZSL/Ast/Utils.hpp>
 #include <NZSL/Lang/Constants.hpp>
@@ -48,6 +51,37 @@ namespace nzsl::Ast
 		{
 			using Type = typename ConstantInnerTypeExtractor<T>::Type;
 		};
+
+		struct IndexPairHasher
+		{
+			std::size_t operator()(const std::pair<IdentifierType, std::size_t>& p) const
+			{
+				return Nz::HashCombine(p.first, p.second);
+			}
+		};
+
+		// Shares function bodies with the imported module instead of copying them, they are only copied once resolved (copy-on-write)
+		class SharedBodyCloner : public Cloner
+		{
+			public:
+				SharedBodyCloner(std::shared_ptr<const Module> sourceModule) :
+				m_sourceModule(std::move(sourceModule))
+				{
+				}
+
+			protected:
+				void CloneFunctionBody(DeclareFunctionStatement& node, DeclareFunctionStatement& clone) override
+				{
+					if (node.statements.empty())
+						return Cloner::CloneFunctionBody(node, clone);
+
+					// aliasing constructor, keeps the source module alive
+					clone.sharedBody = std::shared_ptr<const DeclareFunctionStatement>(m_sourceModule, &node);
+				}
+
+			private:
+				std::shared_ptr<const Module> m_sourceModule;
+		};
 	}
 
 	struct ResolveTransformer::Scope
@@ -60,6 +94,9 @@ namespace nzsl::Ast
 		std::shared_ptr<Environment> parentEnv;
 		std::string moduleId;
 		std::vector<TransformerContext::Identifier> identifiersInScope;
+		std::unordered_map<InternedString, std::vector<std::size_t>> identifierIndicesByName; //< indices in identifiersInScope of every identifier with this name, innermost last
+		std::vector<PendingFunction> deferredFunctions; //< imported functions whose body is only parsed and resolved if they're used
+		std::unordered_map<std::pair<IdentifierType, std::size_t>, std::size_t, NAZARA_ANONYMOUS_NAMESPACE_PREFIX(IndexPairHasher)> importedIndices; //< indices of the imported module to their remapped value
 		std::vector<PendingFunction> pendingFunctions;
 		std::vector<Scope> scopes;
 	};
@@ -98,6 +135,7 @@ namespace nzsl::Ast
 		std::size_t currentModuleId;
 		std::unordered_map<std::string, std::size_t> moduleByName;
 		std::unordered_map<std::string, UsedExternalData> declaredExternalVar;
+		std::vector<DeclareOptionStatement*> declaredOptions;
 		std::vector<ModuleData> modules;
 		std::vector<NamedExternalBlock> namedExternalBlocks;
 		Module* currentModule;
@@ -165,6 +203,14 @@ namespace nzsl::Ast
 		return TransformModule(module, context, error, [&]
 		{
 			ResolveFunctions();
+			ResolveDeferredFunctions();
+
+			// Remember which options had their value used at compile time, as those uses are gone once resolved
+			for (DeclareOptionStatement* declOption : m_states->declaredOptions)
+			{
+				if (m_context->compileTimeConstants.find(*declOption->optIndex) != m_context->compileTimeConstants.end())
+					declOption->isCompileTimeUsed = true;
+			}
 
 			// Remove unused statements of imported modules
 			for (std::size_t moduleId = 0; moduleId < module.importedModules.size(); ++moduleId)
@@ -354,44 +400,45 @@ namespace nzsl::Ast
 	}
 
 	auto ResolveTransformer::FindIdentifier(std::string_view identifierName) const -> const TransformerContext::IdentifierData*
+	{
+		return FindIdentifier(*m_states->currentEnv, InternedString(identifierName));
+	}
+
+	auto ResolveTransformer::FindIdentifier(const InternedString& identifierName) const -> const TransformerContext::IdentifierData*
 	{
 		return FindIdentifier(*m_states->currentEnv, identifierName);
 	}
 
 	template<typename F>
-	auto ResolveTransformer::FindIdentifier(std::string_view identifierName, F&& functor) const -> const TransformerContext::IdentifierData*
+	auto ResolveTransformer::FindIdentifier(const InternedString& identifierName, F&& functor) const -> const TransformerContext::IdentifierData*
 	{
 		return FindIdentifier(*m_states->currentEnv, identifierName, std::forward<F>(functor));
 	}
 
-	auto ResolveTransformer::FindIdentifier(const Environment& environment, std::string_view identifierName) const -> const TransformerContext::IdentifierData*
+	auto ResolveTransformer::FindIdentifier(const Environment& environment, const InternedString& identifierName) const -> const TransformerContext::IdentifierData*
 	{
 		return FindIdentifier(environment, identifierName, [](const TransformerContext::IdentifierData& /*identifierData*/) { return true; });
 	}
 
 	template<typename F>
-	auto ResolveTransformer::FindIdentifier(const Environment& environment, std::string_view identifierName, F&& functor) const -> const TransformerContext::IdentifierData*
+	auto ResolveTransformer::FindIdentifier(const Environment& environment, const InternedString& identifierName, F&& functor) const -> const TransformerContext::IdentifierData*
 	{
-		auto it = std::find_if(environment.identifiersInScope.rbegin(), environment.identifiersInScope.rend(), [&](const TransformerContext::Identifier& identifier)
+		if (auto it = environment.identifierIndicesByName.find(identifierName); it != environment.identifierIndicesByName.end())
 		{
-			if (identifier.name == identifierName)
+			// Innermost identifiers are at the back
+			const std::vector<std::size_t>& identifierIndices = it->second;
+			for (auto indexIt = identifierIndices.rbegin(); indexIt != identifierIndices.rend(); ++indexIt)
 			{
+				const TransformerContext::Identifier& identifier = environment.identifiersInScope[*indexIt];
 				if (functor(identifier.target))
-					return true;
+					return &identifier.target;
 			}
-
-			return false;
-		});
-
-		if (it == environment.identifiersInScope.rend())
-		{
-			if (environment.parentEnv)
-				return FindIdentifier(*environment.parentEnv, identifierName, std::forward<F>(functor));
-			else
-				return nullptr;
 		}
 
-		return &it->target;
+		if (environment.parentEnv)
+			return FindIdentifier(*environment.parentEnv, identifierName, std::forward<F>(functor));
+		else
+			return nullptr;
 	}
 
 	ExpressionPtr ResolveTransformer::HandleIdentifier(const TransformerContext::IdentifierData* identifierData, const SourceLocation& sourceLocation)
@@ -442,7 +489,7 @@ namespace nzsl::Ast
 
 			case IdentifierType::Variable:
 			{
-				const ExpressionType& variableExprType = m_context->variables.Retrieve(identifierData->index, sourceLocation).type;
+				const InternedType& variableExprType = m_context->variables.Retrieve(identifierData->index, sourceLocation).type;
 				return ShaderBuilder::Variable(identifierData->index, variableExprType, sourceLocation);
 			}
 
@@ -463,15 +510,23 @@ namespace nzsl::Ast
 		if (allowReserved)
 			return FindIdentifier(identifier) == nullptr;
 		else
-			return FindIdentifier(identifier, [](const TransformerContext::IdentifierData&) { return true; }) == nullptr;
+			return FindIdentifier(InternedString(identifier), [](const TransformerContext::IdentifierData&) { return true; }) == nullptr;
 	}
 
 	void ResolveTransformer::PopScope()
 	{
 		assert(!m_states->currentEnv->scopes.empty());
-		auto& scope = m_states->currentEnv->scopes.back();
-		m_states->currentEnv->identifiersInScope.resize(scope.previousSize);
-		m_states->currentEnv->scopes.pop_back();
+		Environment& environment = *m_states->currentEnv;
+		auto& scope = environment.scopes.back();
+		for (std::size_t i = environment.identifiersInScope.size(); i > scope.previousSize; --i)
+		{
+			auto it = environment.identifierIndicesByName.find(environment.identifiersInScope[i - 1].name);
+			assert(it != environment.identifierIndicesByName.end() && it->second.back() == i - 1);
+			it->second.pop_back();
+		}
+
+		environment.identifiersInScope.resize(scope.previousSize);
+		environment.scopes.pop_back();
 	}
 
 	void ResolveTransformer::PushScope()
@@ -504,13 +559,10 @@ namespace nzsl::Ast
 
 		if (!unresolved)
 		{
-			m_states->currentEnv->identifiersInScope.push_back({
-				std::move(name),
-				{
-					aliasIndex,
-					IdentifierType::Alias,
-					m_states->currentConditionalIndex
-				}
+			RegisterIdentifier(InternedString(name), {
+				aliasIndex,
+				IdentifierType::Alias,
+				m_states->currentConditionalIndex
 			});
 		}
 		else
@@ -1011,13 +1063,10 @@ namespace nzsl::Ast
 		else
 			constantIndex = m_context->constants.RegisterNewIndex(true);
 
-		m_states->currentEnv->identifiersInScope.push_back({
-			std::move(name),
-			{
-				constantIndex,
-				IdentifierType::Constant,
-				m_states->currentConditionalIndex
-			}
+		RegisterIdentifier(InternedString(name), {
+			constantIndex,
+			IdentifierType::Constant,
+			m_states->currentConditionalIndex
 		});
 
 		return constantIndex;
@@ -1030,13 +1079,10 @@ namespace nzsl::Ast
 
 		std::size_t externalBlockIndex = m_context->namedExternalBlocks.Register(std::move(namedExternalBlock), index, {});
 
-		m_states->currentEnv->identifiersInScope.push_back({
-			std::move(name),
-			{
-				externalBlockIndex,
-				IdentifierType::ExternalBlock,
-				m_states->currentConditionalIndex
-			}
+		RegisterIdentifier(InternedString(name), {
+			externalBlockIndex,
+			IdentifierType::ExternalBlock,
+			m_states->currentConditionalIndex
 		});
 
 		return externalBlockIndex;
@@ -1073,13 +1119,10 @@ namespace nzsl::Ast
 
 		std::size_t functionIndex = m_context->functions.Register(*funcData, index, sourceLocation);
 
-		m_states->currentEnv->identifiersInScope.push_back({
-			std::move(name),
-			{
-				functionIndex,
-				IdentifierType::Function,
-				m_states->currentConditionalIndex
-			}
+		RegisterIdentifier(InternedString(name), {
+			functionIndex,
+			IdentifierType::Function,
+			m_states->currentConditionalIndex
 		});
 
 		return functionIndex;
@@ -1092,13 +1135,10 @@ namespace nzsl::Ast
 
 		std::size_t intrinsicIndex = m_context->intrinsics.Register(std::move(intrinsicData), index, sourceLocation);
 
-		m_states->currentEnv->identifiersInScope.push_back({
-			std::move(name),
-			{
-				intrinsicIndex,
-				IdentifierType::Intrinsic,
-				m_states->currentConditionalIndex
-			}
+		RegisterIdentifier(InternedString(name), {
+			intrinsicIndex,
+			IdentifierType::Intrinsic,
+			m_states->currentConditionalIndex
 		});
 
 		return intrinsicIndex;
@@ -1111,13 +1151,10 @@ namespace nzsl::Ast
 
 		std::size_t moduleIndex = m_context->modules.Register(std::move(moduleData), index, sourceLocation);
 
-		m_states->currentEnv->identifiersInScope.push_back({
-			std::move(moduleIdentifier),
-			{
-				moduleIndex,
-				IdentifierType::Module,
-				m_states->currentConditionalIndex
-			}
+		RegisterIdentifier(InternedString(moduleIdentifier), {
+			moduleIndex,
+			IdentifierType::Module,
+			m_states->currentConditionalIndex
 		});
 
 		return moduleIndex;
@@ -1147,13 +1184,10 @@ namespace nzsl::Ast
 
 		if (!unresolved)
 		{
-			m_states->currentEnv->identifiersInScope.push_back({
-				std::move(name),
-				{
-					structIndex,
-					IdentifierType::Struct,
-					m_states->currentConditionalIndex
-				}
+			RegisterIdentifier(InternedString(name), {
+				structIndex,
+				IdentifierType::Struct,
+				m_states->currentConditionalIndex
 			});
 		}
 		else
@@ -1178,27 +1212,28 @@ namespace nzsl::Ast
 		else
 			typeIndex = m_context->types.RegisterNewIndex(true);
 
-		m_states->currentEnv->identifiersInScope.push_back({
-			std::move(name),
-			{
-				typeIndex,
-				IdentifierType::Type,
-				m_states->currentConditionalIndex
-			}
+		RegisterIdentifier(InternedString(name), {
+			typeIndex,
+			IdentifierType::Type,
+			m_states->currentConditionalIndex
 		});
 
 		return typeIndex;
 	}
 
+	void ResolveTransformer::RegisterIdentifier(InternedString name, const TransformerContext::IdentifierData& identifierData)
+	{
+		Environment& environment = *m_states->currentEnv;
+		environment.identifierIndicesByName[name].push_back(environment.identifiersInScope.size());
+		environment.identifiersInScope.push_back({ std::move(name), identifierData });
+	}
+
 	void ResolveTransformer::RegisterUnresolved(std::string name)
 	{
-		m_states->currentEnv->identifiersInScope.push_back({
-			std::move(name),
-			{
-				std::numeric_limits<std::size_t>::max(),
-				IdentifierType::Unresolved,
-				m_states->currentConditionalIndex
-			}
+		RegisterIdentifier(InternedString(name), {
+			std::numeric_limits<std::size_t>::max(),
+			IdentifierType::Unresolved,
+			m_states->currentConditionalIndex
 		});
 	}
 
@@ -1227,13 +1262,10 @@ namespace nzsl::Ast
 
 		if (!unresolved)
 		{
-			m_states->currentEnv->identifiersInScope.push_back({
-				std::move(name),
-				{
-					varIndex,
-					IdentifierType::Variable,
-					m_states->currentConditionalIndex
-				}
+			RegisterIdentifier(InternedString(name), {
+				varIndex,
+				IdentifierType::Variable,
+				m_states->currentConditionalIndex
 			});
 		}
 		else
@@ -1271,29 +1303,135 @@ namespace nzsl::Ast
 		return identifier;
 	}
 
-	void ResolveTransformer::ResolveFunctions()
+	void ResolveTransformer::RemapImportedIndices(StatementPtr& statement, Environment& moduleEnvironment)
 	{
-		// Once every function is known, we can evaluate function content
-		for (auto& pendingFunc : m_states->currentEnv->pendingFunctions)
+		IndexRemapperTransformer::Options indexCallbacks;
+		indexCallbacks.indexGenerator = [&](IdentifierType identifierType, std::size_t previousIndex)
 		{
-			PushScope();
+			std::size_t newIndex;
+			switch (identifierType)
+			{
+				case IdentifierType::Alias:    newIndex = m_context->aliases.RegisterNewIndex(true); break;
+				case IdentifierType::Constant: newIndex = m_context->constants.RegisterNewIndex(true); break;
+				case IdentifierType::Function: newIndex = m_context->functions.RegisterNewIndex(true); break;
+				case IdentifierType::Struct:   newIndex = m_context->structs.RegisterNewIndex(true); break;
+				case IdentifierType::Variable: newIndex = m_context->variables.RegisterNewIndex(true); break;
+
+				default:
+					throw std::runtime_error("unexpected identifier type");
+			}
 
-			for (auto& parameter : pendingFunc.node->parameters)
+			// Keep track of remapped indices for function bodies which are copied later
+			moduleEnvironment.importedIndices[{ identifierType, previousIndex }] = newIndex;
+			return newIndex;
+		};
+
+		indexCallbacks.indexLookup = [&](IdentifierType identifierType, std::size_t previousIndex) -> std::optional<std::size_t>
+		{
+			auto it = moduleEnvironment.importedIndices.find({ identifierType, previousIndex });
+			if (it == moduleEnvironment.importedIndices.end())
+				return std::nullopt;
+
+			return it->second;
+		};
+
+		RemapIndices(statement, indexCallbacks);
+	}
+
+	void ResolveTransformer::ResolveDeferredFunctions()
+	{
+		// Resolving a function body can make other functions used, loop until no deferred function is used
+		bool resolvedFunction;
+		do
+		{
+			resolvedFunction = false;
+			for (auto& moduleData : m_states->modules)
 			{
-				if (!m_context->partialCompilation || parameter.type.IsResultingValue())
-					parameter.varIndex = RegisterVariable(parameter.name, TransformerContext::VariableData{ parameter.type.GetResultingValue() }, parameter.varIndex, parameter.sourceLocation);
-				else
-					RegisterUnresolved(parameter.name);
+				if (!moduleData.dependenciesVisitor || moduleData.environment->deferredFunctions.empty())
+					continue;
+
+				moduleData.dependenciesVisitor->Resolve(true); //< allow unknown identifiers since we may be referencing other modules
+				const auto& usage = moduleData.dependenciesVisitor->GetUsage();
+
+				auto& deferredFunctions = moduleData.environment->deferredFunctions;
+				for (auto it = deferredFunctions.begin(); it != deferredFunctions.end();)
+				{
+					DeclareFunctionStatement& func = *it->node;
+					if (!usage.usedFunctions.UnboundedTest(*func.funcIndex))
+					{
+						++it;
+						continue;
+					}
+
+					const TransformerContext::FunctionData& funcData = m_context->functions.Retrieve(*func.funcIndex, func.sourceLocation);
+
+					m_states->currentEnv = moduleData.environment;
+					m_states->currentModuleId = funcData.moduleIndex;
+
+					ResolveFunctionBody(func);
+					moduleData.dependenciesVisitor->UpdateFunction(func);
+
+					it = deferredFunctions.erase(it);
+					resolvedFunction = true;
+				}
 			}
+		}
+		while (resolvedFunction);
+
+		m_states->currentEnv = m_states->moduleEnv;
+		m_states->currentModuleId = States::MainModule;
+	}
+
+	void ResolveTransformer::ResolveFunctionBody(DeclareFunctionStatement& func)
+	{
+		if (func.sharedBody)
+		{
+			// Resolving modifies statements, copy them from the imported module
+			std::shared_ptr<const DeclareFunctionStatement> sharedFunc = std::move(func.sharedBody);
+
+			MultiStatementPtr body = ShaderBuilder::MultiStatement();
+			body->statements.reserve(sharedFunc->statements.size());
+			for (const auto& statement : sharedFunc->statements)
+				body->statements.push_back(Ast::Clone(*statement));
+
+			StatementPtr bodyStatement = std::move(body);
+			RemapImportedIndices(bodyStatement, *m_states->currentEnv);
+
+			func.statements = std::move(Nz::SafeCast<MultiStatement&>(*bodyStatement).statements);
+		}
+		else
+			ParseDeferredFunctionBody(func);
+
+		PushScope();
+
+		for (auto& parameter : func.parameters)
+		{
+			if (!m_context->partialCompilation || parameter.type.IsResultingValue())
+				parameter.varIndex = RegisterVariable(parameter.name, TransformerContext::VariableData{ parameter.type.GetResultingValue() }, parameter.varIndex, parameter.sourceLocation);
+			else
+				RegisterUnresolved(parameter.name);
+		}
 
-			std::size_t funcIndex = *pendingFunc.node->funcIndex;
+		HandleStatementList<false>(func.statements, [&](StatementPtr& statement)
+		{
+			HandleStatement(statement);
+		});
+		PopScope();
+	}
 
-			TransformerContext::FunctionData& funcData = m_context->functions.Retrieve(funcIndex, pendingFunc.node->sourceLocation);
-			HandleStatementList<false>(funcData.node->statements, [&](StatementPtr& statement)
+	void ResolveTransformer::ResolveFunctions()
+	{
+		// Once every function is known, we can evaluate function content
+		for (auto& pendingFunc : m_states->currentEnv->pendingFunctions)
+		{
+			// Bodies of imported functions are only parsed or copied and resolved once we know they are used (see ResolveDeferredFunctions)
+			if ((pendingFunc.node->deferredBody || pendingFunc.node->sharedBody) && m_states->currentEnv != m_states->moduleEnv && !m_context->partialCompilation)
 			{
-				HandleStatement(statement);
-			});
-			PopScope();
+				m_states->currentEnv->deferredFunctions.push_back(pendingFunc);
+				continue;
+			}
+
+			ResolveFunctionBody(*pendingFunc.node);
 		}
 	}
 
@@ -1343,11 +1481,11 @@ namespace nzsl::Ast
 		ExpressionPtr& expression = exprTypeValue.GetExpression();
 		HandleExpression(expression);
 
-		const ExpressionType* exprType = GetExpressionType(*expression);
-		if (!exprType)
+		if (!expression->cachedExpressionType)
 			return std::nullopt;
 
-		Transform(*expression->cachedExpressionType, expression->sourceLocation);
+		Transform(expression->cachedExpressionType, expression->sourceLocation);
+		const ExpressionType* exprType = GetExpressionType(*expression);
 
 		//if (!IsTypeType(exprType))
 		//  throw AstError{ "type expected" };
@@ -1383,7 +1521,7 @@ namespace nzsl::Ast
 		for (std::size_t i = 0; i < accessIdentifier.identifiers.size(); ++i)
 		{
 			const auto& identifierEntry = accessIdentifier.identifiers[i];
-			if (identifierEntry.identifier.empty())
+			if (identifierEntry.identifier.IsEmpty())
 				throw AstEmptyIdentifierError{ identifierEntry.sourceLocation };
 
 			const ExpressionType* exprType = GetExpressionType(*indexedExpr);
@@ -1544,7 +1682,7 @@ namespace nzsl::Ast
 			else if (IsPrimitiveType(resolvedType) || IsVectorType(resolvedType))
 			{
 				// Swizzle expression
-				std::size_t swizzleComponentCount = identifierEntry.identifier.size();
+				std::size_t swizzleComponentCount = identifierEntry.identifier.GetString().size();
 				if (swizzleComponentCount > 4)
 					throw CompilerInvalidSwizzleError{ identifierEntry.sourceLocation };
 
@@ -1554,7 +1692,7 @@ namespace nzsl::Ast
 
 				swizzle->componentCount = swizzleComponentCount;
 				for (std::size_t j = 0; j < swizzleComponentCount; ++j)
-					swizzle->components[j] = ToSwizzleIndex(identifierEntry.identifier[j], identifierEntry.sourceLocation);
+					swizzle->components[j] = ToSwizzleIndex(identifierEntry.identifier.GetString()[j], identifierEntry.sourceLocation);
 
 				swizzle->cachedExpressionType = ComputeSwizzleType(resolvedType, swizzleComponentCount, identifierEntry.sourceLocation);
 
@@ -2506,7 +2644,7 @@ namespace nzsl::Ast
 		const ExpressionType& resolvedType = ResolveAlias(*exprType);
 
 		TransformerContext::AliasData aliasIdentifier;
-		aliasIdentifier.identifier.name = declAlias.name;
+		aliasIdentifier.identifier.name = InternedString(declAlias.name);
 
 		if (IsStructType(resolvedType))
 		{
@@ -2854,6 +2992,8 @@ namespace nzsl::Ast
 
 		declOption.optType = std::move(resolvedType);
 
+		m_states->declaredOptions.push_back(&declOption);
+
 		return DontVisitChildren{};
 	}
 
@@ -3098,6 +3238,8 @@ namespace nzsl::Ast
 
 	auto ResolveTransformer::Transform(ImportStatement&& importStatement) -> StatementTransformation
 	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
 		tsl::ordered_map<std::string, std::vector<std::string>> importedSymbols;
 		bool importEverythingElse = false;
 		for (const auto& entry : importStatement.identifiers)
@@ -3206,27 +3348,20 @@ namespace nzsl::Ast
 			m_states->currentEnv = moduleEnvironment;
 
 			ModulePtr moduleClone = std::make_shared<Module>(targetModule->metadata);
-			moduleClone->rootNode = Nz::StaticUniquePointerCast<MultiStatement>(Ast::Clone(*targetModule->rootNode));
 
-			// Remap already used indices
-			IndexRemapperTransformer::Options indexCallbacks;
-			indexCallbacks.indexGenerator = [this](IdentifierType identifierType, std::size_t /*previousIndex*/)
-			{
-				switch (identifierType)
-				{
-					case IdentifierType::Alias:    return m_context->aliases.RegisterNewIndex(true);
-					case IdentifierType::Constant: return m_context->constants.RegisterNewIndex(true);
-					case IdentifierType::Function: return m_context->functions.RegisterNewIndex(true);
-					case IdentifierType::Struct:   return m_context->structs.RegisterNewIndex(true);
-					case IdentifierType::Variable: return m_context->variables.RegisterNewIndex(true);
+			// Start from the pre-resolved form of the module if available, its indices are relocated just like the ones of a parsed module
+			std::shared_ptr<const Module> sourceModule;
+			if (m_options->resolvedModuleCache)
+				sourceModule = m_options->resolvedModuleCache->Retrieve(targetModule, m_options->moduleResolver->GetModuleVersion(importStatement.moduleName));
 
-					default:
-						throw std::runtime_error("unexpected identifier type");
-				}
-			};
+			if (!sourceModule)
+				sourceModule = targetModule;
+
+			SharedBodyCloner cloner(sourceModule);
+			StatementPtr rootNode = cloner.Clone(*sourceModule->rootNode);
 
-			StatementPtr rootNode = std::move(moduleClone->rootNode);
-			RemapIndices(rootNode, indexCallbacks);
+			// Remap already used indices
+			RemapImportedIndices(rootNode, *moduleEnvironment);
 			moduleClone->rootNode = Nz::StaticUniquePointerCast<MultiStatement>(std::move(rootNode));
 
 			std::string error;
@@ -3430,6 +3565,12 @@ namespace nzsl::Ast
 		return ReplaceStatement{ std::move(aliasBlock) };
 	}
 
+	bool ResolveTransformer::ShouldTransformType(const ExpressionType& expressionType) const
+	{
+		// Used structs and functions are marked as such, see below
+		return Transformer::ShouldTransformType(expressionType) || IsStructAddressible(expressionType) || IsFunctionType(expressionType);
+	}
+
 	void ResolveTransformer::Transform(ExpressionType& expressionType, const SourceLocation& sourceLocation)
 	{
 		Transformer::Transform(expressionType, sourceLocation);
@@ -14,6 +14,9 @@ namespace nzsl::Ast
 {
 	void Transformer::AppendStatement(StatementPtr statement)
 	{
+		if (m_traversalOwner)
+			return m_traversalOwner->AppendStatement(std::move(statement));
+
 		m_currentStatementList->insert(m_currentStatementList->begin() + m_currentStatementListIndex, std::move(statement));
 		m_currentStatementListIndex++;
 	}
@@ -69,7 +72,7 @@ namespace nzsl::Ast
 	std::optional<ConstantValue> Transformer::ComputeConstantValue(ExpressionPtr& expr) const
 	{
 		// Run optimizer on constant value to hopefully retrieve a single constant value
-		PropagateConstants(expr);
+		PropagateConstants(expr, true);
 
 		if (expr->GetType() == NodeType::ConstantValueExpression)
 			return ToConstantValue(static_cast<ConstantValueExpression&>(*expr).value);
@@ -107,7 +110,7 @@ namespace nzsl::Ast
 
 	DeclareVariableStatement* Transformer::DeclareVariable(std::string_view name, Ast::ExpressionType type, SourceLocation sourceLocation)
 	{
-		assert(m_currentStatementList);
+		assert(m_traversalOwner || m_currentStatementList);
 
 		auto variableDeclaration = ShaderBuilder::DeclareVariable(fmt::format("_nzsl_{}", name), nullptr);
 		variableDeclaration->sourceLocation = std::move(sourceLocation);
@@ -126,12 +129,18 @@ namespace nzsl::Ast
 
 	ExpressionPtr& Transformer::GetCurrentExpressionPtr()
 	{
+		if (m_traversalOwner)
+			return m_traversalOwner->GetCurrentExpressionPtr();
+
 		assert(!m_expressionStack.empty());
 		return *m_expressionStack.back();
 	}
 
 	StatementPtr& Transformer::GetCurrentStatementPtr()
 	{
+		if (m_traversalOwner)
+			return m_traversalOwner->GetCurrentStatementPtr();
+
 		assert(!m_statementStack.empty());
 		return *m_statementStack.back();
 	}
@@ -175,8 +184,14 @@ namespace nzsl::Ast
 	{
 		assert(expression);
 
+		if (m_traversalOwner)
+			return m_traversalOwner->HandleExpression(expression);
+
+		if (m_context)
+			m_context->visitedNodeCount++;
+
 		m_expressionStack.push_back(&expression);
-		expression->Visit(*this);
+		Dispatch(*expression);
 		m_expressionStack.pop_back();
 	}
 
@@ -184,8 +199,14 @@ namespace nzsl::Ast
 	{
 		assert(statement);
 
+		if (m_traversalOwner)
+			return m_traversalOwner->HandleStatement(statement);
+
+		if (m_context)
+			m_context->visitedNodeCount++;
+
 		m_statementStack.push_back(&statement);
-		statement->Visit(*this);
+		Dispatch(*statement);
 		m_statementStack.pop_back();
 	}
 
@@ -193,14 +214,14 @@ namespace nzsl::Ast
 	{
 		HandleExpression(node.expr);
 		if (node.cachedExpressionType)
-			Transform(*node.cachedExpressionType, node.sourceLocation);
+			Transform(node.cachedExpressionType, node.sourceLocation);
 	}
 
 	void Transformer::HandleChildren(AccessIdentifierExpression& node)
 	{
 		HandleExpression(node.expr);
 		if (node.cachedExpressionType)
-			Transform(*node.cachedExpressionType, node.sourceLocation);
+			Transform(node.cachedExpressionType, node.sourceLocation);
 	}
 
 	void Transformer::HandleChildren(AccessIndexExpression& node)
@@ -210,7 +231,7 @@ namespace nzsl::Ast
 			HandleExpression(index);
 
 		if (node.cachedExpressionType)
-			Transform(*node.cachedExpressionType, node.sourceLocation);
+			Transform(node.cachedExpressionType, node.sourceLocation);
 	}
 
 	void Transformer::HandleChildren(AssignExpression& node)
@@ -219,7 +240,7 @@ namespace nzsl::Ast
 		HandleExpression(node.right);
 
 		if (node.cachedExpressionType)
-			Transform(*node.cachedExpressionType, node.sourceLocation);
+			Transform(node.cachedExpressionType, node.sourceLocation);
 	}
 
 	void Transformer::HandleChildren(BinaryExpression& node)
@@ -228,7 +249,7 @@ namespace nzsl::Ast
 		HandleExpression(node.right);
 
 		if (node.cachedExpressionType)
-			Transform(*node.cachedExpressionType, node.sourceLocation);
+			Transform(node.cachedExpressionType, node.sourceLocation);
 	}
 
 	void Transformer::HandleChildren(CallFunctionExpression& node)
@@ -239,7 +260,7 @@ namespace nzsl::Ast
 			HandleExpression(param.expr);
 
 		if (node.cachedExpressionType)
-			Transform(*node.cachedExpressionType, node.sourceLocation);
+			Transform(node.cachedExpressionType, node.sourceLocation);
 	}
 
 	void Transformer::HandleChildren(CallMethodExpression& node)
@@ -250,7 +271,7 @@ namespace nzsl::Ast
 			HandleExpression(param);
 
 		if (node.cachedExpressionType)
-			Transform(*node.cachedExpressionType, node.sourceLocation);
+			Transform(node.cachedExpressionType, node.sourceLocation);
 	}
 
 	void Transformer::HandleChildren(CastExpression& node)
@@ -262,7 +283,7 @@ namespace nzsl::Ast
 			HandleExpression(expr);
 
 		if (node.cachedExpressionType)
-			Transform(*node.cachedExpressionType, node.sourceLocation);
+			Transform(node.cachedExpressionType, node.sourceLocation);
 	}
 
 	void Transformer::HandleChildren(ConditionalExpression& node)
@@ -284,31 +305,31 @@ namespace nzsl::Ast
 		}
 
 		if (node.cachedExpressionType)
-			Transform(*node.cachedExpressionType, node.sourceLocation);
+			Transform(node.cachedExpressionType, node.sourceLocation);
 	}
 
 	void Transformer::HandleChildren(ConstantArrayValueExpression& node)
 	{
 		if (node.cachedExpressionType)
-			Transform(*node.cachedExpressionType, node.sourceLocation);
+			Transform(node.cachedExpressionType, node.sourceLocation);
 	}
 
 	void Transformer::HandleChildren(ConstantValueExpression& node)
 	{
 		if (node.cachedExpressionType)
-			Transform(*node.cachedExpressionType, node.sourceLocation);
+			Transform(node.cachedExpressionType, node.sourceLocation);
 	}
 
 	void Transformer::HandleChildren(IdentifierExpression& node)
 	{
 		if (node.cachedExpressionType)
-			Transform(*node.cachedExpressionType, node.sourceLocation);
+			Transform(node.cachedExpressionType, node.sourceLocation);
 	}
 
 	void Transformer::HandleChildren(IdentifierValueExpression& node)
 	{
 		if (node.cachedExpressionType)
-			Transform(*node.cachedExpressionType, node.sourceLocation);
+			Transform(node.cachedExpressionType, node.sourceLocation);
 	}
 
 	void Transformer::HandleChildren(IntrinsicExpression& node)
@@ -317,7 +338,7 @@ namespace nzsl::Ast
 			HandleExpression(param);
 
 		if (node.cachedExpressionType)
-			Transform(*node.cachedExpressionType, node.sourceLocation);
+			Transform(node.cachedExpressionType, node.sourceLocation);
 	}
 
 	void Transformer::HandleChildren(SwizzleExpression& node)
@@ -326,7 +347,7 @@ namespace nzsl::Ast
 			HandleExpression(node.expression);
 
 		if (node.cachedExpressionType)
-			Transform(*node.cachedExpressionType, node.sourceLocation);
+			Transform(node.cachedExpressionType, node.sourceLocation);
 	}
 
 	void Transformer::HandleChildren(TypeConstantExpression& node)
@@ -334,7 +355,7 @@ namespace nzsl::Ast
 		Transform(node.type, node.sourceLocation);
 
 		if (node.cachedExpressionType)
-			Transform(*node.cachedExpressionType, node.sourceLocation);
+			Transform(node.cachedExpressionType, node.sourceLocation);
 	}
 
 	void Transformer::HandleChildren(UnaryExpression& node)
@@ -343,7 +364,7 @@ namespace nzsl::Ast
 			HandleExpression(node.expression);
 
 		if (node.cachedExpressionType)
-			Transform(*node.cachedExpressionType, node.sourceLocation);
+			Transform(node.cachedExpressionType, node.sourceLocation);
 	}
 
 	void Transformer::HandleChildren(BranchStatement& node)
@@ -642,13 +663,17 @@ namespace nzsl::Ast
 	{
 	}
 
-	void Transformer::PropagateConstants(ExpressionPtr& expr) const
+	void Transformer::PropagateConstants(ExpressionPtr& expr, bool compileTimeUse) const
 	{
 		// Run optimizer on constant value to hopefully retrieve a single constant value
 
 		ConstantPropagationTransformer::Options optimizerOptions;
 		optimizerOptions.constantQueryCallback = [&](std::size_t constantId) -> const ConstantValue*
 		{
+			// in partial compilation the value may be unknown yet, the constant still has to be known at compile time
+			if (compileTimeUse)
+				m_context->compileTimeConstants.insert(constantId);
+
 			const TransformerContext::ConstantData* constantData = m_context->constants.TryRetrieve(constantId, expr->sourceLocation);
 			if (!constantData || !constantData->value)
 			{
@@ -696,6 +721,28 @@ namespace nzsl::Ast
 			Transform(expressionValue.GetResultingValue(), sourceLocation);
 	}
 
+	void Transformer::Transform(InternedType& type, const SourceLocation& sourceLocation)
+	{
+		if (!type)
+			return;
+
+		if (!ShouldTransformType(*type))
+			return;
+
+		// The copy is only interned again (which hashes it) if it was changed
+		ExpressionType expressionType = *type;
+		Transform(expressionType, sourceLocation);
+
+		if (expressionType != *type)
+			type = std::move(expressionType);
+	}
+
+	bool Transformer::ShouldTransformType(const ExpressionType& expressionType) const
+	{
+		// Transform(ExpressionType&) only goes through the inner types of those
+		return IsAliasType(expressionType) || IsArrayType(expressionType) || IsDynArrayType(expressionType);
+	}
+
 	bool Transformer::TransformExpression(ExpressionPtr& expression, TransformerContext& context, std::string* error)
 	{
 		m_context = &context;
@@ -731,6 +778,12 @@ namespace nzsl::Ast
 	{
 		m_context = &context;
 
+		// The module will be traversed by the owner, running this transformer only sets it up
+		if (m_traversalOwner)
+			return true;
+
+		NodeArena::Scope arenaScope(module.arena);
+
 		try
 		{
 			StatementPtr root = std::move(module.rootNode);
@@ -782,6 +835,7 @@ namespace nzsl::Ast
 			[this](ReplaceExpression& expr)
 			{
 				GetCurrentExpressionPtr() = std::move(expr.expression);
+				m_context->replacedNodeCount++;
 				return false;
 			}
 		}, transformation);
@@ -797,11 +851,13 @@ namespace nzsl::Ast
 			[this](RemoveStatement& /*stmt*/)
 			{
 				GetCurrentStatementPtr() = ShaderBuilder::NoOp();
+				m_context->replacedNodeCount++;
 				return false;
 			},
 			[this](ReplaceStatement& stmt)
 			{
 				GetCurrentStatementPtr() = std::move(stmt.statement);
+				m_context->replacedNodeCount++;
 				return false;
 			}
 		}, transformation);
@@ -31,6 +31,9 @@ namespace nzsl::Ast
 		structs.Clear();
 		types.Clear();
 		variables.Clear();
+		compileTimeConstants.clear();
+		replacedNodeCount = 0;
+		visitedNodeCount = 0;
 		allowUnknownIdentifiers = false;
 		partialCompilation = false;
 	}
@@ -1470,6 +1470,11 @@ namespace nzsl::Ast
 		return DontVisitChildren{};
 	}
 
+	bool ValidationTransformer::ShouldTransformType(const ExpressionType& expressionType) const
+	{
+		return Transformer::ShouldTransformType(expressionType) || IsLiteralType(expressionType);
+	}
+
 	void ValidationTransformer::Transform(ExpressionType& expressionType, const SourceLocation& sourceLocation)
 	{
 		Transformer::Transform(expressionType, sourceLocation);
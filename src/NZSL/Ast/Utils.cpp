@@ -5,6 +5,8 @@
 #include <NZSL/Ast/Utils.hpp>
 #include <NZSL/Lang/Errors.hpp>
 #include <NZSL/Lang/LangData.hpp>
+#include <NZSL/Ast/Module.hpp>
+#include <NZSL/Ast/StaticRecursiveVisitor.hpp>
 #include <fmt/format.h>
 #include <cassert>
 
@@ -169,6 +171,149 @@ namespace nzsl::Ast
 
 				ExpressionCategory m_expressionCategory;
 		};
+
+		// Gathers the type of every node a transformer could visit (including expressions used as attribute or type values)
+		// along with their traits, which are assumed present while types or attributes are unresolved
+		class NodeTypeGatherer final : public StaticRecursiveVisitor<NodeTypeGatherer>
+		{
+			public:
+				using StaticRecursiveVisitor::Visit;
+
+				void Dispatch(Expression& node)
+				{
+					nodeTypes |= node.GetType();
+					StaticRecursiveVisitor::Dispatch(node);
+				}
+
+				void Dispatch(Statement& node)
+				{
+					nodeTypes |= node.GetType();
+					StaticRecursiveVisitor::Dispatch(node);
+				}
+
+				void Visit(BinaryExpression& node)
+				{
+					if ((node.op == BinaryType::Add || node.op == BinaryType::Subtract) && IsMatrixOrUnresolved(*node.left) && IsMatrixOrUnresolved(*node.right))
+						nodeTraits |= NodeTrait::MatrixAddSub;
+
+					StaticRecursiveVisitor::Visit(node);
+				}
+
+				void Visit(CastExpression& node)
+				{
+					if (!node.targetType.IsResultingValue() || IsMatrixType(ResolveAlias(node.targetType.GetResultingValue())))
+						nodeTraits |= NodeTrait::MatrixCast;
+
+					GatherValue(node.targetType);
+					StaticRecursiveVisitor::Visit(node);
+				}
+
+				void Visit(DeclareConstStatement& node)
+				{
+					GatherValue(node.type);
+					GatherValue(node.isExported);
+					StaticRecursiveVisitor::Visit(node);
+				}
+
+				void Visit(DeclareExternalStatement& node)
+				{
+					GatherValue(node.bindingSet);
+					GatherValue(node.autoBinding);
+					for (auto& externalVar : node.externalVars)
+					{
+						GatherValue(externalVar.bindingIndex);
+						GatherValue(externalVar.bindingSet);
+						GatherValue(externalVar.type);
+					}
+
+					StaticRecursiveVisitor::Visit(node);
+				}
+
+				void Visit(DeclareFunctionStatement& node)
+				{
+					GatherValue(node.depthWrite);
+					GatherValue(node.returnType);
+					GatherValue(node.entryStage);
+					GatherValue(node.workgroupSize);
+					GatherValue(node.earlyFragmentTests);
+					GatherValue(node.isExported);
+					for (auto& parameter : node.parameters)
+						GatherValue(parameter.type);
+
+					StaticRecursiveVisitor::Visit(node);
+				}
+
+				void Visit(DeclareOptionStatement& node)
+				{
+					GatherValue(node.optType);
+					StaticRecursiveVisitor::Visit(node);
+				}
+
+				void Visit(DeclareStructStatement& node)
+				{
+					GatherValue(node.isExported);
+					GatherValue(node.description.layout);
+					for (auto& member : node.description.members)
+					{
+						GatherValue(member.builtin);
+						GatherValue(member.cond);
+						GatherValue(member.interp);
+						GatherValue(member.locationIndex);
+						GatherValue(member.type);
+					}
+
+					StaticRecursiveVisitor::Visit(node);
+				}
+
+				void Visit(DeclareVariableStatement& node)
+				{
+					GatherValue(node.varType);
+					StaticRecursiveVisitor::Visit(node);
+				}
+
+				void Visit(ForStatement& node)
+				{
+					GatherUnroll(node.unroll);
+					GatherValue(node.unroll);
+					StaticRecursiveVisitor::Visit(node);
+				}
+
+				void Visit(ForEachStatement& node)
+				{
+					GatherUnroll(node.unroll);
+					GatherValue(node.unroll);
+					StaticRecursiveVisitor::Visit(node);
+				}
+
+				void Visit(WhileStatement& node)
+				{
+					GatherValue(node.unroll);
+					StaticRecursiveVisitor::Visit(node);
+				}
+
+				NodeTraitFlags nodeTraits;
+				NodeTypeFlags nodeTypes;
+
+			private:
+				void GatherUnroll(const ExpressionValue<LoopUnroll>& unroll)
+				{
+					if (unroll.IsExpression() || (unroll.IsResultingValue() && unroll.GetResultingValue() == LoopUnroll::Always))
+						nodeTraits |= NodeTrait::UnrolledLoop;
+				}
+
+				template<typename T>
+				void GatherValue(ExpressionValue<T>& value)
+				{
+					if (value.IsExpression())
+						Dispatch(*value.GetExpression());
+				}
+
+				static bool IsMatrixOrUnresolved(const Expression& expression)
+				{
+					const ExpressionType* expressionType = GetExpressionType(expression);
+					return !expressionType || IsMatrixType(ResolveAlias(*expressionType));
+				}
+		};
 	}
 
 	std::optional<ExpressionType> ComputeExpressionType(const IntrinsicExpression& intrinsicExpr, const Stringifier& /*typeStringifier*/)
@@ -500,6 +645,22 @@ namespace nzsl::Ast
 		return visitor.GetExpressionCategory(expression);
 	}
 
+	NodeTypeFlags GetNodeTypes(Module& module, NodeTraitFlags* nodeTraits)
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		NodeTypeGatherer gatherer;
+		for (auto& importedModule : module.importedModules)
+			gatherer.Dispatch(*importedModule.module->rootNode);
+
+		gatherer.Dispatch(*module.rootNode);
+
+		if (nodeTraits)
+			*nodeTraits = gatherer.nodeTraits;
+
+		return gatherer.nodeTypes;
+	}
+
 	Expression& MandatoryExpr(const ExpressionPtr& node, const SourceLocation& sourceLocation)
 	{
 		if (!node)
@@ -614,6 +775,9 @@ namespace nzsl::Ast
 
 	bool ValidateMatchingTypes(const ExpressionPtr& left, const ExpressionPtr& right)
 	{
+		if (left->cachedExpressionType == right->cachedExpressionType)
+			return true; //< same interned type (or both untyped)
+
 		const ExpressionType* leftType = GetExpressionType(*left);
 		const ExpressionType* rightType = GetExpressionType(*right);
 		if (!leftType || !rightType)
@@ -0,0 +1,144 @@
+// Copyright (C) 2026 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <NZSL/CompilationSession.hpp>
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+namespace nzsl
+{
+	namespace NAZARA_ANONYMOUS_NAMESPACE
+	{
+		// Jobs assigned to a worker, which takes them from the front while idle workers steal them from the back
+		struct WorkerQueue
+		{
+			std::mutex mutex;
+			std::deque<std::size_t> jobIndices;
+		};
+
+		std::optional<std::size_t> PopJob(std::vector<WorkerQueue>& queues, std::size_t workerIndex)
+		{
+			{
+				WorkerQueue& workerQueue = queues[workerIndex];
+
+				std::lock_guard lock(workerQueue.mutex);
+				if (!workerQueue.jobIndices.empty())
+				{
+					std::size_t jobIndex = workerQueue.jobIndices.front();
+					workerQueue.jobIndices.pop_front();
+
+					return jobIndex;
+				}
+			}
+
+			for (std::size_t i = 1; i < queues.size(); ++i)
+			{
+				WorkerQueue& victimQueue = queues[(workerIndex + i) % queues.size()];
+
+				std::lock_guard lock(victimQueue.mutex);
+				if (!victimQueue.jobIndices.empty())
+				{
+					std::size_t jobIndex = victimQueue.jobIndices.back();
+					victimQueue.jobIndices.pop_back();
+
+					return jobIndex;
+				}
+			}
+
+			// Jobs are all known before workers start, an empty pool means we're done
+			return std::nullopt;
+		}
+	}
+
+	auto CompilationSession::Run(unsigned int threadCount) const -> std::vector<Result>
+	{
+		NAZARA_USE_ANONYMOUS_NAMESPACE
+
+		std::vector<Result> results(m_jobs.size());
+
+		if (threadCount == 0)
+			threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+		std::size_t workerCount = std::min<std::size_t>(threadCount, m_jobs.size());
+		if (workerCount <= 1)
+		{
+			for (std::size_t i = 0; i < m_jobs.size(); ++i)
+				results[i] = RunJob(m_jobs[i]);
+
+			return results;
+		}
+
+		std::vector<WorkerQueue> queues(workerCount);
+		for (std::size_t i = 0; i < m_jobs.size(); ++i)
+			queues[i * workerCount / m_jobs.size()].jobIndices.push_back(i);
+
+		// Each job writes its own result, so results don't need any synchronization
+		auto Work = [&](std::size_t workerIndex)
+		{
+			while (std::optional<std::size_t> jobIndex = PopJob(queues, workerIndex))
+				results[*jobIndex] = RunJob(m_jobs[*jobIndex]);
+		};
+
+		std::vector<std::thread> workers;
+		workers.reserve(workerCount - 1);
+		for (std::size_t i = 1; i < workerCount; ++i)
+		{
+			try
+			{
+				workers.emplace_back(Work, i);
+			}
+			catch (const std::system_error&)
+			{
+				break; //< jobs of workers we failed to start will be stolen by the others
+			}
+		}
+
+		// The calling thread works as well
+		Work(0);
+
+		for (std::thread& worker : workers)
+			worker.join();
+
+		return results;
+	}
+
+	auto CompilationSession::RunJob(const Job& job) const -> Result
+	{
+		Result result;
+
+		try
+		{
+			// Writers transform their own copy of a const module, the session module is never modified
+			switch (job.backend)
+			{
+				case Backend::Glsl:
+				{
+					GlslWriter writer;
+					writer.SetEnv(job.glslEnvironment);
+
+					result.glslOutput = writer.Generate(job.shaderStage, *m_module, job.parameters, job.glslParameters);
+					break;
+				}
+
+				case Backend::Spirv:
+				{
+					SpirvWriter writer;
+					writer.SetEnv(job.spirvEnvironment);
+
+					result.spirv = writer.Generate(*m_module, job.parameters);
+					break;
+				}
+			}
+		}
+		catch (...)
+		{
+			result.error = std::current_exception();
+		}
+
+		return result;
+	}
+}
@@ -131,7 +131,10 @@ namespace nzsl
 				RegisterArchive(DeserializeArchive(deserializer));
 			}
 			else if (ext == ModuleExtension)
-				module = Parse(std::string_view(content.data(), content.size()), Nz::PathToString(realPath));
+			{
+				TokenStream tokenStream(std::string_view(content.data(), content.size()), Nz::PathToString(realPath));
+				module = Parser(m_parserOptions).Parse(tokenStream);
+			}
 			else
 				throw std::runtime_error("unknown extension " + ext);
 		}
@@ -154,7 +157,8 @@ namespace nzsl
 
 	void FilesystemModuleResolver::RegisterModule(std::string_view moduleSource)
 	{
-		Ast::ModulePtr module = Parse(moduleSource);
+		TokenStream tokenStream(moduleSource);
+		Ast::ModulePtr module = Parser(m_parserOptions).Parse(tokenStream);
 		if (!module)
 			return;
 
@@ -171,15 +175,30 @@ namespace nzsl
 
 		std::lock_guard lock(m_moduleLock);
 
+		// registered modules are never modified, each of them gets a new version
+		std::uint64_t moduleVersion = m_nextModuleVersion++;
+
 		auto it = m_modules.find(moduleName);
 		if (it != m_modules.end())
 		{
-			it->second = std::move(module);
+			it->second.module = std::move(module);
+			it->second.version = moduleVersion;
 
 			OnModuleUpdated(this, moduleName);
 		}
 		else
-			m_modules.emplace(std::move(moduleName), std::move(module));
+			m_modules.emplace(std::move(moduleName), ModuleEntry{ std::move(module), moduleVersion });
+	}
+
+	std::optional<std::uint64_t> FilesystemModuleResolver::GetModuleVersion(const std::string& moduleName)
+	{
+		std::lock_guard lock(m_moduleLock);
+
+		auto it = m_modules.find(moduleName);
+		if (it == m_modules.end())
+			return std::nullopt;
+
+		return it->second.version;
 	}
 
 	Ast::ModulePtr FilesystemModuleResolver::Resolve(const std::string& moduleName)
@@ -188,7 +207,7 @@ namespace nzsl
 		if (it == m_modules.end())
 			return {};
 
-		return it->second;
+		return it->second.module;
 	}
 
 	void FilesystemModuleResolver::OnFileAdded(std::string_view directory, std::string_view filename)
@@ -8,7 +8,10 @@
 #include <NazaraUtils/CallOnExit.hpp>
 #include <NazaraUtils/PathUtils.hpp>
 #include <NZSL/Enums.hpp>
+#include <NZSL/PermutationUtils.hpp>
+#include <NZSL/Ast/Cloner.hpp>
 #include <NZSL/Ast/ConstantValue.hpp>
+#include <NZSL/Ast/NodeArena.hpp>
 #include <NZSL/Ast/RecursiveVisitor.hpp>
 #include <NZSL/Ast/Utils.hpp>
 #include <NZSL/Lang/LangData.hpp>
@@ -404,45 +407,9 @@ namespace nzsl
 		m_currentState = &state;
 		NAZARA_DEFER({ m_currentState = nullptr; });
 
-		if (parameters.backendPasses)
-		{
-			Ast::TransformerExecutor executor;
-			if (parameters.backendPasses.Test(BackendPass::Resolve))
-			{
-				executor.AddPass<Ast::ResolveTransformer>([&](Ast::ResolveTransformer::Options& opt)
-				{
-					opt.moduleResolver = parameters.shaderModuleResolver;
-				});
-			}
-
-			if (parameters.backendPasses.Test(BackendPass::TargetRequired))
-				RegisterPasses(executor);
+		RunPasses(shaderStage, module, parameters);
 
-			if (parameters.backendPasses.Test(BackendPass::Optimize))
-				executor.AddPass<Ast::ConstantPropagationTransformer>();
-
-			if (parameters.backendPasses.Test(BackendPass::Validate))
-			{
-				executor.AddPass<Ast::ValidationTransformer>([](Ast::ValidationTransformer::Options& opt)
-				{
-					opt.allowUntyped = false;
-					opt.checkIndices = true;
-				});
-			}
-
-			Ast::TransformerContext context;
-			context.optionValues = parameters.optionValues;
-
-			executor.Transform(module, context);
-		}
-
-		if (parameters.backendPasses.Test(BackendPass::RemoveDeadCode))
-		{
-			Ast::DependencyCheckerVisitor::Config dependencyConfig;
-			dependencyConfig.usedShaderStages = (shaderStage) ? *shaderStage : ShaderStageType_All; //< only one should exist anyway
-
-			Ast::EliminateUnusedPass(module, dependencyConfig);
-		}
+		Ast::PassInstrumentation::Scope generationInstrumentationScope(parameters.passInstrumentation, "GLSL generation");
 
 		// Previsitor
 		for (Ast::ModuleFeature feature : module.metadata->enabledFeatures)
@@ -523,6 +490,34 @@ namespace nzsl
 		return output;
 	}
 
+	auto GlslWriter::Generate(std::optional<ShaderStageType> shaderStage, const Ast::Module& module, const BackendParameters& parameters, const Parameters& glslParameters) -> Output
+	{
+		// The copy gets its own arena, nodes created by the passes are allocated from it and released at once with it
+		Ast::ModulePtr moduleCopy;
+		{
+			Ast::NodeArena::Scope arenaScope(std::make_shared<Ast::NodeArena>());
+			moduleCopy = Ast::Clone(module);
+		}
+
+		return Generate(shaderStage, *moduleCopy, parameters, glslParameters);
+	}
+
+	auto GlslWriter::GeneratePermutations(std::optional<ShaderStageType> shaderStage, const Ast::Module& module, const std::vector<OptionValues>& optionPermutations, const BackendParameters& parameters, const Parameters& glslParameters) -> PermutationOutputs<Output>
+	{
+		auto RunPermutationPasses = [&](Ast::Module& permutationModule, const BackendParameters& permutationParameters, bool keepUnsetScalarOptions)
+		{
+			RunPasses(shaderStage, permutationModule, permutationParameters, keepUnsetScalarOptions);
+		};
+
+		auto GeneratePermutation = [&](Ast::Module& permutationModule, const BackendParameters& generationParameters)
+		{
+			return Generate(shaderStage, permutationModule, generationParameters, glslParameters);
+		};
+
+		// GLSL has no specialization constants, options always get a value
+		return PermutationUtils::GeneratePermutations<Output>(module, optionPermutations, parameters, false, RunPermutationPasses, GeneratePermutation);
+	}
+
 	void GlslWriter::SetEnv(Environment environment)
 	{
 		m_environment = std::move(environment);
@@ -548,7 +543,7 @@ namespace nzsl
 		return s_glslWriterFlipYUniformName;
 	}
 
-	void GlslWriter::RegisterPasses(Ast::TransformerExecutor& executor)
+	void GlslWriter::RegisterPasses(Ast::TransformerExecutor& executor, bool keepUnsetScalarOptions)
 	{
 		static constexpr auto s_reservedKeywords = frozen::make_unordered_set<frozen::string>({
 			// All reserved GLSL keywords as of GLSL ES 3.2
@@ -623,8 +618,9 @@ namespace nzsl
 			opt.removeScalarSwizzling = true;
 		});
 		executor.AddPass<Ast::BindingResolverTransformer>();
-		executor.AddPass<Ast::ConstantRemovalTransformer>([](Ast::ConstantRemovalTransformer::Options& opt)
+		executor.AddPass<Ast::ConstantRemovalTransformer>([&](Ast::ConstantRemovalTransformer::Options& opt)
 		{
+			opt.keepUnsetScalarOptions = keepUnsetScalarOptions;
 			opt.removeConstArraySize = false;
 			opt.removeTypeConstant = false;
 		});
@@ -1466,13 +1462,13 @@ namespace nzsl
 			const SourceLocation& rootLocation = module.rootNode->sourceLocation;
 
 			AppendComment("NZSL version: " + Version::ToString(metadata.langVersion));
-			if (rootLocation.file)
+			if (const auto& filePath = rootLocation.GetFile())
 			{
-				AppendComment("from " + *rootLocation.file);
+				AppendComment("from " + *filePath);
 				if (m_currentState->backendParameters.debugLevel >= DebugLevel::Full)
 				{
 					// Try to embed source code
-					std::ifstream file(Nz::Utf8Path(*rootLocation.file));
+					std::ifstream file(Nz::Utf8Path(*filePath));
 					if (file)
 					{
 						AppendLine("#if 0 // Module source code");
@@ -1711,8 +1707,8 @@ namespace nzsl
 			return;
 
 		std::string_view file;
-		if (sourceLocation.file)
-			file = *sourceLocation.file;
+		if (const auto& filePath = sourceLocation.GetFile())
+			file = *filePath;
 		else
 			file = "unknown";
 
@@ -1741,6 +1737,53 @@ namespace nzsl
 		m_currentState->variableNames.emplace(varIndex, std::move(varName));
 	}
 
+	void GlslWriter::RunPasses(std::optional<ShaderStageType> shaderStage, Ast::Module& module, const BackendParameters& parameters, bool keepUnsetScalarOptions)
+	{
+		if (parameters.backendPasses)
+		{
+			Ast::TransformerExecutor executor;
+			executor.SetInstrumentation(parameters.passInstrumentation);
+
+			if (parameters.backendPasses.Test(BackendPass::Resolve))
+			{
+				executor.AddPass<Ast::ResolveTransformer>([&](Ast::ResolveTransformer::Options& opt)
+				{
+					opt.moduleResolver = parameters.shaderModuleResolver;
+					opt.resolvedModuleCache = parameters.resolvedModuleCache;
+				});
+			}
+
+			if (parameters.backendPasses.Test(BackendPass::TargetRequired))
+				RegisterPasses(executor, keepUnsetScalarOptions);
+
+			if (parameters.backendPasses.Test(BackendPass::Optimize))
+				executor.AddPass<Ast::ConstantPropagationTransformer>();
+
+			if (parameters.backendPasses.Test(BackendPass::Validate))
+			{
+				executor.AddPass<Ast::ValidationTransformer>([](Ast::ValidationTransformer::Options& opt)
+				{
+					opt.allowUntyped = false;
+					opt.checkIndices = true;
+				});
+			}
+
+			Ast::TransformerContext context;
+			context.optionValues = parameters.optionValues;
+
+			executor.Transform(module, context);
+		}
+
+		if (parameters.backendPasses.Test(BackendPass::RemoveDeadCode))
+		{
+			Ast::DependencyCheckerVisitor::Config dependencyConfig;
+			dependencyConfig.usedShaderStages = (shaderStage) ? *shaderStage : ShaderStageType_All; //< only one should exist anyway
+
+			Ast::PassInstrumentation::Scope instrumentationScope(parameters.passInstrumentation, "RemoveDeadCode");
+			Ast::EliminateUnusedPass(module, dependencyConfig);
+		}
+	}
+
 	void GlslWriter::ScopeVisit(Ast::Statement& node)
 	{
 		if (node.GetType() != Ast::NodeType::ScopedStatement)
@@ -147,8 +147,8 @@ namespace nzsl
 			if (m_sourceLocation.IsValid())
 			{
 				std::string_view sourceFile;
-				if (m_sourceLocation.file)
-					sourceFile = *m_sourceLocation.file;
+				if (const auto& filePath = m_sourceLocation.GetFile())
+					sourceFile = *filePath;
 
 				if (m_sourceLocation.startLine != m_sourceLocation.endLine)
 					m_fullErrorMessage = fmt::format("{}({} -> {},{} -> {}): {} error: {}", sourceFile, m_sourceLocation.startLine, m_sourceLocation.endLine, m_sourceLocation.startColumn, m_sourceLocation.endColumn, m_errorType, GetErrorMessage());
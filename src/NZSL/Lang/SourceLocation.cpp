@@ -0,0 +1,69 @@
+// Copyright (C) 2026 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <NZSL/Lang/SourceLocation.hpp>
+#include <NazaraUtils/Algorithm.hpp>
+#include <cassert>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace nzsl
+{
+	namespace
+	{
+		struct SourceFileTable
+		{
+			std::deque<std::shared_ptr<const std::string>> files; //< deque never moves its elements, so references stay valid
+			std::mutex mutex;
+			std::unordered_map<std::string_view, std::uint32_t> fileIndices; //< views into files
+		};
+
+		SourceFileTable& GetSourceFileTable()
+		{
+			static SourceFileTable fileTable;
+			return fileTable;
+		}
+	}
+
+	void SourceLocation::ClearFileTable()
+	{
+		SourceFileTable& fileTable = GetSourceFileTable();
+
+		std::lock_guard lock(fileTable.mutex);
+		fileTable.fileIndices.clear();
+		fileTable.files.clear();
+	}
+
+	std::uint32_t SourceLocation::RegisterFile(std::string_view filePath)
+	{
+		if (filePath.empty())
+			return 0;
+
+		SourceFileTable& fileTable = GetSourceFileTable();
+
+		std::lock_guard lock(fileTable.mutex);
+		if (auto it = fileTable.fileIndices.find(filePath); it != fileTable.fileIndices.end())
+			return it->second;
+
+		const auto& file = fileTable.files.emplace_back(std::make_shared<const std::string>(filePath));
+		std::uint32_t fileIndex = Nz::SafeCast<std::uint32_t>(fileTable.files.size()); //< indices start at one as zero means no file
+		fileTable.fileIndices.emplace(*file, fileIndex);
+
+		return fileIndex;
+	}
+
+	const std::shared_ptr<const std::string>& SourceLocation::ResolveFile(std::uint32_t fileIndex)
+	{
+		static std::shared_ptr<const std::string> noFile;
+		if (fileIndex == 0)
+			return noFile;
+
+		SourceFileTable& fileTable = GetSourceFileTable();
+
+		std::lock_guard lock(fileTable.mutex);
+		assert(fileIndex <= fileTable.files.size());
+		return fileTable.files[fileIndex - 1];
+	}
+}
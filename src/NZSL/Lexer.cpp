@@ -8,11 +8,22 @@
 #include <fast_float/fast_float.h>
 #include <frozen/string.h>
 #include <frozen/unordered_map.h>
-#include <cctype>
 #include <charconv>
 #include <optional>
 #include <sstream>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NZSL_LEXER_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define NZSL_LEXER_NEON
+#include <arm_neon.h>
+#endif
+
+#ifdef NAZARA_COMPILER_MSVC
+#include <intrin.h>
+#endif
+
 namespace nzsl
 {
 	namespace
@@ -44,6 +55,204 @@ namespace nzsl
 			{ "true",         TokenType::BoolTrue },
 			{ "while",        TokenType::While }
 		});
+
+		constexpr bool IsBlank(char c)
+		{
+			return c == ' ' || c == '\t' || c == '\r';
+		}
+
+		constexpr bool IsDigitOrSeparator(char c, bool hex)
+		{
+			if ((c >= '0' && c <= '9') || c == '_')
+				return true;
+
+			return hex && ((c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'));
+		}
+
+		constexpr bool IsIdentifierChar(char c)
+		{
+			return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+		}
+
+		// Vectorized scanning: classify 16 characters at once and return the position of the first one not matching the predicate
+		// the remaining characters (and platforms without SSE2/NEON) are handled by the scalar loops of the Skip* functions
+#if defined(NZSL_LEXER_SSE2)
+		using CharBlock = __m128i;
+
+		NAZARA_FORCEINLINE CharBlock Equal(CharBlock block, char c) { return _mm_cmpeq_epi8(block, _mm_set1_epi8(c)); }
+		NAZARA_FORCEINLINE CharBlock InRange(CharBlock block, char first, char last) { return _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8(first - 1)), _mm_cmplt_epi8(block, _mm_set1_epi8(last + 1))); } //< signed comparison, non-ASCII characters are never in range
+		NAZARA_FORCEINLINE CharBlock Not(CharBlock block) { return _mm_xor_si128(block, _mm_set1_epi8(-1)); }
+		NAZARA_FORCEINLINE CharBlock Or(CharBlock lhs, CharBlock rhs) { return _mm_or_si128(lhs, rhs); }
+		NAZARA_FORCEINLINE CharBlock ToLower(CharBlock block) { return _mm_or_si128(block, _mm_set1_epi8(0x20)); }
+
+		NAZARA_FORCEINLINE unsigned int FindFirstMismatch(CharBlock matches)
+		{
+			std::uint32_t mismatchMask = ~static_cast<std::uint32_t>(_mm_movemask_epi8(matches)) & 0xFFFF;
+			if (mismatchMask == 0)
+				return 16;
+
+#ifdef NAZARA_COMPILER_MSVC
+			unsigned long index;
+			_BitScanForward(&index, mismatchMask);
+			return index;
+#else
+			return __builtin_ctz(mismatchMask);
+#endif
+		}
+#elif defined(NZSL_LEXER_NEON)
+		using CharBlock = uint8x16_t;
+
+		NAZARA_FORCEINLINE CharBlock Equal(CharBlock block, char c) { return vceqq_u8(block, vdupq_n_u8(static_cast<std::uint8_t>(c))); }
+		NAZARA_FORCEINLINE CharBlock InRange(CharBlock block, char first, char last) { return vandq_u8(vcgeq_u8(block, vdupq_n_u8(static_cast<std::uint8_t>(first))), vcleq_u8(block, vdupq_n_u8(static_cast<std::uint8_t>(last)))); } //< unsigned comparison, non-ASCII characters are never in range
+		NAZARA_FORCEINLINE CharBlock Not(CharBlock block) { return vmvnq_u8(block); }
+		NAZARA_FORCEINLINE CharBlock Or(CharBlock lhs, CharBlock rhs) { return vorrq_u8(lhs, rhs); }
+		NAZARA_FORCEINLINE CharBlock ToLower(CharBlock block) { return vorrq_u8(block, vdupq_n_u8(0x20)); }
+
+		NAZARA_FORCEINLINE unsigned int FindFirstMismatch(CharBlock matches)
+		{
+			// NEON has no movemask, narrow each comparison byte to a nibble instead
+			std::uint64_t mismatchMask = ~vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matches), 4)), 0);
+			if (mismatchMask == 0)
+				return 16;
+
+#ifdef NAZARA_COMPILER_MSVC
+			unsigned long index;
+			_BitScanForward64(&index, mismatchMask);
+			return index / 4;
+#else
+			return __builtin_ctzll(mismatchMask) / 4;
+#endif
+		}
+#endif
+
+#if defined(NZSL_LEXER_SSE2) || defined(NZSL_LEXER_NEON)
+		NAZARA_FORCEINLINE CharBlock LoadBlock(const char* ptr)
+		{
+#if defined(NZSL_LEXER_SSE2)
+			return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+#else
+			return vld1q_u8(reinterpret_cast<const std::uint8_t*>(ptr));
+#endif
+		}
+
+		template<char C, char... Rest>
+		NAZARA_FORCEINLINE CharBlock EqualAny(CharBlock block)
+		{
+			if constexpr (sizeof...(Rest) == 0)
+				return Equal(block, C);
+			else
+				return Or(Equal(block, C), EqualAny<Rest...>(block));
+		}
+
+		template<typename F>
+		std::size_t SkipWhile(std::string_view str, std::size_t pos, F&& predicate)
+		{
+			for (; pos + 16 <= str.size(); pos += 16)
+			{
+				unsigned int offset = FindFirstMismatch(predicate(LoadBlock(str.data() + pos)));
+				if (offset != 16)
+					return pos + offset;
+			}
+
+			return pos;
+		}
+#endif
+
+		std::size_t SkipBlanks(std::string_view str, std::size_t pos)
+		{
+#if defined(NZSL_LEXER_SSE2) || defined(NZSL_LEXER_NEON)
+			pos = SkipWhile(str, pos, [](CharBlock block) { return EqualAny<' ', '\t', '\r'>(block); });
+#endif
+			while (pos < str.size() && IsBlank(str[pos]))
+				pos++;
+
+			return pos;
+		}
+
+		std::size_t SkipDigits(std::string_view str, std::size_t pos, bool hex)
+		{
+#if defined(NZSL_LEXER_SSE2) || defined(NZSL_LEXER_NEON)
+			if (hex)
+				pos = SkipWhile(str, pos, [](CharBlock block) { return Or(Or(InRange(block, '0', '9'), Equal(block, '_')), InRange(ToLower(block), 'a', 'f')); });
+			else
+				pos = SkipWhile(str, pos, [](CharBlock block) { return Or(InRange(block, '0', '9'), Equal(block, '_')); });
+#endif
+			while (pos < str.size() && IsDigitOrSeparator(str[pos], hex))
+				pos++;
+
+			return pos;
+		}
+
+		std::size_t SkipIdentifierChars(std::string_view str, std::size_t pos)
+		{
+#if defined(NZSL_LEXER_SSE2) || defined(NZSL_LEXER_NEON)
+			pos = SkipWhile(str, pos, [](CharBlock block) { return Or(Or(InRange(block, '0', '9'), InRange(ToLower(block), 'a', 'z')), Equal(block, '_')); });
+#endif
+			while (pos < str.size() && IsIdentifierChar(str[pos]))
+				pos++;
+
+			return pos;
+		}
+
+		// Returns the position of the first occurrence of any of the characters (or the end of the string)
+		template<char... Chars>
+		std::size_t FindFirstOf(std::string_view str, std::size_t pos)
+		{
+			if (pos >= str.size())
+				return pos;
+
+#if defined(NZSL_LEXER_SSE2) || defined(NZSL_LEXER_NEON)
+			pos = SkipWhile(str, pos, [](CharBlock block) { return Not(EqualAny<Chars...>(block)); });
+#endif
+			while (pos < str.size() && ((str[pos] != Chars) && ...))
+				pos++;
+
+			return pos;
+		}
+
+		template<typename T>
+		void AppendToken(std::stringstream& ss, const T& token, bool pretty, unsigned int& lastLineNumber, bool& empty)
+		{
+			if (token.location.startLine != lastLineNumber && pretty)
+			{
+				lastLineNumber = token.location.startLine;
+				if (!empty)
+					ss << '\n';
+			}
+			else if (!empty)
+				ss << ' ';
+
+			ss << ToString(token.type);
+			switch (token.type)
+			{
+				case TokenType::FloatingPointValue:
+					ss << "(" << std::get<double>(token.data) << ")";
+					break;
+
+				case TokenType::Identifier:
+					if constexpr (std::is_same_v<T, TokenView>)
+						ss << "(" << std::get<std::string_view>(token.data) << ")";
+					else
+						ss << "(" << std::get<std::string>(token.data) << ")";
+					break;
+
+				case TokenType::IntegerValue:
+					ss << "(" << std::get<std::int64_t>(token.data) << ")";
+					break;
+
+				case TokenType::StringValue:
+					if constexpr (std::is_same_v<T, TokenView>)
+						ss << "(\"" << UnescapeString(std::get<std::string_view>(token.data)) << "\")";
+					else
+						ss << "(\"" << std::get<std::string>(token.data) << "\")";
+					break;
+
+				default:
+					break;
+			}
+
+			empty = false;
+		}
 	}
 
 	std::string EscapeString(std::string_view str, bool quote)
@@ -79,9 +288,85 @@ namespace nzsl
 		return result;
 	}
 
-	std::vector<Token> Tokenize(std::string_view str, const std::string& filePath)
+	TokenStream::TokenStream(std::string_view source, const std::string& filePath) :
+	m_bufferedTokenCount(0),
+	m_currentPos(0),
+	m_lineStartPos(0),
+	m_lookaheadIndex(0),
+	m_tokenCount(0),
+	m_tokenIndex(0),
+	m_source(source),
+	m_currentFileIndex(SourceLocation::RegisterFile(filePath)),
+	m_currentLine(1),
+	m_tokens(nullptr)
 	{
-		std::size_t currentPos = 0;
+	}
+
+	TokenStream::TokenStream(const std::vector<Token>& tokens) :
+	m_bufferedTokenCount(0),
+	m_currentPos(0),
+	m_lineStartPos(0),
+	m_lookaheadIndex(0),
+	m_tokenCount(tokens.size()),
+	m_tokenIndex(0),
+	m_currentFileIndex(0),
+	m_currentLine(1)
+	{
+		std::size_t stringCount = 0;
+		for (const Token& token : tokens)
+		{
+			if (token.type == TokenType::StringValue)
+				stringCount++;
+		}
+
+		// string views must not be invalidated by reallocations
+		m_escapedStrings.reserve(stringCount);
+
+		m_tokenViews.reserve(tokens.size());
+		for (const Token& token : tokens)
+		{
+			TokenView& tokenView = m_tokenViews.emplace_back();
+			tokenView.location = token.location;
+			tokenView.type = token.type;
+
+			std::visit([&](auto&& arg)
+			{
+				using T = std::decay_t<decltype(arg)>;
+				if constexpr (std::is_same_v<T, std::string>)
+				{
+					if (token.type == TokenType::StringValue)
+						tokenView.data = std::string_view(m_escapedStrings.emplace_back(EscapeString(arg, false)));
+					else
+						tokenView.data = std::string_view(arg);
+				}
+				else
+					tokenView.data = arg;
+			}, token.data);
+		}
+
+		m_tokens = m_tokenViews.data();
+	}
+
+	TokenStream::TokenStream(const std::vector<TokenView>& tokens) :
+	m_bufferedTokenCount(0),
+	m_currentPos(0),
+	m_lineStartPos(0),
+	m_lookaheadIndex(0),
+	m_tokenCount(tokens.size()),
+	m_tokenIndex(0),
+	m_currentFileIndex(0),
+	m_currentLine(1),
+	m_tokens(tokens.data())
+	{
+	}
+
+	void TokenStream::LexToken(TokenView& token)
+	{
+		// Work on local copies of the lexer state, they are written back once the token is complete
+		std::string_view str = m_source;
+		std::size_t currentPos = m_currentPos;
+		std::size_t lineStartPos = m_lineStartPos;
+		std::uint32_t currentLine = m_currentLine;
 
 		auto Peek = [&](std::size_t advance = 1) -> char
 		{
@@ -91,32 +376,26 @@ namespace nzsl
 				return '\0';
 		};
 
-		auto IsAlphaNum = [&](const char c)
-		{
-			return std::isalnum(c) || c == '_';
-		};
-
-		std::uint32_t currentLine = 1;
-		std::size_t lineStartPos = 0;
-		std::string literalTemp;
-		std::vector<Token> tokens;
-
 		auto HandleNewLine = [&]
 		{
 			currentLine++;
 			lineStartPos = currentPos + 1;
 		};
 
-		std::shared_ptr<const std::string> currentFile;
-		if (!filePath.empty())
-			currentFile = std::make_shared<std::string>(filePath);
+		auto SaveState = [&]
+		{
+			m_currentLine = currentLine;
+			m_currentPos = currentPos;
+			m_lineStartPos = lineStartPos;
+		};
+
+		token.data = {};
 
 		for (;;)
 		{
 			char c = Peek(0);
 
-			Token token;
-			token.location.file = currentFile;
+			token.location.fileIndex = m_currentFileIndex;
 			token.location.startColumn = Nz::SafeCast<std::uint32_t>(currentPos - lineStartPos) + 1;
 			token.location.startLine = currentLine;
 
@@ -126,8 +405,9 @@ namespace nzsl
 				token.location.endColumn = token.location.startColumn;
 				token.location.endLine = token.location.startLine;
 
-				tokens.push_back(std::move(token));
-				break;
+				// don't move past the end, any further token will be EndOfStream as well
+				SaveState();
+				return;
 			}
 
 			std::optional<TokenType> tokenType;
@@ -136,7 +416,8 @@ namespace nzsl
 				case ' ':
 				case '\t':
 				case '\r':
-					break; //< Ignore blank spaces
+					currentPos = SkipBlanks(str, currentPos + 1) - 1; //< Ignore blank spaces
+					break;
 
 				case '\n':
 					HandleNewLine();
@@ -167,12 +448,7 @@ namespace nzsl
 					if (next == '/')
 					{
 						// Line comment
-						do
-						{
-							currentPos++;
-							next = Peek();
-						}
-						while (next != '\0' && next != '\n');
+						currentPos = FindFirstOf<'\n', '\0'>(str, currentPos + 2) - 1;
 					}
 					else if (next == '*')
 					{
@@ -180,7 +456,7 @@ namespace nzsl
 						unsigned int blockDepth = 1;
 						for (;;)
 						{
-							currentPos++;
+							currentPos = FindFirstOf<'*', '/', '\n', '\0'>(str, currentPos + 2) - 1;
 							next = Peek();
 
 							if (next == '*')
@@ -233,6 +509,7 @@ namespace nzsl
 				case '8':
 				case '9':
 				{
+					std::string& literalTemp = m_literalTemp;
 					literalTemp.clear();
 
 					std::size_t start = currentPos;
@@ -255,42 +532,21 @@ namespace nzsl
 					bool floatingPoint = false;
 					for (;;)
 					{
-						auto IsDigitOrSep = [=](char c)
+						std::size_t digitEnd = SkipDigits(str, currentPos + 1, base > 10);
+						for (std::size_t i = currentPos + 1; i < digitEnd; ++i)
 						{
-							if (c == '_')
-								return true;
-
-							if (c >= '0' && c <= '9')
-								return true;
-
-							if (base > 10)
-							{
-								if (c >= 'a' && c <= 'f')
-									return true;
-
-								if (c >= 'A' && c <= 'F')
-									return true;
-							}
+							if (str[i] != '_')
+								literalTemp.push_back(str[i]);
+						}
 
-							return false;
-						};
+						currentPos = digitEnd - 1;
 
 						next = Peek();
+						if (next != '.' || floatingPoint)
+							break;
 
-						if (!IsDigitOrSep(next))
-						{
-							if (next != '.')
-								break;
-
-							if (floatingPoint)
-								break;
-
-							floatingPoint = true;
-						}
-
-						if (next != '_')
-							literalTemp.push_back(next);
-
+						floatingPoint = true;
+						literalTemp.push_back(next);
 						currentPos++;
 					}
 
@@ -518,12 +774,12 @@ namespace nzsl
 					// string literal
 					currentPos++;
 
-					std::string literal;
+					std::size_t start = currentPos;
 
+					// escape sequences are only validated here, the literal keeps referencing the source (see UnescapeString)
 					char current;
 					while ((current = Peek(0)) != '"')
 					{
-						char character;
 						switch (current)
 						{
 							case '\0':
@@ -539,11 +795,13 @@ namespace nzsl
 								char next = Peek(0);
 								switch (next)
 								{
-									case 'n': character = '\n'; break;
-									case 'r': character = '\r'; break;
-									case 't': character = '\t'; break;
-									case '"': character = '"'; break;
-									case '\\': character = '\\'; break;
+									case 'n':
+									case 'r':
+									case 't':
+									case '"':
+									case '\\':
+										break;
+
 									default:
 										token.location.endColumn = Nz::SafeCast<std::uint32_t>(currentPos - lineStartPos) + 1;
 										token.location.endLine = currentLine;
@@ -553,33 +811,29 @@ namespace nzsl
 							}
 
 							default:
-								character = current;
 								break;
 						}
 
-						literal.push_back(character);
 						currentPos++;
 					}
 
 					tokenType = TokenType::StringValue;
-					token.data = std::move(literal);
+					token.data = str.substr(start, currentPos - start);
 					break;
 				}
 
 				default:
 				{
-					if (IsAlphaNum(c))
+					if (IsIdentifierChar(c))
 					{
 						std::size_t start = currentPos;
-
-						while (IsAlphaNum(Peek()))
-							currentPos++;
+						currentPos = SkipIdentifierChars(str, currentPos + 1) - 1;
 
 						std::string_view identifier = str.substr(start, currentPos - start + 1);
 						if (auto it = s_reservedKeywords.find(identifier); it == s_reservedKeywords.end())
 						{
 							tokenType = TokenType::Identifier;
-							token.data = std::string(identifier);
+							token.data = identifier;
 						}
 						else
 							tokenType = it->second;
@@ -601,11 +855,70 @@ namespace nzsl
 				token.location.endLine = currentLine;
 				token.type = *tokenType;
 
-				tokens.push_back(std::move(token));
+				currentPos++;
+				SaveState();
+				return;
 			}
 
 			currentPos++;
 		}
+	}
+
+	std::string UnescapeString(std::string_view str)
+	{
+		std::string result;
+		result.reserve(str.size());
+
+		for (std::size_t i = 0; i < str.size(); ++i)
+		{
+			char c = str[i];
+			if (c == '\\' && i + 1 < str.size())
+			{
+				switch (str[++i])
+				{
+					case 'n': c = '\n'; break;
+					case 'r': c = '\r'; break;
+					case 't': c = '\t'; break;
+					default:  c = str[i]; break; //< quote and backslash
+				}
+			}
+
+			result.push_back(c);
+		}
+
+		return result;
+	}
+
+	std::vector<Token> Tokenize(std::string_view str, const std::string& filePath)
+	{
+		TokenStream tokenStream(str, filePath);
+
+		std::vector<Token> tokens;
+		for (;;)
+		{
+			const TokenView& tokenView = tokenStream.Advance();
+
+			Token& token = tokens.emplace_back();
+			token.location = tokenView.location;
+			token.type = tokenView.type;
+
+			std::visit([&](auto&& arg)
+			{
+				using T = std::decay_t<decltype(arg)>;
+				if constexpr (std::is_same_v<T, std::string_view>)
+				{
+					if (tokenView.type == TokenType::StringValue)
+						token.data = UnescapeString(arg);
+					else
+						token.data = std::string(arg);
+				}
+				else
+					token.data = arg;
+			}, tokenView.data);
+
+			if (token.type == TokenType::EndOfStream)
+				break;
+		}
 
 		return tokens;
 	}
@@ -627,46 +940,29 @@ namespace nzsl
 		if (tokens.empty())
 			return {};
 
-		unsigned int lastLineNumber = tokens.front().location.startLine;
-
 		std::stringstream ss;
+		unsigned int lastLineNumber = tokens.front().location.startLine;
 		bool empty = true;
 
 		for (const Token& token : tokens)
-		{
-			if (token.location.startLine != lastLineNumber && pretty)
-			{
-				lastLineNumber = token.location.startLine;
-				if (!empty)
-					ss << '\n';
-			}
-			else if (!empty)
-				ss << ' ';
+			AppendToken(ss, token, pretty, lastLineNumber, empty);
 
-			ss << ToString(token.type);
-			switch (token.type)
-			{
-				case TokenType::FloatingPointValue:
-					ss << "(" << std::get<double>(token.data) << ")";
-					break;
-
-				case TokenType::Identifier:
-					ss << "(" << std::get<std::string>(token.data) << ")";
-					break;
-
-				case TokenType::IntegerValue:
-					ss << "(" << std::get<std::int64_t>(token.data) << ")";
-					break;
+		return std::move(ss).str();
+	}
 
-				case TokenType::StringValue:
-					ss << "(\"" << std::get<std::string>(token.data) << "\")";
-					break;
+	std::string ToString(TokenStream& tokenStream, bool pretty)
+	{
+		std::stringstream ss;
+		unsigned int lastLineNumber = tokenStream.Peek().location.startLine;
+		bool empty = true;
 
-				default:
-					break;
-			}
+		for (;;)
+		{
+			const TokenView& token = tokenStream.Advance();
+			AppendToken(ss, token, pretty, lastLineNumber, empty);
 
-			empty = false;
+			if (token.type == TokenType::EndOfStream)
+				break;
 		}
 
 		return std::move(ss).str();
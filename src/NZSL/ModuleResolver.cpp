@@ -7,4 +7,9 @@
 namespace nzsl
 {
 	ModuleResolver::~ModuleResolver() = default;
+
+	std::optional<std::uint64_t> ModuleResolver::GetModuleVersion(const std::string& /*moduleName*/)
+	{
+		return std::nullopt;
+	}
 }
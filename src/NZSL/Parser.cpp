@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <NZSL/Parser.hpp>
+#include <NazaraUtils/CallOnExit.hpp>
 #include <NazaraUtils/PathUtils.hpp>
 #include <NZSL/ShaderBuilder.hpp>
 #include <NZSL/Ast/Utils.hpp>
@@ -86,10 +87,15 @@ namespace nzsl
 	}
 
 	Ast::ModulePtr Parser::Parse(const std::vector<Token>& tokens)
+	{
+		TokenStream tokenStream(tokens);
+		return Parse(tokenStream);
+	}
+
+	Ast::ModulePtr Parser::Parse(TokenStream& tokenStream)
 	{
 		Context context;
-		context.tokenCount = tokens.size();
-		context.tokens = tokens.data();
+		context.tokenStream = &tokenStream;
 
 		m_context = &context;
 
@@ -100,7 +106,7 @@ namespace nzsl
 			Ast::StatementPtr statement = ParseRootStatement();
 			if (!m_context->module)
 			{
-				const Token& nextToken = Peek();
+				const TokenView& nextToken = Peek();
 				throw ParserUnexpectedTokenError{ nextToken.location, nextToken.type };
 			}
 
@@ -122,6 +128,32 @@ namespace nzsl
 		return std::move(context.module);
 	}
 
+	void Parser::ParseDeferredFunctionBody(Ast::DeclareFunctionStatement& function)
+	{
+		if (!function.deferredBody)
+			return;
+
+		// The body is only released once parsed successfully, so a syntax error leaves the function untouched
+		const Ast::DeferredFunctionBody& deferredBody = *function.deferredBody;
+
+		TokenStream tokenStream(deferredBody.tokens);
+
+		Context context;
+		context.module = std::make_shared<Ast::Module>(deferredBody.langVersion);
+		context.tokenStream = &tokenStream;
+
+		Context* previousContext = m_context;
+		m_context = &context;
+
+		Nz::CallOnExit restoreContext([&] { m_context = previousContext; });
+
+		std::vector<Ast::StatementPtr> statements = ParseStatementList(nullptr);
+		Expect(Peek(), TokenType::EndOfStream);
+
+		function.statements = std::move(statements);
+		function.deferredBody.reset();
+	}
+
 	std::string_view Parser::ToString(Ast::AttributeType attributeType)
 	{
 		auto it = LangData::s_attributeData.find(attributeType);
@@ -201,21 +233,17 @@ namespace nzsl
 		return it->second.identifier;
 	}
 
-	const Token& Parser::Advance()
+	const TokenView& Parser::Advance()
 	{
-		const Token& token = Peek();
-		m_context->tokenIndex++;
-
-		return token;
+		return m_context->tokenStream->Advance();
 	}
 
 	void Parser::Consume(std::size_t count)
 	{
-		assert(m_context->tokenIndex + count < m_context->tokenCount);
-		m_context->tokenIndex += count;
+		m_context->tokenStream->Consume(count);
 	}
 
-	const Token& Parser::Expect(const Token& token, TokenType type)
+	const TokenView& Parser::Expect(const TokenView& token, TokenType type)
 	{
 		if (token.type != type)
 			throw ParserExpectedTokenError{ token.location, type, token.type };
@@ -223,7 +251,7 @@ namespace nzsl
 		return token;
 	}
 
-	const Token& Parser::ExpectNot(const Token& token, TokenType type)
+	const TokenView& Parser::ExpectNot(const TokenView& token, TokenType type)
 	{
 		if (token.type == type)
 			throw ParserUnexpectedTokenError{ token.location, type };
@@ -231,18 +259,17 @@ namespace nzsl
 		return token;
 	}
 
-	const Token& Parser::Expect(TokenType type)
+	const TokenView& Parser::Expect(TokenType type)
 	{
-		const Token& token = Peek();
+		const TokenView& token = Peek();
 		Expect(token, type);
 
 		return token;
 	}
 
-	const Token& Parser::Peek(std::size_t advance)
+	const TokenView& Parser::Peek(std::size_t advance)
 	{
-		assert(m_context->tokenIndex + advance < m_context->tokenCount);
-		return m_context->tokens[m_context->tokenIndex + advance];
+		return m_context->tokenStream->Peek(advance);
 	}
 
 	std::vector<Parser::Attribute> Parser::ParseAttributes()
@@ -256,7 +283,7 @@ namespace nzsl
 		bool expectComma = false;
 		for (;;)
 		{
-			const Token& t = Peek();
+			const TokenView& t = Peek();
 			ExpectNot(t, TokenType::EndOfStream);
 
 			if (t.type == TokenType::ClosingSquareBracket)
@@ -275,8 +302,8 @@ namespace nzsl
 			if (expectComma)
 				Expect(Advance(), TokenType::Comma);
 
-			const Token& identifierToken = Expect(Advance(), TokenType::Identifier);
-			std::string_view identifier = std::get<std::string>(identifierToken.data);
+			const TokenView& identifierToken = Expect(Advance(), TokenType::Identifier);
+			std::string_view identifier = std::get<std::string_view>(identifierToken.data);
 
 			SourceLocation attributeLocation = identifierToken.location;
 
@@ -316,11 +343,11 @@ namespace nzsl
 
 		if (m_context->parsingImportedModule)
 		{
-			const Token& token = Peek();
+			const TokenView& token = Peek();
 			throw ParserUnexpectedTokenError{ token.location, token.type };
 		}
 
-		const Token& moduleToken = Expect(Advance(), TokenType::Module);
+		SourceLocation moduleLocation = Expect(Advance(), TokenType::Module).location;
 
 		std::string author;
 		std::string description;
@@ -422,7 +449,7 @@ namespace nzsl
 		}
 
 		if (!moduleVersion.has_value())
-			throw ParserMissingAttributeError{ moduleToken.location, Ast::AttributeType::LangVersion };
+			throw ParserMissingAttributeError{ moduleLocation, Ast::AttributeType::LangVersion };
 
 		std::shared_ptr<Ast::Module::Metadata> moduleMetadata = std::make_shared<Ast::Module::Metadata>();
 		moduleMetadata->author = std::move(author);
@@ -434,7 +461,7 @@ namespace nzsl
 		if (m_context->module)
 		{
 			if (m_context->parsingImportedModule)
-				throw ParserModuleInnerImportError{ moduleToken.location };
+				throw ParserModuleInnerImportError{ moduleLocation };
 
 			moduleMetadata->moduleName = ParseModuleName(nullptr);
 			auto module = std::make_shared<Ast::Module>(std::move(moduleMetadata));
@@ -452,7 +479,7 @@ namespace nzsl
 				Ast::StatementPtr statement = ParseRootStatement();
 				if (!statement)
 				{
-					const Token& token = Peek();
+					const TokenView& token = Peek();
 					throw ParserUnexpectedEndOfFileError{ token.location };
 				}
 
@@ -493,7 +520,7 @@ namespace nzsl
 			Expect(Advance(), TokenType::Semicolon);
 
 			if (m_context->module)
-				throw ParserDuplicateModuleError{ moduleToken.location };
+				throw ParserDuplicateModuleError{ moduleLocation };
 
 			m_context->module = std::move(module);
 		}
@@ -516,7 +543,7 @@ namespace nzsl
 			initialValue = ParseExpression();
 		}
 
-		const Token& endToken = Expect(Advance(), TokenType::Semicolon);
+		const TokenView& endToken = Expect(Advance(), TokenType::Semicolon);
 		sourceLocation.ExtendToRight(endToken.location);
 	}
 
@@ -569,7 +596,7 @@ namespace nzsl
 
 	Ast::StatementPtr Parser::ParseAliasDeclaration(std::vector<Attribute> attributes)
 	{
-		const Token& aliasToken = Expect(Advance(), TokenType::Alias);
+		SourceLocation aliasLocation = Expect(Advance(), TokenType::Alias).location;
 
 		Ast::ExpressionValue<bool> condition;
 
@@ -586,16 +613,16 @@ namespace nzsl
 			}
 		}
 
-		std::string name = ParseIdentifierAsName(nullptr);
+		std::string name(ParseIdentifierAsName(nullptr));
 
 		Expect(Advance(), TokenType::Assign);
 
 		Ast::ExpressionPtr expr = ParseExpression();
 
-		const Token& endToken = Expect(Advance(), TokenType::Semicolon);
+		const TokenView& endToken = Expect(Advance(), TokenType::Semicolon);
 
 		auto aliasStatement = ShaderBuilder::DeclareAlias(std::move(name), std::move(expr));
-		aliasStatement->sourceLocation = SourceLocation::BuildFromTo(aliasToken.location, endToken.location);
+		aliasStatement->sourceLocation = SourceLocation::BuildFromTo(aliasLocation, endToken.location);
 
 		if (condition.HasValue())
 			return ShaderBuilder::ConditionalStatement(std::move(condition).GetExpression(), std::move(aliasStatement));
@@ -613,7 +640,7 @@ namespace nzsl
 			if (!first)
 				Expect(Advance(), TokenType::Else);
 
-			const Token& ifToken = Expect(Advance(), TokenType::If);
+			const TokenView& ifToken = Expect(Advance(), TokenType::If);
 			if (first)
 				branch->sourceLocation = ifToken.location;
 
@@ -646,7 +673,7 @@ namespace nzsl
 
 	Ast::StatementPtr Parser::ParseBreakStatement()
 	{
-		const Token& token = Expect(Advance(), TokenType::Break);
+		const TokenView& token = Expect(Advance(), TokenType::Break);
 		Expect(Advance(), TokenType::Semicolon);
 
 		auto statement = ShaderBuilder::Break();
@@ -657,11 +684,11 @@ namespace nzsl
 
 	Ast::StatementPtr Parser::ParseConstStatement(std::vector<Attribute> attributes)
 	{
-		const Token& constToken = Expect(Advance(), TokenType::Const);
+		const TokenView& constToken = Expect(Advance(), TokenType::Const);
 
 		SourceLocation constLocation = constToken.location;
 
-		const Token& token = Peek();
+		const TokenView& token = Peek();
 		switch (token.type)
 		{
 			case TokenType::Identifier:
@@ -723,7 +750,7 @@ namespace nzsl
 
 	Ast::StatementPtr Parser::ParseContinueStatement()
 	{
-		const Token& token = Expect(Advance(), TokenType::Continue);
+		const TokenView& token = Expect(Advance(), TokenType::Continue);
 		Expect(Advance(), TokenType::Semicolon);
 
 		auto statement = ShaderBuilder::Continue();
@@ -734,7 +761,7 @@ namespace nzsl
 
 	Ast::StatementPtr Parser::ParseDiscardStatement()
 	{
-		const Token& token = Expect(Advance(), TokenType::Discard);
+		const TokenView& token = Expect(Advance(), TokenType::Discard);
 		Expect(Advance(), TokenType::Semicolon);
 
 		auto statement = ShaderBuilder::Discard();
@@ -747,12 +774,12 @@ namespace nzsl
 	{
 		NAZARA_USE_ANONYMOUS_NAMESPACE
 
-		const Token& externalToken = Expect(Advance(), TokenType::External);
+		const TokenView& externalToken = Expect(Advance(), TokenType::External);
 
 		std::unique_ptr<Ast::DeclareExternalStatement> externalStatement = std::make_unique<Ast::DeclareExternalStatement>();
 		externalStatement->sourceLocation = externalToken.location;
 
-		if (const Token& peekToken = Peek(); peekToken.type == TokenType::Identifier)
+		if (const TokenView& peekToken = Peek(); peekToken.type == TokenType::Identifier)
 			externalStatement->name = ParseIdentifierAsName(nullptr);
 
 		Expect(Advance(), TokenType::OpenCurlyBracket);
@@ -792,7 +819,7 @@ namespace nzsl
 		{
 			if (!first)
 			{
-				const Token& nextToken = Peek();
+				const TokenView& nextToken = Peek();
 				if (nextToken.type == TokenType::Comma)
 					Consume();
 				else
@@ -804,7 +831,7 @@ namespace nzsl
 
 			first = false;
 
-			const Token& token = Peek();
+			const TokenView& token = Peek();
 			if (token.type == TokenType::ClosingCurlyBracket)
 				break;
 
@@ -858,9 +885,9 @@ namespace nzsl
 	{
 		NAZARA_USE_ANONYMOUS_NAMESPACE
 
-		const Token& forToken = Expect(Advance(), TokenType::For);
+		SourceLocation forLocation = Expect(Advance(), TokenType::For).location;
 
-		std::string varName = ParseIdentifierAsName(nullptr);
+		std::string varName(ParseIdentifierAsName(nullptr));
 
 		Expect(Advance(), TokenType::In);
 
@@ -883,7 +910,7 @@ namespace nzsl
 			Ast::StatementPtr statement = ParseStatement();
 
 			auto forNode = ShaderBuilder::For(std::move(varName), std::move(expr), std::move(toExpr), std::move(stepExpr), std::move(statement));
-			forNode->sourceLocation = SourceLocation::BuildFromTo(forToken.location, forNode->statement->sourceLocation);
+			forNode->sourceLocation = SourceLocation::BuildFromTo(forLocation, forNode->statement->sourceLocation);
 
 			// TODO: Deduplicate code
 			for (auto&& attribute : attributes)
@@ -907,7 +934,7 @@ namespace nzsl
 			Ast::StatementPtr statement = ParseStatement();
 
 			auto forEachNode = ShaderBuilder::ForEach(std::move(varName), std::move(expr), std::move(statement));
-			forEachNode->sourceLocation = SourceLocation::BuildFromTo(forToken.location, forEachNode->statement->sourceLocation);
+			forEachNode->sourceLocation = SourceLocation::BuildFromTo(forLocation, forEachNode->statement->sourceLocation);
 
 			// TODO: Deduplicate code
 			for (auto&& attribute : attributes)
@@ -931,9 +958,9 @@ namespace nzsl
 	{
 		NAZARA_USE_ANONYMOUS_NAMESPACE
 
-		const auto& funcToken = Expect(Advance(), TokenType::FunctionDeclaration);
+		SourceLocation funcLocation = Expect(Advance(), TokenType::FunctionDeclaration).location;
 
-		std::string functionName = ParseIdentifierAsName(nullptr);
+		std::string functionName(ParseIdentifierAsName(nullptr));
 
 		Expect(Advance(), TokenType::OpenParenthesis);
 
@@ -942,7 +969,7 @@ namespace nzsl
 		bool firstParameter = true;
 		for (;;)
 		{
-			const Token& t = Peek();
+			const TokenView& t = Peek();
 			ExpectNot(t, TokenType::EndOfStream);
 
 			if (t.type == TokenType::ClosingParenthesis)
@@ -965,11 +992,17 @@ namespace nzsl
 		}
 
 		SourceLocation functionLocation;
-		std::vector<Ast::StatementPtr> functionBody = ParseStatementList(&functionLocation);
+		std::vector<Ast::StatementPtr> functionBody;
+		std::shared_ptr<const Ast::DeferredFunctionBody> deferredBody;
+		if (m_options.deferFunctionBodies && m_context->module)
+			deferredBody = SkipStatementList(&functionLocation);
+		else
+			functionBody = ParseStatementList(&functionLocation);
 
-		functionLocation.ExtendToLeft(funcToken.location);
+		functionLocation.ExtendToLeft(funcLocation);
 
 		auto func = ShaderBuilder::DeclareFunction(std::move(functionName), std::move(parameters), std::move(functionBody), std::move(returnType));
+		func->deferredBody = std::move(deferredBody);
 		func->sourceLocation = std::move(functionLocation);
 
 		Ast::ExpressionValue<bool> condition;
@@ -1037,7 +1070,7 @@ namespace nzsl
 	{
 		Ast::DeclareFunctionStatement::Parameter parameter;
 
-		const Token& t = Peek();
+		const TokenView& t = Peek();
 		if (t.type == TokenType::InOut)
 		{
 			Consume();
@@ -1072,7 +1105,7 @@ namespace nzsl
 
 	Ast::StatementPtr Parser::ParseImportStatement()
 	{
-		const Token& importToken = Expect(Advance(), TokenType::Import);
+		SourceLocation importLocation = Expect(Advance(), TokenType::Import).location;
 
 		std::vector<Ast::ImportStatement::Identifier> identifiers;
 		do
@@ -1082,7 +1115,7 @@ namespace nzsl
 
 			auto& identifier = identifiers.emplace_back();
 
-			const Token& token = Peek();
+			const TokenView& token = Peek();
 			if (token.type == TokenType::Multiply) //< * = import everything
 			{
 				Consume(); //< *
@@ -1101,7 +1134,7 @@ namespace nzsl
 		}
 		while (Peek().type == TokenType::Comma);
 
-		const Token& token = Peek();
+		const TokenView& token = Peek();
 		if (token.type == TokenType::From)
 		{
 			// import <identifiers> from <module>;
@@ -1115,10 +1148,10 @@ namespace nzsl
 
 			std::string moduleName = ParseModuleName(nullptr);
 
-			const Token& endtoken = Expect(Advance(), TokenType::Semicolon);
+			const TokenView& endtoken = Expect(Advance(), TokenType::Semicolon);
 
 			auto importStatement = ShaderBuilder::Import(std::move(moduleName), std::move(identifiers));
-			importStatement->sourceLocation = SourceLocation::BuildFromTo(importToken.location, endtoken.location);
+			importStatement->sourceLocation = SourceLocation::BuildFromTo(importLocation, endtoken.location);
 
 			return importStatement;
 		}
@@ -1146,10 +1179,10 @@ namespace nzsl
 					identifierName = firstIdentifier.identifier;
 			}
 
-			const Token& endtoken = Expect(Advance(), TokenType::Semicolon);
+			const TokenView& endtoken = Expect(Advance(), TokenType::Semicolon);
 
 			auto importStatement = ShaderBuilder::Import(std::move(firstIdentifier.identifier), std::move(identifierName));
-			importStatement->sourceLocation = SourceLocation::BuildFromTo(importToken.location, endtoken.location);
+			importStatement->sourceLocation = SourceLocation::BuildFromTo(importLocation, endtoken.location);
 
 			return importStatement;
 		}
@@ -1157,9 +1190,9 @@ namespace nzsl
 
 	Ast::StatementPtr Parser::ParseOptionDeclaration()
 	{
-		const Token& optionToken = Expect(Advance(), TokenType::Option);
+		SourceLocation optionLocation = Expect(Advance(), TokenType::Option).location;
 
-		std::string optionName = ParseIdentifierAsName(nullptr);
+		std::string optionName(ParseIdentifierAsName(nullptr));
 
 		Ast::ExpressionValue<Ast::ExpressionType> optionType;
 		if (Peek().type == TokenType::Colon)
@@ -1177,33 +1210,33 @@ namespace nzsl
 			initialValue = ParseExpression();
 		}
 
-		const Token& endToken = Expect(Advance(), TokenType::Semicolon);
+		const TokenView& endToken = Expect(Advance(), TokenType::Semicolon);
 
 		auto optionDeclarationStatement = ShaderBuilder::DeclareOption(std::move(optionName), std::move(optionType), std::move(initialValue));
-		optionDeclarationStatement->sourceLocation = SourceLocation::BuildFromTo(optionToken.location, endToken.location);
+		optionDeclarationStatement->sourceLocation = SourceLocation::BuildFromTo(optionLocation, endToken.location);
 
 		return optionDeclarationStatement;
 	}
 
 	Ast::StatementPtr Parser::ParseReturnStatement()
 	{
-		const Token& returnToken = Expect(Advance(), TokenType::Return);
+		SourceLocation returnLocation = Expect(Advance(), TokenType::Return).location;
 
 		Ast::ExpressionPtr expr;
 		if (Peek().type != TokenType::Semicolon)
 			expr = ParseExpression();
 
-		const Token& endToken = Expect(Advance(), TokenType::Semicolon);
+		const TokenView& endToken = Expect(Advance(), TokenType::Semicolon);
 
 		auto returnStatement = ShaderBuilder::Return(std::move(expr));
-		returnStatement->sourceLocation = SourceLocation::BuildFromTo(returnToken.location, endToken.location);
+		returnStatement->sourceLocation = SourceLocation::BuildFromTo(returnLocation, endToken.location);
 
 		return returnStatement;
 	}
 
 	Ast::StatementPtr Parser::ParseRootStatement(std::vector<Attribute> attributes)
 	{
-		const Token& nextToken = Peek();
+		const TokenView& nextToken = Peek();
 		switch (nextToken.type)
 		{
 			case TokenType::Alias:
@@ -1260,7 +1293,7 @@ namespace nzsl
 		Ast::StatementPtr statement;
 		do
 		{
-			const Token& token = Peek();
+			const TokenView& token = Peek();
 			switch (token.type)
 			{
 				case TokenType::Break:
@@ -1361,7 +1394,7 @@ namespace nzsl
 
 	std::vector<Ast::StatementPtr> Parser::ParseStatementList(SourceLocation* sourceLocation)
 	{
-		const Token& openToken = Expect(Advance(), TokenType::OpenCurlyBracket);
+		SourceLocation openLocation = Expect(Advance(), TokenType::OpenCurlyBracket).location;
 
 		std::vector<Ast::StatementPtr> statements;
 		while (Peek().type != TokenType::ClosingCurlyBracket)
@@ -1369,19 +1402,65 @@ namespace nzsl
 			ExpectNot(Peek(), TokenType::EndOfStream);
 			statements.push_back(ParseStatement());
 		}
-		const Token& closeToken = Expect(Advance(), TokenType::ClosingCurlyBracket);
+		const TokenView& closeToken = Expect(Advance(), TokenType::ClosingCurlyBracket);
 
 		if (sourceLocation)
-			*sourceLocation = SourceLocation::BuildFromTo(openToken.location, closeToken.location);
+			*sourceLocation = SourceLocation::BuildFromTo(openLocation, closeToken.location);
 
 		return statements;
 	}
 
+	std::shared_ptr<const Ast::DeferredFunctionBody> Parser::SkipStatementList(SourceLocation* sourceLocation)
+	{
+		auto deferredBody = std::make_shared<Ast::DeferredFunctionBody>();
+		deferredBody->langVersion = m_context->module->metadata->langVersion;
+
+		// String views are stored as offsets into the string storage until all tokens are collected (as it may reallocate)
+		std::vector<std::pair<std::size_t, std::size_t>> stringRanges;
+
+		std::size_t depth = 0;
+		do
+		{
+			const TokenView& token = (deferredBody->tokens.empty()) ? Expect(Advance(), TokenType::OpenCurlyBracket) : ExpectNot(Advance(), TokenType::EndOfStream);
+			if (token.type == TokenType::OpenCurlyBracket)
+				depth++;
+			else if (token.type == TokenType::ClosingCurlyBracket)
+				depth--;
+
+			TokenView& tokenCopy = deferredBody->tokens.emplace_back(token);
+			if (const std::string_view* str = std::get_if<std::string_view>(&tokenCopy.data))
+			{
+				stringRanges.emplace_back(deferredBody->stringStorage.size(), str->size());
+				deferredBody->stringStorage.append(*str);
+			}
+		}
+		while (depth > 0);
+
+		std::size_t stringIndex = 0;
+		for (TokenView& token : deferredBody->tokens)
+		{
+			if (std::holds_alternative<std::string_view>(token.data))
+			{
+				auto [offset, size] = stringRanges[stringIndex++];
+				token.data = std::string_view(deferredBody->stringStorage).substr(offset, size);
+			}
+		}
+
+		if (sourceLocation)
+			*sourceLocation = SourceLocation::BuildFromTo(deferredBody->tokens.front().location, deferredBody->tokens.back().location);
+
+		TokenView& endToken = deferredBody->tokens.emplace_back();
+		endToken.type = TokenType::EndOfStream;
+		endToken.location = deferredBody->tokens[deferredBody->tokens.size() - 2].location;
+
+		return deferredBody;
+	}
+
 	Ast::StatementPtr Parser::ParseStructDeclaration(std::vector<Attribute> attributes)
 	{
 		NAZARA_USE_ANONYMOUS_NAMESPACE
 
-		const auto& structToken = Expect(Advance(), TokenType::Struct);
+		SourceLocation structLocation = Expect(Advance(), TokenType::Struct).location;
 
 		Ast::StructDescription description;
 		description.name = ParseIdentifierAsName(nullptr);
@@ -1425,7 +1504,7 @@ namespace nzsl
 		{
 			if (!first)
 			{
-				const Token& nextToken = Peek();
+				const TokenView& nextToken = Peek();
 				if (nextToken.type == TokenType::Comma)
 					Consume();
 				else
@@ -1437,7 +1516,7 @@ namespace nzsl
 
 			first = false;
 
-			const Token& token = Peek();
+			const TokenView& token = Peek();
 			if (token.type == TokenType::ClosingCurlyBracket)
 				break;
 
@@ -1485,10 +1564,10 @@ namespace nzsl
 			structField.type = ParseType();
 		}
 
-		const Token& endToken = Expect(Advance(), TokenType::ClosingCurlyBracket);
+		const TokenView& endToken = Expect(Advance(), TokenType::ClosingCurlyBracket);
 
 		auto structDeclStatement = ShaderBuilder::DeclareStruct(std::move(description), std::move(exported));
-		structDeclStatement->sourceLocation = SourceLocation::BuildFromTo(structToken.location, endToken.location);
+		structDeclStatement->sourceLocation = SourceLocation::BuildFromTo(structLocation, endToken.location);
 
 		if (condition.HasValue())
 		{
@@ -1523,7 +1602,7 @@ namespace nzsl
 	{
 		NAZARA_USE_ANONYMOUS_NAMESPACE
 
-		const Token& whileToken = Expect(Advance(), TokenType::While);
+		SourceLocation whileLocation = Expect(Advance(), TokenType::While).location;
 
 		Expect(Advance(), TokenType::OpenParenthesis);
 
@@ -1534,7 +1613,7 @@ namespace nzsl
 		Ast::StatementPtr body = ParseStatement();
 
 		auto whileStatement = ShaderBuilder::While(std::move(condition), std::move(body));
-		whileStatement->sourceLocation = SourceLocation::BuildFromTo(whileToken.location, whileStatement->body->sourceLocation);
+		whileStatement->sourceLocation = SourceLocation::BuildFromTo(whileLocation, whileStatement->body->sourceLocation);
 
 		for (auto&& attribute : attributes)
 		{
@@ -1556,7 +1635,7 @@ namespace nzsl
 	{
 		for (;;)
 		{
-			const Token& token = Peek();
+			TokenView token = Peek(); //< copy as nested parsing may invalidate references
 			TokenType currentTokenType = token.type;
 			if (currentTokenType == TokenType::EndOfStream)
 				throw ParserUnexpectedTokenError{ token.location, token.type };
@@ -1596,7 +1675,7 @@ namespace nzsl
 			Consume();
 			Ast::ExpressionPtr rhs = ParsePrimaryExpression();
 
-			const Token& nextOp = Peek();
+			const TokenView& nextOp = Peek();
 
 			int nextTokenPrecedence = GetBinaryTokenPrecedence(nextOp.type);
 			if (tokenPrecedence < nextTokenPrecedence)
@@ -1636,7 +1715,7 @@ namespace nzsl
 
 	Ast::ExpressionPtr Parser::ParseConstSelectExpression()
 	{
-		const Token& constSelectToken = Expect(Advance(), TokenType::ConstSelect);
+		SourceLocation constSelectLocation = Expect(Advance(), TokenType::ConstSelect).location;
 		Expect(Advance(), TokenType::OpenParenthesis);
 
 		Ast::ExpressionPtr cond = ParseExpression();
@@ -1649,10 +1728,10 @@ namespace nzsl
 
 		Ast::ExpressionPtr falseExpr = ParseExpression();
 
-		const Token& closeToken = Expect(Advance(), TokenType::ClosingParenthesis);
+		const TokenView& closeToken = Expect(Advance(), TokenType::ClosingParenthesis);
 
 		auto condExpr = ShaderBuilder::ConditionalExpression(std::move(cond), std::move(trueExpr), std::move(falseExpr));
-		condExpr->sourceLocation = SourceLocation::BuildFromTo(constSelectToken.location, closeToken.location);
+		condExpr->sourceLocation = SourceLocation::BuildFromTo(constSelectLocation, closeToken.location);
 
 		return condExpr;
 	}
@@ -1675,7 +1754,7 @@ namespace nzsl
 			parameters.push_back(ParseExpression());
 		}
 
-		const Token& endToken = Expect(Advance(), terminationToken);
+		const TokenView& endToken = Expect(Advance(), terminationToken);
 		if (terminationLocation)
 			*terminationLocation = endToken.location;
 
@@ -1714,7 +1793,7 @@ namespace nzsl
 			first = false;
 		}
 
-		const Token& endToken = Expect(Advance(), TokenType::ClosingParenthesis);
+		const TokenView& endToken = Expect(Advance(), TokenType::ClosingParenthesis);
 		terminationLocation = endToken.location;
 
 		return parameters;
@@ -1728,7 +1807,7 @@ namespace nzsl
 		// Assignation type 
 		Ast::AssignType assignType;
 
-		const Token& token = Peek();
+		const TokenView& token = Peek();
 		switch (token.type)
 		{
 			case TokenType::Assign:           assignType = Ast::AssignType::Simple; break;
@@ -1760,7 +1839,7 @@ namespace nzsl
 
 	Ast::ExpressionPtr Parser::ParseFloatingPointExpression()
 	{
-		const Token& floatingPointToken = Expect(Advance(), TokenType::FloatingPointValue);
+		const TokenView& floatingPointToken = Expect(Advance(), TokenType::FloatingPointValue);
 
 		Ast::ConstantValueExpressionPtr constantExpr;
 		if (m_context->module->metadata->langVersion >= Version::UntypedLiterals)
@@ -1774,8 +1853,8 @@ namespace nzsl
 
 	Ast::ExpressionPtr Parser::ParseIdentifier()
 	{
-		const Token& identifierToken = Expect(Advance(), TokenType::Identifier);
-		const std::string& identifier = std::get<std::string>(identifierToken.data);
+		const TokenView& identifierToken = Expect(Advance(), TokenType::Identifier);
+		std::string_view identifier = std::get<std::string_view>(identifierToken.data);
 
 		auto identifierExpr = ShaderBuilder::Identifier(identifier);
 		identifierExpr->sourceLocation = identifierToken.location;
@@ -1785,7 +1864,7 @@ namespace nzsl
 
 	Ast::ExpressionPtr Parser::ParseIntegerExpression()
 	{
-		const Token& integerToken = Expect(Advance(), TokenType::IntegerValue);
+		const TokenView& integerToken = Expect(Advance(), TokenType::IntegerValue);
 
 		Ast::ConstantValueExpressionPtr constantExpr;
 		if (m_context->module->metadata->langVersion >= Version::UntypedLiterals)
@@ -1799,18 +1878,18 @@ namespace nzsl
 
 	Ast::ExpressionPtr Parser::ParseParenthesisExpression()
 	{
-		const Token& openToken = Expect(Advance(), TokenType::OpenParenthesis);
+		SourceLocation openLocation = Expect(Advance(), TokenType::OpenParenthesis).location;
 		Ast::ExpressionPtr expression = ParseExpression();
-		const Token& closeToken = Expect(Advance(), TokenType::ClosingParenthesis);
+		const TokenView& closeToken = Expect(Advance(), TokenType::ClosingParenthesis);
 
-		expression->sourceLocation = SourceLocation::BuildFromTo(openToken.location, closeToken.location);
+		expression->sourceLocation = SourceLocation::BuildFromTo(openLocation, closeToken.location);
 
 		return expression;
 	}
 
 	Ast::ExpressionPtr Parser::ParsePrimaryExpression()
 	{
-		const Token& token = Peek();
+		TokenView token = Peek(); //< copy as nested parsing may invalidate references
 
 		Ast::ExpressionPtr primaryExpr;
 		switch (token.type)
@@ -1887,25 +1966,25 @@ namespace nzsl
 
 	Ast::ExpressionPtr Parser::ParseStringExpression()
 	{
-		const Token& literalToken = Expect(Advance(), TokenType::StringValue);
-		auto constantExpr = ShaderBuilder::ConstantValue(std::get<std::string>(literalToken.data));
+		const TokenView& literalToken = Expect(Advance(), TokenType::StringValue);
+		auto constantExpr = ShaderBuilder::ConstantValue(UnescapeString(std::get<std::string_view>(literalToken.data)));
 		constantExpr->sourceLocation = literalToken.location;
 
 		return constantExpr;
 	}
 
-	const std::string& Parser::ParseIdentifierAsName(SourceLocation* sourceLocation)
+	std::string_view Parser::ParseIdentifierAsName(SourceLocation* sourceLocation)
 	{
-		const Token& identifierToken = Expect(Advance(), TokenType::Identifier);
+		const TokenView& identifierToken = Expect(Advance(), TokenType::Identifier);
 		if (sourceLocation)
 			*sourceLocation = identifierToken.location;
 
-		return std::get<std::string>(identifierToken.data);
+		return std::get<std::string_view>(identifierToken.data);
 	}
 
 	std::string Parser::ParseModuleName(SourceLocation* sourceLocation)
 	{
-		std::string moduleName = ParseIdentifierAsName(sourceLocation);
+		std::string moduleName(ParseIdentifierAsName(sourceLocation));
 		while (Peek().type == TokenType::Dot)
 		{
 			SourceLocation identifierLocation;
@@ -1924,11 +2003,11 @@ namespace nzsl
 	Ast::ExpressionPtr Parser::ParseType()
 	{
 		// Handle () as no type
-		const Token& openToken = Peek();
+		const TokenView& openToken = Peek();
 		if (openToken.type == TokenType::OpenParenthesis)
 		{
 			Consume();
-			const Token& closeToken = Expect(Advance(), TokenType::ClosingParenthesis);
+			const TokenView& closeToken = Expect(Advance(), TokenType::ClosingParenthesis);
 
 			auto constantExpr = ShaderBuilder::ConstantValue(Ast::NoValue{});
 			constantExpr->sourceLocation = closeToken.location;
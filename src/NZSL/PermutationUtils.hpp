@@ -0,0 +1,343 @@
+// Copyright (C) 2026 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NZSL_PERMUTATIONUTILS_HPP
+#define NZSL_PERMUTATIONUTILS_HPP
+
+#include <NZSL/BackendParameters.hpp>
+#include <NZSL/Config.hpp>
+#include <NZSL/Ast/Cloner.hpp>
+#include <NZSL/Ast/Hash.hpp>
+#include <NZSL/Ast/Option.hpp>
+#include <NZSL/Ast/RecursiveVisitor.hpp>
+#include <NZSL/Ast/TransformerExecutor.hpp>
+#include <NZSL/Ast/Transformations/ConstantRemovalTransformer.hpp>
+#include <NZSL/Ast/Transformations/ResolveTransformer.hpp>
+#include <algorithm>
+#include <exception>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+// Shared implementation of the backends GeneratePermutations
+namespace nzsl::PermutationUtils
+{
+	// Calls the callback for each option declared by a module and the modules it imports
+	// Returns false if the module still has imports to resolve, as they may declare other options
+	template<typename F>
+	bool ForEachDeclaredOption(Ast::Module& module, F&& callback)
+	{
+		struct OptionLister : Ast::RecursiveVisitor
+		{
+			OptionLister(F& optionCallback) :
+			callback(optionCallback)
+			{
+			}
+
+			using RecursiveVisitor::Visit;
+
+			void Visit(Ast::DeclareOptionStatement& node) override
+			{
+				callback(node);
+			}
+
+			void Visit(Ast::ImportStatement& /*node*/) override
+			{
+				hasImports = true;
+			}
+
+			F& callback;
+			bool hasImports = false;
+		};
+
+		OptionLister optionLister(callback);
+		for (const auto& importedModule : module.importedModules)
+			importedModule.module->rootNode->Visit(optionLister);
+
+		module.rootNode->Visit(optionLister);
+
+		return !optionLister.hasImports;
+	}
+
+	// Options declared by a module and the modules it imports, only their values can change the output of a permutation
+	// Returns nothing if the module still has imports to resolve, as they may declare other options
+	inline std::optional<std::vector<Ast::OptionHash>> ListDeclaredOptions(Ast::Module& module)
+	{
+		std::vector<Ast::OptionHash> optionHashes;
+		bool hasAllOptions = ForEachDeclaredOption(module, [&](const Ast::DeclareOptionStatement& declOption)
+		{
+			optionHashes.push_back(Ast::HashOption(declOption.optName.data()));
+		});
+
+		if (!hasAllOptions)
+			return std::nullopt;
+
+		std::sort(optionHashes.begin(), optionHashes.end());
+		optionHashes.erase(std::unique(optionHashes.begin(), optionHashes.end()), optionHashes.end());
+
+		return optionHashes;
+	}
+
+	// Option kept in a fully transformed module, waiting for its value
+	struct KeptOption
+	{
+		Ast::ConstantValue defaultValue;
+		Ast::ExpressionType type;
+	};
+
+	using KeptOptions = std::unordered_map<Ast::OptionHash, KeptOption>;
+
+	// Fully resolves and transforms the module once for all permutations while keeping its options, so each permutation only has to replace them by their value
+	// This is only possible if all options have a default value and none of them is used at compile time (const if, array sizes, ...), returns nullptr otherwise
+	template<typename RunPassesFunc>
+	Ast::ModulePtr TransformKeepingOptions(Ast::Module& module, const std::vector<Ast::OptionHash>& declaredOptions, const BackendParameters& parameters, RunPassesFunc& runPasses, KeptOptions& keptOptions)
+	{
+		if (!parameters.backendPasses.Test(BackendPass::Resolve) || !parameters.backendPasses.Test(BackendPass::TargetRequired))
+			return nullptr;
+
+		// The partial resolve already knows which options are used at compile time, their default value would be baked in the module
+		bool canKeepOptions = true;
+		ForEachDeclaredOption(module, [&](const Ast::DeclareOptionStatement& declOption)
+		{
+			if (!declOption.defaultValue || declOption.isCompileTimeUsed)
+				canKeepOptions = false;
+		});
+
+		if (!canKeepOptions)
+			return nullptr;
+
+		// Option values are substituted before propagating constants and removing dead code, which then happen for each permutation
+		BackendParameters transformParameters = parameters;
+		transformParameters.optionValues.clear();
+		transformParameters.backendPasses &= ~(BackendPass::Optimize | BackendPass::RemoveDeadCode);
+
+		Ast::ModulePtr transformedModule = Ast::Clone(module);
+		try
+		{
+			runPasses(*transformedModule, transformParameters, true);
+		}
+		catch (const std::exception&)
+		{
+			// Default values may not compile while other permutations do, let each permutation be compiled on its own
+			return nullptr;
+		}
+
+		keptOptions.clear();
+		ForEachDeclaredOption(*transformedModule, [&](const Ast::DeclareOptionStatement& declOption)
+		{
+			if (!declOption.defaultValue || declOption.defaultValue->GetType() != Ast::NodeType::ConstantValueExpression || !declOption.optType.IsResultingValue())
+				return;
+
+			// Options renamed by the backend (reserved identifiers) can no longer be found by their hash
+			Ast::OptionHash optionHash = Ast::HashOption(declOption.optName.data());
+			if (!std::binary_search(declaredOptions.begin(), declaredOptions.end(), optionHash))
+				return;
+
+			const auto& defaultValue = static_cast<const Ast::ConstantValueExpression&>(*declOption.defaultValue).value;
+			keptOptions.insert_or_assign(optionHash, KeptOption{ Ast::ToConstantValue(defaultValue), declOption.optType.GetResultingValue() });
+		});
+
+		// Options found to be used at compile time by the full resolve had their default value baked in
+		if (keptOptions.size() != declaredOptions.size())
+			return nullptr;
+
+		return transformedModule;
+	}
+
+	// Resolves the module once, then transforms (runPasses) and generates code (generate) for each distinct permutation:
+	// - if options are only used at runtime, the module is fully transformed once and permutations only replace options by their value before propagating constants and removing dead code
+	// - otherwise, it is partially resolved once and each permutation goes through the resolve pass and the passes depending on it
+	// - permutations giving the same values to the options the module declares are the same shader and only transformed once
+	// - transformed modules which end up identical (e.g. options only used in removed branches) only have their code generated once
+	// runPasses takes a third parameter telling if scalar options without a value must be kept in the module (as with BackendPass::SpecializationConstants),
+	// keepUnsetOptions tells if the backend keeps them in permutations as well (instead of using their default value)
+	template<typename T, typename RunPassesFunc, typename GenerateFunc>
+	PermutationOutputs<T> GeneratePermutations(const Ast::Module& module, const std::vector<OptionValues>& optionPermutations, const BackendParameters& parameters, bool keepUnsetOptions, RunPassesFunc&& runPasses, GenerateFunc&& generate)
+	{
+		// Passes are applied to a copy, leaving the caller module untouched
+		Ast::ModulePtr sharedModule = Ast::Clone(module);
+
+		// Everything not depending on option values (imports, types, functions, ...) is resolved once for all permutations,
+		// partial compilation leaves option-dependent parts to the resolve pass of each permutation
+		if (parameters.backendPasses.Test(BackendPass::Resolve))
+		{
+			Ast::TransformerExecutor executor;
+			executor.SetInstrumentation(parameters.passInstrumentation);
+
+			executor.AddPass<Ast::ResolveTransformer>([&](Ast::ResolveTransformer::Options& opt)
+			{
+				opt.moduleResolver = parameters.shaderModuleResolver;
+				opt.resolvedModuleCache = parameters.resolvedModuleCache;
+			});
+
+			Ast::TransformerContext context;
+			context.partialCompilation = true;
+
+			executor.Transform(*sharedModule, context);
+		}
+
+		std::optional<std::vector<Ast::OptionHash>> declaredOptions = ListDeclaredOptions(*sharedModule);
+
+		KeptOptions keptOptions;
+		Ast::ModulePtr transformedModule;
+		if (declaredOptions)
+			transformedModule = TransformKeepingOptions(*sharedModule, *declaredOptions, parameters, runPasses, keptOptions);
+
+		BackendParameters permutationParameters = parameters;
+
+		// Only constants propagation and dead code removal are left for permutations of the transformed module
+		BackendParameters optimizationParameters = parameters;
+		optimizationParameters.backendPasses &= BackendPass::Optimize | BackendPass::RemoveDeadCode;
+
+		// Permutation modules are transformed before generation, only code generation flags are left
+		BackendParameters generationParameters = parameters;
+		generationParameters.backendPasses &= ~(BackendPass::Optimize | BackendPass::RemoveDeadCode | BackendPass::Resolve | BackendPass::TargetRequired | BackendPass::Validate);
+
+		// Returns the values replacing the kept options, or nothing if a value doesn't have the type of its option (the resolve pass has to convert it)
+		auto BuildKeptOptionValues = [&](const OptionValues& optionValues) -> std::optional<OptionValues>
+		{
+			OptionValues keptOptionValues;
+			for (auto&& [optionHash, keptOption] : keptOptions)
+			{
+				auto it = optionValues.find(optionHash);
+				if (it != optionValues.end())
+				{
+					if (!(Ast::GetConstantType(it->second) == keptOption.type))
+						return std::nullopt;
+
+					keptOptionValues.emplace(optionHash, it->second);
+				}
+				else if (!keepUnsetOptions)
+					keptOptionValues.emplace(optionHash, keptOption.defaultValue);
+			}
+
+			return keptOptionValues;
+		};
+
+		struct OptionSet
+		{
+			std::vector<std::optional<Ast::ConstantValue>> values; //< value of each declared option
+			std::size_t outputIndex;
+		};
+
+		std::unordered_multimap<std::size_t /*valuesHash*/, std::size_t /*optionSetIndex*/> optionSetByHash;
+		std::vector<OptionSet> optionSets;
+
+		// Modules sharing a hash are compared, as different modules can collide
+		std::unordered_multimap<std::size_t /*moduleHash*/, std::size_t /*outputIndex*/> outputByHash;
+		std::vector<Ast::ModulePtr> outputModules;
+
+		PermutationOutputs<T> permutationOutputs;
+		permutationOutputs.outputIndices.reserve(optionPermutations.size());
+		for (const OptionValues& optionValues : optionPermutations)
+		{
+			std::optional<std::size_t> outputIndex;
+
+			std::vector<std::optional<Ast::ConstantValue>> declaredValues;
+			std::size_t valuesHash = 0;
+			if (declaredOptions)
+			{
+				declaredValues.reserve(declaredOptions->size());
+				for (Ast::OptionHash optionHash : *declaredOptions)
+				{
+					auto it = optionValues.find(optionHash);
+					if (it != optionValues.end())
+					{
+						Nz::HashCombine(valuesHash, true);
+						Ast::Hash(valuesHash, it->second, Ast::ComparisonParams{});
+
+						declaredValues.emplace_back(it->second);
+					}
+					else
+					{
+						Nz::HashCombine(valuesHash, false);
+						declaredValues.emplace_back();
+					}
+				}
+
+				auto [begin, end] = optionSetByHash.equal_range(valuesHash);
+				for (auto it = begin; it != end; ++it)
+				{
+					const OptionSet& optionSet = optionSets[it->second];
+					if (optionSet.values == declaredValues)
+					{
+						outputIndex = optionSet.outputIndex;
+						break;
+					}
+				}
+			}
+
+			if (!outputIndex)
+			{
+				Ast::ModulePtr permutationModule;
+
+				std::optional<OptionValues> keptOptionValues;
+				if (transformedModule)
+					keptOptionValues = BuildKeptOptionValues(optionValues);
+
+				if (keptOptionValues)
+				{
+					permutationModule = Ast::Clone(*transformedModule);
+
+					Ast::TransformerExecutor executor;
+					executor.SetInstrumentation(parameters.passInstrumentation);
+
+					executor.AddPass<Ast::ConstantRemovalTransformer>([](Ast::ConstantRemovalTransformer::Options& opt)
+					{
+						opt.replaceOptionsOnly = true;
+					});
+
+					Ast::TransformerContext context;
+					context.optionValues = std::move(*keptOptionValues);
+
+					executor.Transform(*permutationModule, context);
+
+					runPasses(*permutationModule, optimizationParameters, false);
+				}
+				else
+				{
+					permutationModule = Ast::Clone(*sharedModule);
+
+					permutationParameters.optionValues = optionValues;
+					runPasses(*permutationModule, permutationParameters, false);
+				}
+
+				std::size_t moduleHash = Ast::Hash(*permutationModule);
+
+				auto [begin, end] = outputByHash.equal_range(moduleHash);
+				for (auto it = begin; it != end; ++it)
+				{
+					if (Ast::Compare(*outputModules[it->second], *permutationModule))
+					{
+						outputIndex = it->second;
+						break;
+					}
+				}
+
+				if (!outputIndex)
+				{
+					outputIndex = permutationOutputs.outputs.size();
+					outputByHash.emplace(moduleHash, *outputIndex);
+
+					permutationOutputs.outputs.push_back(generate(*permutationModule, generationParameters));
+					outputModules.push_back(std::move(permutationModule));
+				}
+
+				if (declaredOptions)
+				{
+					optionSetByHash.emplace(valuesHash, optionSets.size());
+					optionSets.push_back({ std::move(declaredValues), *outputIndex });
+				}
+			}
+
+			permutationOutputs.outputIndices.push_back(*outputIndex);
+		}
+
+		return permutationOutputs;
+	}
+}
+
+#endif // NZSL_PERMUTATIONUTILS_HPP
@@ -8,14 +8,168 @@
 #include <NazaraUtils/StackArray.hpp>
 #include <NazaraUtils/StackVector.hpp>
 #include <NZSL/SpirvWriter.hpp>
+#include <NZSL/Ast/RecursiveVisitor.hpp>
 #include <NZSL/SpirV/SpirvExpressionLoad.hpp>
 #include <NZSL/SpirV/SpirvExpressionStore.hpp>
 #include <NZSL/SpirV/SpirvGenData.hpp>
 #include <NZSL/SpirV/SpirvSection.hpp>
 #include <fmt/format.h>
+#include <algorithm>
+#include <numeric>
+#include <utility>
 
 namespace nzsl
 {
+	namespace
+	{
+		// Finds the local scalar and vector variables which are never accessed through a pointer (and can be kept as SSA values)
+		// along with the variables stored inside each loop, which need a OpPhi in the loop header
+		class VariablePromotionAnalyzer : public Ast::RecursiveVisitor
+		{
+			public:
+				void Analyze(Ast::DeclareFunctionStatement& node, std::unordered_set<std::size_t>& promotedVariables, std::unordered_map<const Ast::WhileStatement*, std::vector<std::size_t>>& loopStoredVariables)
+				{
+					for (auto& statement : node.statements)
+						statement->Visit(*this);
+
+					promotedVariables.clear();
+					for (std::size_t varIndex : m_candidateVariables)
+					{
+						if (m_addressTakenVariables.find(varIndex) == m_addressTakenVariables.end())
+							promotedVariables.insert(varIndex);
+					}
+
+					loopStoredVariables.clear();
+					for (auto&& [loop, storedVariables] : m_loopStoredVariables)
+					{
+						std::vector<std::size_t>& loopVariables = loopStoredVariables[loop];
+						for (std::size_t varIndex : storedVariables)
+						{
+							if (promotedVariables.find(varIndex) != promotedVariables.end())
+								loopVariables.push_back(varIndex);
+						}
+
+						// Keep OpPhi order deterministic
+						std::sort(loopVariables.begin(), loopVariables.end());
+					}
+				}
+
+				using RecursiveVisitor::Visit;
+
+				void Visit(Ast::AccessIndexExpression& node) override
+				{
+					// Values cannot be indexed dynamically
+					MarkAddressTaken(*node.expr);
+
+					RecursiveVisitor::Visit(node);
+				}
+
+				void Visit(Ast::AssignExpression& node) override
+				{
+					HandleStore(*node.left);
+
+					RecursiveVisitor::Visit(node);
+				}
+
+				void Visit(Ast::CallFunctionExpression& node) override
+				{
+					for (auto& parameter : node.parameters)
+					{
+						if (parameter.semantic != Ast::FunctionParameterSemantic::In)
+							HandleStore(*parameter.expr);
+					}
+
+					RecursiveVisitor::Visit(node);
+				}
+
+				void Visit(Ast::DeclareVariableStatement& node) override
+				{
+					const Ast::ExpressionType& varType = node.varType.GetResultingValue();
+					if ((IsPrimitiveType(varType) && std::get<Ast::PrimitiveType>(varType) != Ast::PrimitiveType::String) || IsVectorType(varType))
+					{
+						assert(node.varIndex);
+						m_candidateVariables.push_back(*node.varIndex);
+					}
+
+					RecursiveVisitor::Visit(node);
+				}
+
+				void Visit(Ast::WhileStatement& node) override
+				{
+					m_loopStack.push_back(&node);
+					RecursiveVisitor::Visit(node);
+					m_loopStack.pop_back();
+				}
+
+			private:
+				void HandleStore(Ast::Expression& target)
+				{
+					// Stores to a variable or to a swizzle of a vector variable can be done on values
+					Ast::Expression* storedExpr = &target;
+					if (storedExpr->GetType() == Ast::NodeType::SwizzleExpression)
+					{
+						auto& swizzle = Nz::SafeCast<Ast::SwizzleExpression&>(*storedExpr);
+						const Ast::ExpressionType* swizzledType = GetExpressionType(*swizzle.expression);
+						if (swizzledType && IsVectorType(*swizzledType))
+							storedExpr = swizzle.expression.get();
+					}
+
+					if (storedExpr->GetType() == Ast::NodeType::IdentifierValueExpression)
+					{
+						auto& identifier = Nz::SafeCast<Ast::IdentifierValueExpression&>(*storedExpr);
+						if (identifier.identifierType == Ast::IdentifierType::Variable)
+						{
+							for (const Ast::WhileStatement* loop : m_loopStack)
+								m_loopStoredVariables[loop].insert(identifier.identifierIndex);
+
+							return;
+						}
+					}
+
+					MarkAddressTaken(target);
+				}
+
+				void MarkAddressTaken(Ast::Expression& expr)
+				{
+					Ast::Expression* rootExpr = &expr;
+					for (;;)
+					{
+						switch (rootExpr->GetType())
+						{
+							case Ast::NodeType::AccessFieldExpression:
+								rootExpr = Nz::SafeCast<Ast::AccessFieldExpression&>(*rootExpr).expr.get();
+								continue;
+
+							case Ast::NodeType::AccessIndexExpression:
+								rootExpr = Nz::SafeCast<Ast::AccessIndexExpression&>(*rootExpr).expr.get();
+								continue;
+
+							case Ast::NodeType::SwizzleExpression:
+								rootExpr = Nz::SafeCast<Ast::SwizzleExpression&>(*rootExpr).expression.get();
+								continue;
+
+							case Ast::NodeType::IdentifierValueExpression:
+							{
+								auto& identifier = Nz::SafeCast<Ast::IdentifierValueExpression&>(*rootExpr);
+								if (identifier.identifierType == Ast::IdentifierType::Variable)
+									m_addressTakenVariables.insert(identifier.identifierIndex);
+
+								return;
+							}
+
+							default:
+								return;
+						}
+					}
+				}
+
+				std::unordered_map<const Ast::WhileStatement*, std::unordered_set<std::size_t>> m_loopStoredVariables;
+				std::unordered_set<std::size_t> m_addressTakenVariables;
+				std::vector<const Ast::WhileStatement*> m_loopStack;
+				std::vector<std::size_t> m_candidateVariables;
+		};
+	}
+
 	std::uint32_t SpirvAstVisitor::AllocateResultId()
 	{
 		return m_writer.AllocateResultId();
@@ -78,8 +232,7 @@ namespace nzsl
 
 		HandleSourceLocation(node.sourceLocation);
 
-		SpirvExpressionStore storeVisitor(m_writer, *this, *m_currentBlock);
-		storeVisitor.Store(node.left, resultId);
+		StoreExpression(node.left, resultId);
 
 		PushResultId(resultId);
 	}
@@ -495,13 +648,21 @@ namespace nzsl
 		// FIXME: Can we use merge block directly in OpBranchConditional if no else statement?
 		m_currentBlock->Append(SpirvOp::OpBranchConditional, conditionId, contentBlock->GetLabelId(), elseBlock->GetLabelId());
 
+		PromotedValues entryValues = m_promotedValues;
+		std::vector<PromotedValuesEdge> mergeEdges;
+
 		m_functionBlocks.emplace_back(std::move(contentBlock));
 		m_currentBlock = m_functionBlocks.back().get();
 
 		condStatement.statement->Visit(*this);
 
 		if (!m_currentBlock->IsTerminated())
+		{
+			mergeEdges.push_back({ m_currentBlock->GetLabelId(), m_promotedValues });
 			m_currentBlock->Append(SpirvOp::OpBranch, mergeBlock->GetLabelId());
+		}
+
+		m_promotedValues = entryValues;
 
 		m_functionBlocks.emplace_back(std::move(elseBlock));
 		m_currentBlock = m_functionBlocks.back().get();
@@ -510,10 +671,19 @@ namespace nzsl
 			node.elseStatement->Visit(*this);
 
 		if (!m_currentBlock->IsTerminated())
+		{
+			mergeEdges.push_back({ m_currentBlock->GetLabelId(), m_promotedValues });
 			m_currentBlock->Append(SpirvOp::OpBranch, mergeBlock->GetLabelId());
+		}
 
 		m_functionBlocks.emplace_back(std::move(mergeBlock));
 		m_currentBlock = m_functionBlocks.back().get();
+
+		// The merge block is unreachable if both branches were terminated, values from before the branch still dominate it
+		if (!mergeEdges.empty())
+			MergePromotedValues(mergeEdges);
+		else
+			m_promotedValues = std::move(entryValues);
 	}
 
 	void SpirvAstVisitor::Visit(Ast::BreakStatement& node)
@@ -523,6 +693,9 @@ namespace nzsl
 
 		HandleSourceLocation(node.sourceLocation);
 
+		if (m_breakEdges)
+			m_breakEdges->push_back({ m_currentBlock->GetLabelId(), m_promotedValues });
+
 		m_currentBlock->Append(SpirvOp::OpBranch, *m_breakTarget);
 	}
 
@@ -579,8 +752,7 @@ namespace nzsl
 
 			std::uint32_t paramResultId = AllocateResultId();
 			m_currentBlock->Append(SpirvOp::OpLoad, targetFunc.parameters[i].typeId, paramResultId, parameterIds[i]);
-			SpirvExpressionStore storeVisitor(m_writer, *this, *m_currentBlock);
-			storeVisitor.Store(node.parameters[i].expr, paramResultId);
+			StoreExpression(node.parameters[i].expr, paramResultId);
 		}
 
 		PushResultId(resultId);
@@ -801,6 +973,9 @@ namespace nzsl
 
 		HandleSourceLocation(node.sourceLocation);
 
+		if (m_continueEdges)
+			m_continueEdges->push_back({ m_currentBlock->GetLabelId(), m_promotedValues });
+
 		m_currentBlock->Append(SpirvOp::OpBranch, *m_continueTarget);
 	}
 
@@ -820,6 +995,26 @@ namespace nzsl
 		m_currentFunc = &m_functionRetriever(*node.funcIndex);
 		m_funcCallIndex = 0;
 
+		m_promotedValues.clear();
+		if (m_writer.m_context.parameters->backendPasses.Test(BackendPass::PromoteVariables))
+		{
+			VariablePromotionAnalyzer promotionAnalyzer;
+			promotionAnalyzer.Analyze(node, m_promotedVariables, m_loopStoredVariables);
+
+			for (std::size_t varIndex : m_promotedVariables)
+			{
+				auto varIt = m_currentFunc->varIndexToVarId.find(varIndex);
+				assert(varIt != m_currentFunc->varIndexToVarId.end());
+
+				m_currentFunc->variables[varIt->second].isPromoted = true;
+			}
+		}
+		else
+		{
+			m_promotedVariables.clear();
+			m_loopStoredVariables.clear();
+		}
+
 		HandleSourceLocation(node.sourceLocation);
 
 		m_instructions.Append(SpirvOp::OpFunction, m_currentFunc->returnTypeId, m_currentFunc->funcId, 0, m_currentFunc->funcTypeId);
@@ -852,6 +1047,9 @@ namespace nzsl
 
 		for (auto& var : m_currentFunc->variables)
 		{
+			if (var.isPromoted)
+				continue;
+
 			HandleSourceLocation(var.sourceLocation);
 
 			var.varId = m_writer.AllocateResultId();
@@ -907,6 +1105,21 @@ namespace nzsl
 		std::uint32_t typeId = m_writer.GetTypeId(*typePtr);
 
 		assert(node.varIndex);
+		if (m_promotedVariables.find(*node.varIndex) != m_promotedVariables.end())
+		{
+			std::uint32_t valueId;
+			if (node.initialExpression)
+				valueId = EvaluateExpression(*node.initialExpression);
+			else
+			{
+				valueId = m_writer.AllocateResultId();
+				m_currentBlock->Append(SpirvOp::OpUndef, typeId, valueId);
+			}
+
+			m_promotedValues[*node.varIndex] = PromotedValue{ typeId, valueId };
+			return;
+		}
+
 		auto varIt = m_currentFunc->varIndexToVarId.find(*node.varIndex);
 		std::uint32_t varId = m_currentFunc->variables[varIt->second].varId;
 
@@ -957,6 +1170,13 @@ namespace nzsl
 
 			case Ast::IdentifierType::Variable:
 			{
+				if (auto it = m_promotedValues.find(node.identifierIndex); it != m_promotedValues.end())
+				{
+					assert(!m_isEvaluatingPointer);
+					PushResultId(it->second.valueId);
+					break;
+				}
+
 				SpirvExpressionLoad loadVisitor(m_writer, *this, *m_currentBlock);
 				PushResultId((m_isEvaluatingPointer) ? loadVisitor.EvaluatePointer(node) : loadVisitor.EvaluateValue(node));
 				break;
@@ -1251,9 +1471,40 @@ namespace nzsl
 
 		HandleSourceLocation(node.sourceLocation);
 
+		std::uint32_t preheaderLabelId = m_currentBlock->GetLabelId();
+		std::uint32_t continueLabelId = continueBlock->GetLabelId();
+
 		m_currentBlock->Append(SpirvOp::OpBranch, headerBlock->GetLabelId());
 		m_currentBlock = headerBlock.get();
 
+		// Promoted variables stored in the loop get a OpPhi in the header, their value coming back from the continue block is defined by a OpPhi there
+		struct LoopCarriedValue
+		{
+			std::size_t varIndex;
+			std::uint32_t typeId;
+			std::uint32_t continueValueId;
+		};
+
+		std::vector<LoopCarriedValue> loopCarriedValues;
+		if (auto it = m_loopStoredVariables.find(&node); it != m_loopStoredVariables.end())
+		{
+			for (std::size_t varIndex : it->second)
+			{
+				auto valueIt = m_promotedValues.find(varIndex);
+				if (valueIt == m_promotedValues.end())
+					continue; //< declared inside the loop
+
+				PromotedValue& promotedValue = valueIt->second;
+
+				std::uint32_t phiId = m_writer.AllocateResultId();
+				std::uint32_t continueValueId = m_writer.AllocateResultId();
+				m_currentBlock->Append(SpirvOp::OpPhi, promotedValue.typeId, phiId, promotedValue.valueId, preheaderLabelId, continueValueId, continueLabelId);
+
+				promotedValue.valueId = phiId;
+				loopCarriedValues.push_back({ varIndex, promotedValue.typeId, continueValueId });
+			}
+		}
+
 		std::uint32_t expressionId = EvaluateExpression(*node.condition);
 
 		SpirvLoopControl loopControl = [&]
@@ -1283,12 +1534,18 @@ namespace nzsl
 		m_currentBlock->Append(SpirvOp::OpBranchConditional, expressionId, bodyBlock->GetLabelId(), mergeBlock->GetLabelId());
 
 		std::uint32_t headerLabelId = headerBlock->GetLabelId();
-		std::uint32_t continueLabelId = continueBlock->GetLabelId();
+
+		std::vector<PromotedValuesEdge> breakEdges;
+		std::vector<PromotedValuesEdge> continueEdges;
+		breakEdges.push_back({ headerLabelId, m_promotedValues });
 
 		m_currentBlock = bodyBlock.get();
 		m_functionBlocks.emplace_back(std::move(headerBlock));
 		m_functionBlocks.emplace_back(std::move(bodyBlock));
 
+		std::vector<PromotedValuesEdge>* previousBreakEdges = std::exchange(m_breakEdges, &breakEdges);
+		std::vector<PromotedValuesEdge>* previousContinueEdges = std::exchange(m_continueEdges, &continueEdges);
+
 		m_breakTarget = mergeBlock->GetLabelId();
 		m_continueTarget = continueLabelId;
 		{
@@ -1297,15 +1554,49 @@ namespace nzsl
 		m_breakTarget = std::nullopt;
 		m_continueTarget = std::nullopt;
 
+		m_breakEdges = previousBreakEdges;
+		m_continueEdges = previousContinueEdges;
+
+		// Jump to continue block
+		if (!m_currentBlock->IsTerminated())
+		{
+			continueEdges.push_back({ m_currentBlock->GetLabelId(), m_promotedValues });
+			m_currentBlock->Append(SpirvOp::OpBranch, continueLabelId);
+		}
+
+		for (const LoopCarriedValue& loopCarriedValue : loopCarriedValues)
+		{
+			// The continue block is unreachable if every path of the body leaves the loop
+			if (continueEdges.empty())
+			{
+				continueBlock->Append(SpirvOp::OpUndef, loopCarriedValue.typeId, loopCarriedValue.continueValueId);
+				continue;
+			}
+
+			continueBlock->AppendVariadic(SpirvOp::OpPhi, [&](const auto& appender)
+			{
+				appender(loopCarriedValue.typeId);
+				appender(loopCarriedValue.continueValueId);
+
+				for (const PromotedValuesEdge& edge : continueEdges)
+				{
+					auto valueIt = edge.values.find(loopCarriedValue.varIndex);
+					assert(valueIt != edge.values.end());
+
+					appender(valueIt->second.valueId);
+					appender(edge.predecessorLabelId);
+				}
+			});
+		}
+
 		// Continue block sole purpose is to jump back to the header block
 		continueBlock->Append(SpirvOp::OpBranch, headerLabelId);
 		m_functionBlocks.emplace_back(std::move(continueBlock));
 
-		// Jump to continue block
-		m_currentBlock->Append(SpirvOp::OpBranch, continueLabelId);
-
 		m_functionBlocks.emplace_back(std::move(mergeBlock));
 		m_currentBlock = m_functionBlocks.back().get();
+
+		MergePromotedValues(breakEdges);
 	}
 
 	void SpirvAstVisitor::BuildArraySizeIntrinsic(const Ast::IntrinsicExpression& node)
@@ -1578,13 +1869,13 @@ namespace nzsl
 		if (!m_writer.HasDebugInfo(DebugLevel::Regular))
 			return;
 
-		if (!sourceLocation.IsValid() || !sourceLocation.file)
+		if (!sourceLocation.IsValid() || sourceLocation.fileIndex == 0)
 			return;
 
-		if (m_lastLocation.file == sourceLocation.file && m_lastLocation.startLine == sourceLocation.startLine && m_lastLocation.startColumn == sourceLocation.startColumn)
+		if (m_lastLocation.fileIndex == sourceLocation.fileIndex && m_lastLocation.startLine == sourceLocation.startLine && m_lastLocation.startColumn == sourceLocation.startColumn)
 			return;
 
-		std::uint32_t fileId = m_writer.GetSourceFileId(sourceLocation.file);
+		std::uint32_t fileId = m_writer.GetSourceFileId(sourceLocation.fileIndex);
 
 		if (m_currentBlock)
 			m_currentBlock->Append(SpirvOp::OpLine, fileId, sourceLocation.startLine, sourceLocation.startColumn);
@@ -1605,6 +1896,62 @@ namespace nzsl
 		}
 	}
 
+	void SpirvAstVisitor::MergePromotedValues(const std::vector<PromotedValuesEdge>& edges)
+	{
+		assert(!edges.empty());
+
+		// Only variables alive on every incoming edge are still in scope
+		std::vector<std::size_t> varIndices;
+		for (const auto& valuePair : edges.front().values)
+		{
+			std::size_t varIndex = valuePair.first;
+			bool isAlive = std::all_of(edges.begin() + 1, edges.end(), [&](const PromotedValuesEdge& edge)
+			{
+				return edge.values.find(varIndex) != edge.values.end();
+			});
+
+			if (isAlive)
+				varIndices.push_back(varIndex);
+		}
+
+		// Keep OpPhi order deterministic
+		std::sort(varIndices.begin(), varIndices.end());
+
+		PromotedValues mergedValues;
+		for (std::size_t varIndex : varIndices)
+		{
+			const PromotedValue& firstValue = edges.front().values.at(varIndex);
+
+			bool isSameValue = std::all_of(edges.begin() + 1, edges.end(), [&](const PromotedValuesEdge& edge)
+			{
+				return edge.values.at(varIndex).valueId == firstValue.valueId;
+			});
+
+			if (isSameValue)
+			{
+				mergedValues.emplace(varIndex, firstValue);
+				continue;
+			}
+
+			std::uint32_t phiId = m_writer.AllocateResultId();
+			m_currentBlock->AppendVariadic(SpirvOp::OpPhi, [&](const auto& appender)
+			{
+				appender(firstValue.typeId);
+				appender(phiId);
+
+				for (const PromotedValuesEdge& edge : edges)
+				{
+					appender(edge.values.at(varIndex).valueId);
+					appender(edge.predecessorLabelId);
+				}
+			});
+
+			mergedValues.emplace(varIndex, PromotedValue{ firstValue.typeId, phiId });
+		}
+
+		m_promotedValues = std::move(mergedValues);
+	}
+
 	void SpirvAstVisitor::PushResultId(std::uint32_t value)
 	{
 		m_resultIds.push_back(value);
@@ -1634,4 +1981,73 @@ namespace nzsl
 
 		m_lastLocation = SourceLocation{};
 	}
+
+	void SpirvAstVisitor::StoreExpression(Ast::ExpressionPtr& target, std::uint32_t valueId)
+	{
+		auto FindPromotedValue = [&](Ast::Expression& expr) -> PromotedValue*
+		{
+			if (expr.GetType() != Ast::NodeType::IdentifierValueExpression)
+				return nullptr;
+
+			auto& identifier = Nz::SafeCast<Ast::IdentifierValueExpression&>(expr);
+			if (identifier.identifierType != Ast::IdentifierType::Variable)
+				return nullptr;
+
+			auto it = m_promotedValues.find(identifier.identifierIndex);
+			if (it == m_promotedValues.end())
+				return nullptr;
+
+			return &it->second;
+		};
+
+		if (PromotedValue* promotedValue = FindPromotedValue(*target))
+		{
+			promotedValue->valueId = valueId;
+			return;
+		}
+
+		if (target->GetType() == Ast::NodeType::SwizzleExpression)
+		{
+			auto& swizzle = Nz::SafeCast<Ast::SwizzleExpression&>(*target);
+			if (PromotedValue* promotedValue = FindPromotedValue(*swizzle.expression))
+			{
+				// Build a new vector from the current value and the stored components
+				std::uint32_t resultId = m_writer.AllocateResultId();
+				if (swizzle.componentCount > 1)
+				{
+					const Ast::ExpressionType* vecType = GetExpressionType(*swizzle.expression);
+					assert(vecType && IsVectorType(*vecType));
+
+					std::size_t vectorSize = std::get<Ast::VectorType>(*vecType).componentCount;
+
+					Nz::StackArray<std::uint32_t> indices = NazaraStackArrayNoInit(std::uint32_t, vectorSize);
+					std::iota(indices.begin(), indices.end(), std::uint32_t(0u)); //< init with regular swizzle (0,1,2,3)
+
+					// override with swizzle components
+					for (std::size_t i = 0; i < swizzle.componentCount; ++i)
+						indices[swizzle.components[i]] = Nz::SafeCast<std::uint32_t>(vectorSize + i);
+
+					m_currentBlock->AppendVariadic(SpirvOp::OpVectorShuffle, [&](const auto& appender)
+					{
+						appender(promotedValue->typeId);
+						appender(resultId);
+
+						appender(promotedValue->valueId);
+						appender(valueId);
+
+						for (std::uint32_t index : indices)
+							appender(index);
+					});
+				}
+				else
+					m_currentBlock->Append(SpirvOp::OpCompositeInsert, promotedValue->typeId, resultId, valueId, promotedValue->valueId, swizzle.components[0]);
+
+				promotedValue->valueId = resultId;
+				return;
+			}
+		}
+
+		SpirvExpressionStore storeVisitor(m_writer, *this, *m_currentBlock);
+		storeVisitor.Store(target, valueId);
+	}
 }
@@ -11,6 +11,7 @@
 #include <tsl/ordered_map.h>
 #include <cassert>
 #include <stdexcept>
+#include <unordered_set>
 
 namespace nzsl
 {
@@ -66,6 +67,11 @@ namespace nzsl
 			return lhs.value == rhs.value;
 		}
 
+		bool Compare(const ConstantSpec& lhs, const ConstantSpec& rhs) const
+		{
+			return lhs.specId == rhs.specId && Compare(lhs.defaultValue, rhs.defaultValue);
+		}
+
 		bool Compare(const Array& lhs, const Array& rhs) const
 		{
 			return Compare(lhs.length, rhs.length) && Compare(lhs.elementType, rhs.elementType) && lhs.stride == rhs.stride;
@@ -179,12 +185,12 @@ namespace nzsl
 
 		bool Compare(const Constant& lhs, const Constant& rhs) const
 		{
-			return Compare(lhs.constant, rhs.constant);
+			return lhs.hash == rhs.hash && Compare(lhs.constant, rhs.constant);
 		}
 
 		bool Compare(const Type& lhs, const Type& rhs) const
 		{
-			return Compare(lhs.type, rhs.type);
+			return lhs.hash == rhs.hash && Compare(lhs.type, rhs.type);
 		}
 
 
@@ -203,12 +209,20 @@ namespace nzsl
 		template<typename T>
 		bool Compare(const std::shared_ptr<T>& lhs, const std::shared_ptr<T>& rhs) const
 		{
+			// Interned nodes are equal if and only if they are the same
+			if (lhs == rhs)
+				return true;
+
 			if (bool(lhs) != bool(rhs))
 				return false;
 
 			if (!lhs)
 				return true;
 
+			if (lhs->owner && lhs->owner == rhs->owner)
+				return false;
+
+			// Nodes built outside the cache
 			return Compare(*lhs, *rhs);
 		}
 
@@ -336,7 +350,7 @@ namespace nzsl
 
 		void Register(const ConstantBool&)
 		{
-			cache.Register(Type{ Bool{} });
+			cache.Register(*cache.InternType(Bool{}));
 		}
 
 		void Register(const ConstantScalar& scalar)
@@ -345,7 +359,7 @@ namespace nzsl
 			{
 				using T = std::decay_t<decltype(arg)>;
 
-				cache.Register(BuildSingleType<T>());
+				cache.Register(*cache.BuildSingleType<T>());
 			}, scalar.value);
 		}
 
@@ -361,6 +375,13 @@ namespace nzsl
 			}
 		}
 
+		void Register(const ConstantSpec& spec)
+		{
+			// only the type is required, the default value is written inline
+			assert(spec.defaultValue);
+			Register(spec.defaultValue->constant);
+		}
+
 
 		void Register(const Constant& c)
 		{
@@ -474,6 +495,11 @@ namespace nzsl
 			return ComputeHash(constant.value);
 		}
 
+		std::size_t operator()(const ConstantSpec& constant) const
+		{
+			return ComputeHash(constant.defaultValue, constant.specId);
+		}
+
 		std::size_t operator()(const Array& type) const
 		{
 			return ComputeHash(type.elementType, type.length, type.stride);
@@ -547,12 +573,12 @@ namespace nzsl
 
 		std::size_t operator()(const Constant& constant) const
 		{
-			return ComputeHash(constant.constant);
+			return constant.hash;
 		}
 
 		std::size_t operator()(const Type& type) const
 		{
-			return ComputeHash(type.type);
+			return type.hash;
 		}
 
 
@@ -571,7 +597,7 @@ namespace nzsl
 			if (!ptr)
 				return 0;
 
-			return ComputeHash(*ptr);
+			return ptr->hash;
 		}
 
 		template<typename... T>
@@ -623,6 +649,8 @@ namespace nzsl
 		std::vector<Source> debugSources;
 		tsl::ordered_map<std::string, std::uint32_t /*id*/, std::hash<std::string_view>, std::equal_to<>> debugStrings;
 		tsl::ordered_map<std::variant<AnyConstant, AnyType>, std::uint32_t /*id*/, Hash, Eq> ids;
+		std::unordered_set<ConstantPtr, Hash, Eq> internedConstants;
+		std::unordered_set<TypePtr, Hash, Eq> internedTypes;
 		std::vector<std::pair<Variable, std::uint32_t /*id*/>> variables;
 		StructCallback structCallback;
 		std::uint32_t& nextResultId;
@@ -639,7 +667,7 @@ namespace nzsl
 
 	auto SpirvConstantCache::BuildArrayConstant(const Ast::ConstantArrayValue& value) const -> ConstantPtr
 	{
-		return std::make_shared<Constant>(std::visit([&](auto&& arg) -> ConstantComposite
+		return InternConstant(std::visit([&](auto&& arg) -> ConstantComposite
 		{
 			using T = std::decay_t<decltype(arg)>;
 
@@ -656,13 +684,13 @@ namespace nzsl
 					constants.push_back(BuildConstant(element));
 
 				Array arrayType = {
-					std::make_shared<Type>(BuildSingleType<ValueType>()),
+					BuildSingleType<ValueType>(),
 					BuildConstant(Nz::SafeCast<std::uint32_t>(arg.size())),
 					std::nullopt
 				};
 
 				return ConstantComposite{
-					std::make_shared<Type>(std::move(arrayType)),
+					InternType(std::move(arrayType)),
 					std::move(constants)
 				};
 			}
@@ -671,7 +699,7 @@ namespace nzsl
 
 	auto SpirvConstantCache::BuildConstant(const Ast::ConstantSingleValue& value) const -> ConstantPtr
 	{
-		return std::make_shared<Constant>(std::visit([&](auto&& arg) -> SpirvConstantCache::AnyConstant
+		return InternConstant(std::visit([&](auto&& arg) -> SpirvConstantCache::AnyConstant
 		{
 			using T = std::decay_t<decltype(arg)>;
 
@@ -688,7 +716,7 @@ namespace nzsl
 			else if constexpr (IsVector_v<T> && T::Dimensions == 2)
 			{
 				return ConstantComposite{
-					std::make_shared<Type>(BuildSingleType<T>()),
+					BuildSingleType<T>(),
 					{
 						BuildConstant(arg.x()),
 						BuildConstant(arg.y())
@@ -698,7 +726,7 @@ namespace nzsl
 			else if constexpr (IsVector_v<T> && T::Dimensions == 3)
 			{
 				return ConstantComposite{
-					std::make_shared<Type>(BuildSingleType<T>()),
+					BuildSingleType<T>(),
 					{
 						BuildConstant(arg.x()),
 						BuildConstant(arg.y()),
@@ -709,7 +737,7 @@ namespace nzsl
 			else if constexpr (IsVector_v<T> && T::Dimensions == 4)
 			{
 				return ConstantComposite{
-					std::make_shared<Type>(BuildSingleType<T>()),
+					BuildSingleType<T>(),
 					{
 						BuildConstant(arg.x()),
 						BuildConstant(arg.y()),
@@ -723,6 +751,15 @@ namespace nzsl
 		}, value));
 	}
 
+	auto SpirvConstantCache::BuildSpecConstant(const Ast::ConstantSingleValue& defaultValue, std::uint32_t specId) const -> ConstantPtr
+	{
+		ConstantPtr value = BuildConstant(defaultValue);
+		if (!std::holds_alternative<ConstantBool>(value->constant) && !std::holds_alternative<ConstantScalar>(value->constant))
+			throw std::runtime_error("specialization constants must be scalars");
+
+		return InternConstant(ConstantSpec{ std::move(value), specId });
+	}
+
 	FieldOffsets SpirvConstantCache::BuildFieldOffsets(const Structure& structData) const
 	{
 		FieldOffsets structOffsets(structData.layout);
@@ -842,7 +879,7 @@ namespace nzsl
 
 	auto SpirvConstantCache::BuildFunctionType(TypePtr retType, std::vector<TypePtr> parameterTypes) const -> TypePtr
 	{
-		return std::make_shared<Type>(Function{
+		return InternType(Function{
 			std::move(retType),
 			std::move(parameterTypes)
 		});
@@ -850,7 +887,7 @@ namespace nzsl
 
 	auto SpirvConstantCache::BuildPointerType(const Ast::ExpressionType& type, SpirvStorageClass storageClass) const -> TypePtr
 	{
-		return std::make_shared<Type>(Pointer{
+		return InternType(Pointer{
 			BuildType(type, storageClass),
 			storageClass
 		});
@@ -858,7 +895,7 @@ namespace nzsl
 
 	auto SpirvConstantCache::BuildPointerType(const TypePtr& type, SpirvStorageClass storageClass) const -> TypePtr
 	{
-		return std::make_shared<Type>(Pointer{
+		return InternType(Pointer{
 			type,
 			storageClass
 		});
@@ -873,7 +910,7 @@ namespace nzsl
 				m_internal->currentBlockLayout = (storageClass == SpirvStorageClass::Uniform) ? StructLayout::Std140 : StructLayout::Std430; // FIXME: When does that happen?
 		}
 
-		auto typePtr = std::make_shared<Type>(Pointer{
+		auto typePtr = InternType(Pointer{
 			BuildType(type),
 			storageClass
 		});
@@ -907,7 +944,7 @@ namespace nzsl
 
 		assert(type.length > 0);
 
-		return std::make_shared<Type>(Array{
+		return InternType(Array{
 			builtContainedType,
 			BuildConstant(type.length),
 			arrayStride
@@ -930,7 +967,7 @@ namespace nzsl
 			arrayStride = Nz::SafeCast<std::uint32_t>(fieldOffset.GetAlignedSize());
 		}
 
-		return std::make_shared<Type>(Array{
+		return InternType(Array{
 			builtContainedType,
 			nullptr,
 			arrayStride
@@ -966,7 +1003,7 @@ namespace nzsl
 
 	auto SpirvConstantCache::BuildType(const Ast::MatrixType& type) const -> TypePtr
 	{
-		return std::make_shared<Type>(
+		return InternType(
 			Matrix{
 				BuildType(Ast::VectorType {
 					std::uint32_t(type.rowCount), type.type
@@ -977,12 +1014,12 @@ namespace nzsl
 
 	auto SpirvConstantCache::BuildType(const Ast::NoType& /*type*/) const -> TypePtr
 	{
-		return std::make_shared<Type>(Void{});
+		return InternType(Void{});
 	}
 
 	auto SpirvConstantCache::BuildType(const Ast::PrimitiveType& type) const -> TypePtr
 	{
-		return std::make_shared<Type>([&]() -> AnyType
+		return InternType([&]() -> AnyType
 		{
 			switch (type)
 			{
@@ -1042,7 +1079,7 @@ namespace nzsl
 			throw std::runtime_error("unhandled image dimension");
 		}();
 
-		return std::make_shared<Type>(SampledImage{ std::make_shared<Type>(imageType) });
+		return InternType(SampledImage{ InternType(imageType) });
 	}
 
 	auto SpirvConstantCache::BuildType(const Ast::StorageType& type) const -> TypePtr
@@ -1095,7 +1132,7 @@ namespace nzsl
 
 		m_internal->currentBlockLayout = prevBlockLayout;
 
-		return std::make_shared<Type>(std::move(sType));
+		return InternType(std::move(sType));
 	}
 
 	auto SpirvConstantCache::BuildType(const Ast::TextureType& type) const -> TypePtr
@@ -1156,12 +1193,12 @@ namespace nzsl
 			throw std::runtime_error("unhandled access policy");
 		}();*/
 
-		return std::make_shared<Type>(imageType);
+		return InternType(imageType);
 	}
 
 	auto SpirvConstantCache::BuildType(const Ast::VectorType& type) const -> TypePtr
 	{
-		return std::make_shared<Type>(Vector{ BuildType(type.type), std::uint32_t(type.componentCount) });
+		return InternType(Vector{ BuildType(type.type), std::uint32_t(type.componentCount) });
 	}
 
 	auto SpirvConstantCache::BuildType(const Ast::UniformType& type) const -> TypePtr
@@ -1180,6 +1217,9 @@ namespace nzsl
 
 	std::uint32_t SpirvConstantCache::GetId(const Constant& c)
 	{
+		if (c.id != 0 && c.owner == m_internal.operator->())
+			return c.id;
+
 		auto it = m_internal->ids.find(c.constant);
 		if (it == m_internal->ids.end())
 			throw std::runtime_error("constant is not registered");
@@ -1189,6 +1229,9 @@ namespace nzsl
 
 	std::uint32_t SpirvConstantCache::GetId(const Type& t)
 	{
+		if (t.id != 0 && t.owner == m_internal.operator->())
+			return t.id;
+
 		auto it = m_internal->ids.find(t.type);
 		if (it == m_internal->ids.end())
 			throw std::runtime_error("type is not registered");
@@ -1209,37 +1252,51 @@ namespace nzsl
 		return it.value();
 	}
 
-	std::uint32_t SpirvConstantCache::Register(Constant c)
+	std::uint32_t SpirvConstantCache::Register(const Constant& c)
 	{
-		AnyConstant& constant = c.constant;
-
-		DepRegisterer registerer(*this);
-		registerer.Register(constant);
+		// Nodes interned by this cache remember their id, only nodes built outside of it have to be looked up
+		bool isInterned = (c.owner == m_internal.operator->());
+		if (isInterned && c.id != 0)
+			return c.id;
 
-		auto it = m_internal->ids.find(constant);
+		// Dependencies are registered along with the constant, no need to go through them again
+		auto it = m_internal->ids.find(c.constant);
 		if (it == m_internal->ids.end())
 		{
+			DepRegisterer registerer(*this);
+			registerer.Register(c.constant);
+
 			std::uint32_t resultId = m_internal->nextResultId++;
-			it = m_internal->ids.emplace(std::move(constant), resultId).first;
+			it = m_internal->ids.emplace(c.constant, resultId).first;
 		}
 
+		if (isInterned)
+			c.id = it.value();
+
 		return it.value();
 	}
 
-	std::uint32_t SpirvConstantCache::Register(Type t)
+	std::uint32_t SpirvConstantCache::Register(const Type& t)
 	{
-		AnyType& type = t.type;
+		// Nodes interned by this cache remember their id, only nodes built outside of it have to be looked up
+		bool isInterned = (t.owner == m_internal.operator->());
+		if (isInterned && t.id != 0)
+			return t.id;
 
-		DepRegisterer registerer(*this);
-		registerer.Register(type);
-
-		auto it = m_internal->ids.find(type);
+		// Dependencies are registered along with the type, no need to go through them again
+		auto it = m_internal->ids.find(t.type);
 		if (it == m_internal->ids.end())
 		{
+			DepRegisterer registerer(*this);
+			registerer.Register(t.type);
+
 			std::uint32_t resultId = m_internal->nextResultId++;
-			it = m_internal->ids.emplace(std::move(type), resultId).first;
+			it = m_internal->ids.emplace(t.type, resultId).first;
 		}
 
+		if (isInterned)
+			t.id = it.value();
+
 		return it.value();
 	}
 
@@ -1394,7 +1451,7 @@ namespace nzsl
 
 			std::visit(Nz::Overloaded
 			{
-				[&](const AnyConstant& constant) { Write(constant, resultId, constants); },
+				[&](const AnyConstant& constant) { Write(constant, resultId, annotations, constants); },
 					[&](const AnyType& type) { Write(type, resultId, annotations, constants, debugInfos, debugLevel); },
 			}, object);
 		}
@@ -1450,8 +1507,53 @@ namespace nzsl
 			throw std::runtime_error("an internal error occurred");
 	}
 
-	void SpirvConstantCache::Write(const AnyConstant& constant, std::uint32_t resultId, SpirvSection& constants)
+	auto SpirvConstantCache::InternConstant(AnyConstant constant) const -> ConstantPtr
+	{
+		auto [it, inserted] = m_internal->internedConstants.insert(std::make_shared<Constant>(std::move(constant)));
+		if (inserted)
+			(*it)->owner = m_internal.operator->();
+
+		return *it;
+	}
+
+	auto SpirvConstantCache::InternType(AnyType type) const -> TypePtr
+	{
+		auto [it, inserted] = m_internal->internedTypes.insert(std::make_shared<Type>(std::move(type)));
+		if (inserted)
+			(*it)->owner = m_internal.operator->();
+
+		return *it;
+	}
+
+	void SpirvConstantCache::Write(const AnyConstant& constant, std::uint32_t resultId, SpirvSection& annotations, SpirvSection& constants)
 	{
+		auto WriteScalar = [&](SpirvOp op, const ConstantScalar& scalar)
+		{
+			std::visit([&](auto&& value)
+			{
+				using ValueType = std::decay_t<decltype(value)>;
+
+				std::uint32_t typeId;
+				if constexpr (std::is_same_v<ValueType, double>)
+					typeId = GetId(Type{ Float{ 64 } });
+				else if constexpr (std::is_same_v<ValueType, float>)
+					typeId = GetId(Type{ Float{ 32 } });
+				else if constexpr (std::is_same_v<ValueType, std::int32_t>)
+					typeId = GetId(Type{ Integer{ 32, true } });
+				else if constexpr (std::is_same_v<ValueType, std::int64_t>)
+					typeId = GetId(Type{ Integer{ 64, true } });
+				else if constexpr (std::is_same_v<ValueType, std::uint32_t>)
+					typeId = GetId(Type{ Integer{ 32, false } });
+				else if constexpr (std::is_same_v<ValueType, std::uint64_t>)
+					typeId = GetId(Type{ Integer{ 64, false } });
+				else
+					static_assert(Nz::AlwaysFalse<ValueType>::value, "non-exhaustive visitor");
+
+				constants.Append(op, typeId, resultId, SpirvSection::Raw{ &value, sizeof(value) });
+
+			}, scalar.value);
+		};
+
 		std::visit([&](auto&& arg)
 		{
 			using ConstantType = std::decay_t<decltype(arg)>;
@@ -1470,30 +1572,15 @@ namespace nzsl
 				});
 			}
 			else if constexpr (std::is_same_v<ConstantType, ConstantScalar>)
+				WriteScalar(SpirvOp::OpConstant, arg);
+			else if constexpr (std::is_same_v<ConstantType, ConstantSpec>)
 			{
-				std::visit([&](auto&& value)
-				{
-					using ValueType = std::decay_t<decltype(value)>;
-
-					std::uint32_t typeId;
-					if constexpr (std::is_same_v<ValueType, double>)
-						typeId = GetId(Type{ Float{ 64 } });
-					else if constexpr (std::is_same_v<ValueType, float>)
-						typeId = GetId(Type{ Float{ 32 } });
-					else if constexpr (std::is_same_v<ValueType, std::int32_t>)
-						typeId = GetId(Type{ Integer{ 32, true } });
-					else if constexpr (std::is_same_v<ValueType, std::int64_t>)
-						typeId = GetId(Type{ Integer{ 64, true } });
-					else if constexpr (std::is_same_v<ValueType, std::uint32_t>)
-						typeId = GetId(Type{ Integer{ 32, false } });
-					else if constexpr (std::is_same_v<ValueType, std::uint64_t>)
-						typeId = GetId(Type{ Integer{ 64, false } });
-					else
-						static_assert(Nz::AlwaysFalse<ValueType>::value, "non-exhaustive visitor");
-
-					constants.Append(SpirvOp::OpConstant, typeId, resultId, SpirvSection::Raw{ &value, sizeof(value) });
+				if (const ConstantBool* boolValue = std::get_if<ConstantBool>(&arg.defaultValue->constant))
+					constants.Append((boolValue->value) ? SpirvOp::OpSpecConstantTrue : SpirvOp::OpSpecConstantFalse, GetId(Type{ Bool{} }), resultId);
+				else
+					WriteScalar(SpirvOp::OpSpecConstant, std::get<ConstantScalar>(arg.defaultValue->constant));
 
-				}, arg.value);
+				annotations.Append(SpirvOp::OpDecorate, resultId, SpirvDecoration::SpecId, arg.specId);
 			}
 			else
 				static_assert(Nz::AlwaysFalse<ConstantType>::value, "non-exhaustive visitor");
@@ -1616,4 +1703,14 @@ namespace nzsl
 			annotations.Append(SpirvOp::OpMemberDecorate, resultId, memberIndex, SpirvDecoration::Offset, member.offset.value());
 		}
 	}
+
+	std::size_t SpirvConstantCache::ComputeHash(const AnyConstant& constant)
+	{
+		return Hash{}(constant);
+	}
+
+	std::size_t SpirvConstantCache::ComputeHash(const AnyType& type)
+	{
+		return Hash{}(type);
+	}
 }
@@ -35,6 +35,14 @@ namespace nzsl
 		if (!HandleHeader(header))
 			return;
 
+		DecodeInstructions(m_currentCodepoint, m_codepointEnd - m_currentCodepoint);
+	}
+
+	bool SpirvDecoder::DecodeInstructions(const std::uint32_t* codepoints, std::size_t count)
+	{
+		m_currentCodepoint = codepoints;
+		m_codepointEnd = codepoints + count;
+
 		while (m_currentCodepoint < m_codepointEnd)
 		{
 			const std::uint32_t* instructionBegin = m_currentCodepoint;
@@ -49,10 +57,12 @@ namespace nzsl
 				throw std::runtime_error("invalid instruction");
 
 			if (!HandleOpcode(*inst, wordCount))
-				break;
+				return false;
 
 			m_currentCodepoint = instructionBegin + wordCount;
 		}
+
+		return true;
 	}
 
 	bool SpirvDecoder::HandleHeader(const SpirvHeader& /*header*/)
@@ -223,6 +223,12 @@ namespace nzsl
 		{
 			case Ast::IdentifierType::Constant:
 			{
+				if (std::optional<std::uint32_t> specConstantId = m_writer.GetSpecConstantId(node.identifierIndex))
+				{
+					m_value = Value{ *specConstantId };
+					break;
+				}
+
 				const auto& var = m_writer.GetConstantVariable(node.identifierIndex);
 				m_value = Pointer{ var.typePtr, var.storageClass, var.pointerId, var.typeId };
 				break;
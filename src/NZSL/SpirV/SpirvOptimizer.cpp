@@ -0,0 +1,716 @@
+// Copyright (C) 2026 Jérôme "SirLynix" Leclercq (lynix680@gmail.com)
+// This file is part of the "Nazara Shading Language" project
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <NZSL/SpirV/SpirvOptimizer.hpp>
+#include <NazaraUtils/Algorithm.hpp>
+#include <NazaraUtils/CallOnExit.hpp>
+#include <NZSL/SpirV/SpirvData.hpp>
+#include <NZSL/SpirV/SpirvSection.hpp>
+#include <cassert>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace nzsl
+{
+	namespace
+	{
+		constexpr std::size_t InvalidIndex = std::numeric_limits<std::size_t>::max();
+
+		struct Instruction
+		{
+			SpirvOp op;
+			std::size_t resultIndex = 0; //< word index of the result id, 0 if the instruction has none
+			std::uint32_t functionId; //< enclosing function, 0 for module-level instructions
+			std::uint32_t resultId = 0;
+			std::vector<std::size_t> idOperands; //< word indices of every referenced id (result type included)
+			std::vector<std::uint32_t> words; //< whole instruction, opcode word included
+			bool isRemoved = false;
+		};
+
+		// Debug names and decorations don't keep their target alive, they are removed along with it
+		bool IsAnnotation(SpirvOp op)
+		{
+			switch (op)
+			{
+				case SpirvOp::OpName:
+				case SpirvOp::OpMemberName:
+				case SpirvOp::OpDecorate:
+				case SpirvOp::OpDecorateId:
+				case SpirvOp::OpDecorateString:
+				case SpirvOp::OpMemberDecorate:
+				case SpirvOp::OpMemberDecorateString:
+					return true;
+
+				default:
+					return false;
+			}
+		}
+
+		// Function instructions whose result can be dropped when unused
+		bool IsPure(const Instruction& instruction, const std::unordered_set<std::uint32_t>& glslExtInstSets)
+		{
+			switch (instruction.op)
+			{
+				case SpirvOp::OpUndef:
+				case SpirvOp::OpVariable:
+				case SpirvOp::OpLoad:
+				case SpirvOp::OpAccessChain:
+				case SpirvOp::OpInBoundsAccessChain:
+				case SpirvOp::OpSelect:
+				case SpirvOp::OpPhi:
+					return true;
+
+				case SpirvOp::OpExtInst:
+					return glslExtInstSets.count(instruction.words[3]) != 0;
+
+				default:
+					break;
+			}
+
+			auto InRange = [&](SpirvOp first, SpirvOp last)
+			{
+				return instruction.op >= first && instruction.op <= last;
+			};
+
+			return InRange(SpirvOp::OpVectorExtractDynamic, SpirvOp::OpImageQuerySamples) //< composite and image sampling/query operations
+			    || InRange(SpirvOp::OpConvertFToU, SpirvOp::OpBitcast)                     //< conversions
+			    || InRange(SpirvOp::OpSNegate, SpirvOp::OpSMulExtended)                    //< arithmetic
+			    || InRange(SpirvOp::OpAny, SpirvOp::OpFUnordGreaterThanEqual)              //< relational and logical
+			    || InRange(SpirvOp::OpShiftRightLogical, SpirvOp::OpBitCount)              //< bit operations
+			    || InRange(SpirvOp::OpDPdx, SpirvOp::OpFwidthCoarse);                      //< derivatives
+		}
+
+		class OperandParser
+		{
+			public:
+				OperandParser(Instruction& instruction) :
+				m_instruction(instruction),
+				m_wordIndex(1)
+				{
+				}
+
+				void Parse(const SpirvOperand* operands, std::size_t operandCount)
+				{
+					if (!operands || operandCount == 0)
+						return;
+
+					// Last operand is repeated until the end of the instruction (variadic operands)
+					std::size_t currentOperand = 0;
+					while (m_wordIndex < m_instruction.words.size())
+					{
+						ParseOperand(operands[currentOperand]);
+
+						if (currentOperand < operandCount - 1)
+							currentOperand++;
+					}
+				}
+
+			private:
+				void ParseOperand(const SpirvOperand& operand)
+				{
+					switch (operand.kind)
+					{
+						case SpirvOperandKind::IdResult:
+							m_instruction.resultIndex = m_wordIndex;
+							m_instruction.resultId = ReadWord();
+							break;
+
+						case SpirvOperandKind::IdRef:
+						case SpirvOperandKind::IdResultType:
+						case SpirvOperandKind::IdMemorySemantics:
+						case SpirvOperandKind::IdScope:
+							ReadId();
+							break;
+
+						case SpirvOperandKind::PairIdRefIdRef:
+							ReadId();
+							ReadId();
+							break;
+
+						case SpirvOperandKind::PairIdRefLiteralInteger:
+							ReadId();
+							ReadWord();
+							break;
+
+						case SpirvOperandKind::PairLiteralIntegerIdRef:
+							ReadWord();
+							ReadId();
+							break;
+
+						case SpirvOperandKind::LiteralString:
+						{
+							// strings are null-terminated and padded with zeros, the last word always ends with a null byte
+							while ((ReadWord() & 0xFF000000) != 0);
+							break;
+						}
+
+						case SpirvOperandKind::LiteralSpecConstantOpInteger:
+						{
+							// remaining operands are the ones of the wrapped instruction, minus its result type and result id
+							const SpirvInstruction* specInstruction = GetSpirvInstruction(Nz::SafeCast<std::uint16_t>(ReadWord()));
+							if (!specInstruction || specInstruction->minOperandCount < 2 || specInstruction->operands[1].kind != SpirvOperandKind::IdResult)
+								throw std::runtime_error("invalid SPIR-V: unexpected OpSpecConstantOp opcode");
+
+							Parse(specInstruction->operands + 2, specInstruction->minOperandCount - 2);
+							break;
+						}
+
+						case SpirvOperandKind::ImageOperands:
+						{
+							// every image operand is an id
+							ReadWord();
+							while (m_wordIndex < m_instruction.words.size())
+								ReadId();
+
+							break;
+						}
+
+						case SpirvOperandKind::MemoryAccess:
+						{
+							std::uint32_t memoryAccess = ReadWord();
+							if (memoryAccess & static_cast<std::uint32_t>(SpirvMemoryAccess::Aligned))
+								ReadWord();
+
+							if (memoryAccess & static_cast<std::uint32_t>(SpirvMemoryAccess::MakePointerAvailable))
+								ReadId();
+
+							if (memoryAccess & static_cast<std::uint32_t>(SpirvMemoryAccess::MakePointerVisible))
+								ReadId();
+
+							break;
+						}
+
+#define NZSL_HandleOperandKind(Kind) \
+						case SpirvOperandKind:: Kind : \
+						{ \
+							Spirv##Kind value = static_cast<Spirv##Kind>(ReadWord()); \
+\
+							/* handle extra operands */ \
+							auto [operandPtr, operandCount] = GetSpirvExtraOperands(value); \
+							for (std::size_t i = 0; i < operandCount; ++i) \
+								ParseOperand(operandPtr[i]); \
+\
+							break; \
+						} \
+
+						NZSL_HandleOperandKind(AccessQualifier)
+						NZSL_HandleOperandKind(AddressingModel)
+						NZSL_HandleOperandKind(BuiltIn)
+						NZSL_HandleOperandKind(Capability)
+						NZSL_HandleOperandKind(Decoration)
+						NZSL_HandleOperandKind(Dim)
+						NZSL_HandleOperandKind(ExecutionMode)
+						NZSL_HandleOperandKind(ExecutionModel)
+						NZSL_HandleOperandKind(FPDenormMode)
+						NZSL_HandleOperandKind(FPOperationMode)
+						NZSL_HandleOperandKind(FPRoundingMode)
+						NZSL_HandleOperandKind(FunctionParameterAttribute)
+						NZSL_HandleOperandKind(GroupOperation)
+						NZSL_HandleOperandKind(ImageChannelDataType)
+						NZSL_HandleOperandKind(ImageChannelOrder)
+						NZSL_HandleOperandKind(ImageFormat)
+						NZSL_HandleOperandKind(KernelEnqueueFlags)
+						NZSL_HandleOperandKind(LinkageType)
+						NZSL_HandleOperandKind(MemoryModel)
+						NZSL_HandleOperandKind(OverflowModes)
+						NZSL_HandleOperandKind(PackedVectorFormat)
+						NZSL_HandleOperandKind(QuantizationModes)
+						NZSL_HandleOperandKind(RayQueryCandidateIntersectionType)
+						NZSL_HandleOperandKind(RayQueryCommittedIntersectionType)
+						NZSL_HandleOperandKind(RayQueryIntersection)
+						NZSL_HandleOperandKind(SamplerAddressingMode)
+						NZSL_HandleOperandKind(SamplerFilterMode)
+						NZSL_HandleOperandKind(Scope)
+						NZSL_HandleOperandKind(SourceLanguage)
+						NZSL_HandleOperandKind(StorageClass)
+#undef NZSL_HandleOperandKind
+
+						default:
+							// literals and bitmasks without id operands
+							ReadWord();
+							break;
+					}
+				}
+
+				void ReadId()
+				{
+					std::size_t wordIndex = m_wordIndex;
+					ReadWord();
+
+					m_instruction.idOperands.push_back(wordIndex);
+				}
+
+				std::uint32_t ReadWord()
+				{
+					if (m_wordIndex >= m_instruction.words.size())
+						throw std::runtime_error("invalid SPIR-V: unexpected end of instruction");
+
+					return m_instruction.words[m_wordIndex++];
+				}
+
+				Instruction& m_instruction;
+				std::size_t m_wordIndex;
+		};
+	}
+
+	struct SpirvOptimizer::State
+	{
+		State(const Settings& s) :
+		settings(s)
+		{
+		}
+
+		std::uint32_t ResolveId(std::uint32_t id) const
+		{
+			for (auto it = replacedIds.find(id); it != replacedIds.end(); it = replacedIds.find(id))
+				id = it->second;
+
+			return id;
+		}
+
+		bool IsDefined(std::uint32_t id) const
+		{
+			return id < definitions.size() && definitions[id] != InvalidIndex && !instructions[definitions[id]].isRemoved;
+		}
+
+		SpirvHeader header;
+		std::uint32_t currentFunctionId = 0;
+		std::unordered_map<std::uint32_t, std::uint32_t> replacedIds;
+		std::unordered_set<std::uint32_t> glslExtInstSets;
+		std::vector<std::size_t> definitions; //< index of the instruction defining each id
+		std::vector<Instruction> instructions;
+		const Settings& settings;
+	};
+
+	std::vector<std::uint32_t> SpirvOptimizer::Optimize(const std::uint32_t* codepoints, std::size_t count, const Settings& settings)
+	{
+		State state(settings);
+
+		m_currentState = &state;
+		Nz::CallOnExit resetOnExit([&] { m_currentState = nullptr; });
+
+		Decode(codepoints, count);
+		RunPasses();
+
+		std::vector<std::uint32_t> optimizedCodepoints;
+
+		Output output;
+		output.reserve = [&](std::size_t wordCount) { optimizedCodepoints.reserve(wordCount); };
+		output.append = [&](const std::uint32_t* words, std::size_t wordCount) { optimizedCodepoints.insert(optimizedCodepoints.end(), words, words + wordCount); };
+
+		WriteModule(output);
+
+		return optimizedCodepoints;
+	}
+
+	void SpirvOptimizer::Optimize(const SpirvSection* const* sections, std::size_t sectionCount, const Settings& settings, const Output& output)
+	{
+		assert(sectionCount > 0);
+
+		State state(settings);
+
+		m_currentState = &state;
+		Nz::CallOnExit resetOnExit([&] { m_currentState = nullptr; });
+
+		const std::vector<std::uint32_t>& headerBytecode = sections[0]->GetBytecode();
+		Decode(headerBytecode.data(), headerBytecode.size());
+
+		for (std::size_t i = 1; i < sectionCount; ++i)
+		{
+			const std::vector<std::uint32_t>& bytecode = sections[i]->GetBytecode();
+			DecodeInstructions(bytecode.data(), bytecode.size());
+		}
+
+		RunPasses();
+		WriteModule(output);
+	}
+
+	void SpirvOptimizer::CompactIds()
+	{
+		// Renumber ids in definition order, starting from 1
+		std::vector<std::uint32_t> newIds(m_currentState->definitions.size(), 0);
+
+		std::uint32_t nextId = 1;
+		for (const Instruction& instruction : m_currentState->instructions)
+		{
+			if (!instruction.isRemoved && instruction.resultId != 0)
+				newIds[instruction.resultId] = nextId++;
+		}
+
+		for (Instruction& instruction : m_currentState->instructions)
+		{
+			if (instruction.isRemoved)
+				continue;
+
+			if (instruction.resultIndex != 0)
+				instruction.words[instruction.resultIndex] = newIds[instruction.resultId];
+
+			for (std::size_t idIndex : instruction.idOperands)
+			{
+				std::uint32_t id = instruction.words[idIndex];
+				if (id >= newIds.size() || newIds[id] == 0)
+					throw std::runtime_error("invalid SPIR-V: reference to undefined id " + std::to_string(id));
+
+				instruction.words[idIndex] = newIds[id];
+			}
+		}
+
+		m_currentState->header.bound = nextId;
+	}
+
+	void SpirvOptimizer::DeduplicateConstants()
+	{
+		// Constants are keyed by their whole instruction (minus their result id), constituents being replaced by their deduplicated id first
+		std::map<std::vector<std::uint32_t>, std::uint32_t> constants;
+
+		for (Instruction& instruction : m_currentState->instructions)
+		{
+			if (instruction.isRemoved || instruction.functionId != 0)
+				continue;
+
+			switch (instruction.op)
+			{
+				case SpirvOp::OpConstantTrue:
+				case SpirvOp::OpConstantFalse:
+				case SpirvOp::OpConstant:
+				case SpirvOp::OpConstantComposite:
+				case SpirvOp::OpConstantNull:
+				{
+					std::vector<std::uint32_t> key = instruction.words;
+					key[instruction.resultIndex] = 0;
+					for (std::size_t idIndex : instruction.idOperands)
+						key[idIndex] = m_currentState->ResolveId(key[idIndex]);
+
+					auto [it, inserted] = constants.emplace(std::move(key), instruction.resultId);
+					if (!inserted)
+					{
+						m_currentState->replacedIds[instruction.resultId] = it->second;
+						instruction.isRemoved = true;
+					}
+
+					break;
+				}
+
+				default:
+					break;
+			}
+		}
+
+		RemapIds();
+	}
+
+	void SpirvOptimizer::EliminateDeadCode()
+	{
+		std::vector<Instruction>& instructions = m_currentState->instructions;
+
+		std::unordered_map<std::uint32_t, std::vector<std::size_t>> functionBodies;
+		std::unordered_map<std::uint32_t, std::vector<std::size_t>> variableStores; //< direct stores to function variables, only live if the variable is
+		for (std::size_t i = 0; i < instructions.size(); ++i)
+		{
+			const Instruction& instruction = instructions[i];
+			if (instruction.isRemoved || instruction.functionId == 0)
+				continue;
+
+			functionBodies[instruction.functionId].push_back(i);
+
+			if (instruction.op == SpirvOp::OpVariable)
+				variableStores[instruction.resultId]; //< register the variable
+		}
+
+		for (std::size_t i = 0; i < instructions.size(); ++i)
+		{
+			const Instruction& instruction = instructions[i];
+			if (instruction.isRemoved || instruction.op != SpirvOp::OpStore)
+				continue;
+
+			if (auto it = variableStores.find(instruction.words[1]); it != variableStores.end())
+				it->second.push_back(i);
+		}
+
+		std::vector<bool> liveInstructions(instructions.size(), false);
+		std::vector<std::size_t> worklist;
+
+		auto MarkInstruction = [&](std::size_t index)
+		{
+			if (!liveInstructions[index])
+			{
+				liveInstructions[index] = true;
+				worklist.push_back(index);
+			}
+		};
+
+		auto MarkId = [&](std::uint32_t id)
+		{
+			if (id < m_currentState->definitions.size() && m_currentState->definitions[id] != InvalidIndex)
+				MarkInstruction(m_currentState->definitions[id]);
+		};
+
+		// Module-level instructions without results (capabilities, memory model, entry points, execution modes, ...) are the roots
+		for (std::size_t i = 0; i < instructions.size(); ++i)
+		{
+			const Instruction& instruction = instructions[i];
+			if (!instruction.isRemoved && instruction.functionId == 0 && instruction.resultId == 0 && !IsAnnotation(instruction.op))
+				MarkInstruction(i);
+		}
+
+		while (!worklist.empty())
+		{
+			std::size_t index = worklist.back();
+			worklist.pop_back();
+
+			const Instruction& instruction = instructions[index];
+			for (std::size_t idIndex : instruction.idOperands)
+				MarkId(instruction.words[idIndex]);
+
+			if (instruction.op == SpirvOp::OpFunction)
+			{
+				// A referenced function keeps its control flow and every instruction with side effects alive
+				for (std::size_t bodyIndex : functionBodies[instruction.resultId])
+				{
+					const Instruction& bodyInstruction = instructions[bodyIndex];
+					if (bodyInstruction.op == SpirvOp::OpStore && variableStores.find(bodyInstruction.words[1]) != variableStores.end())
+						continue;
+
+					if (bodyInstruction.resultId == 0 || !IsPure(bodyInstruction, m_currentState->glslExtInstSets))
+						MarkInstruction(bodyIndex);
+				}
+			}
+			else if (instruction.op == SpirvOp::OpVariable && instruction.functionId != 0)
+			{
+				for (std::size_t storeIndex : variableStores[instruction.resultId])
+					MarkInstruction(storeIndex);
+			}
+		}
+
+		for (std::size_t i = 0; i < instructions.size(); ++i)
+		{
+			Instruction& instruction = instructions[i];
+			if (!liveInstructions[i] && !IsAnnotation(instruction.op))
+				instruction.isRemoved = true;
+		}
+	}
+
+	void SpirvOptimizer::EliminateRedundantLoads()
+	{
+		std::vector<Instruction>& instructions = m_currentState->instructions;
+
+		// Only function variables exclusively accessed by direct loads and stores can be tracked
+		std::unordered_set<std::uint32_t> trackedVariables;
+		for (const Instruction& instruction : instructions)
+		{
+			if (!instruction.isRemoved && instruction.op == SpirvOp::OpVariable && instruction.functionId != 0)
+				trackedVariables.insert(instruction.resultId);
+		}
+
+		for (const Instruction& instruction : instructions)
+		{
+			if (instruction.isRemoved || IsAnnotation(instruction.op))
+				continue;
+
+			for (std::size_t idIndex : instruction.idOperands)
+			{
+				std::uint32_t id = instruction.words[idIndex];
+				if (trackedVariables.count(id) == 0)
+					continue;
+
+				bool isDirectAccess = (instruction.op == SpirvOp::OpLoad && idIndex == 3) || (instruction.op == SpirvOp::OpStore && idIndex == 1);
+				if (!isDirectAccess)
+					trackedVariables.erase(id);
+			}
+		}
+
+		// Values are only forwarded inside a basic block
+		std::unordered_map<std::uint32_t, std::uint32_t> knownValues;
+		for (Instruction& instruction : instructions)
+		{
+			if (instruction.isRemoved)
+				continue;
+
+			switch (instruction.op)
+			{
+				case SpirvOp::OpLabel:
+					knownValues.clear();
+					break;
+
+				case SpirvOp::OpVariable:
+				{
+					if (instruction.words.size() > 4 && trackedVariables.count(instruction.resultId) != 0)
+						knownValues[instruction.resultId] = m_currentState->ResolveId(instruction.words[4]);
+
+					break;
+				}
+
+				case SpirvOp::OpStore:
+				{
+					std::uint32_t pointerId = instruction.words[1];
+					if (trackedVariables.count(pointerId) != 0)
+						knownValues[pointerId] = m_currentState->ResolveId(instruction.words[2]);
+
+					break;
+				}
+
+				case SpirvOp::OpLoad:
+				{
+					std::uint32_t pointerId = instruction.words[3];
+					if (trackedVariables.count(pointerId) == 0)
+						break;
+
+					if (auto it = knownValues.find(pointerId); it != knownValues.end())
+					{
+						m_currentState->replacedIds[instruction.resultId] = it->second;
+						instruction.isRemoved = true;
+					}
+					else
+						knownValues[pointerId] = instruction.resultId;
+
+					break;
+				}
+
+				default:
+					break;
+			}
+		}
+
+		RemapIds();
+	}
+
+	void SpirvOptimizer::RemapIds()
+	{
+		if (m_currentState->replacedIds.empty())
+			return;
+
+		for (Instruction& instruction : m_currentState->instructions)
+		{
+			if (instruction.isRemoved)
+				continue;
+
+			// annotations targeting a replaced id are stripped later instead of being moved to the replacement
+			bool isAnnotation = IsAnnotation(instruction.op);
+			for (std::size_t idIndex : instruction.idOperands)
+			{
+				if (isAnnotation && idIndex == 1)
+					continue;
+
+				instruction.words[idIndex] = m_currentState->ResolveId(instruction.words[idIndex]);
+			}
+		}
+
+		m_currentState->replacedIds.clear();
+	}
+
+	void SpirvOptimizer::RunPasses()
+	{
+		const Settings& settings = m_currentState->settings;
+
+		if (settings.eliminateRedundantLoads)
+			EliminateRedundantLoads();
+
+		if (settings.deduplicateConstants)
+			DeduplicateConstants();
+
+		if (settings.eliminateDeadCode)
+			EliminateDeadCode();
+
+		// Always required as previous passes may have removed decorated instructions
+		StripUnusedDecorations();
+
+		if (settings.compactIds)
+			CompactIds();
+	}
+
+	void SpirvOptimizer::StripUnusedDecorations()
+	{
+		for (Instruction& instruction : m_currentState->instructions)
+		{
+			if (!instruction.isRemoved && IsAnnotation(instruction.op) && !m_currentState->IsDefined(instruction.words[1]))
+				instruction.isRemoved = true;
+		}
+	}
+
+	void SpirvOptimizer::WriteModule(const Output& output) const
+	{
+		const State& state = *m_currentState;
+
+		if (output.reserve)
+		{
+			std::size_t wordCount = 5; //< header
+			for (const Instruction& instruction : state.instructions)
+			{
+				if (!instruction.isRemoved)
+					wordCount += instruction.words.size();
+			}
+
+			output.reserve(wordCount);
+		}
+
+		std::uint32_t header[] = { SpirvMagicNumber, state.header.versionNumber, state.header.generatorId, state.header.bound, state.header.schema };
+		output.append(header, std::size(header));
+
+		for (const Instruction& instruction : state.instructions)
+		{
+			if (!instruction.isRemoved)
+				output.append(instruction.words.data(), instruction.words.size());
+		}
+	}
+
+	bool SpirvOptimizer::HandleHeader(const SpirvHeader& header)
+	{
+		m_currentState->header = header;
+		m_currentState->definitions.resize(header.bound, InvalidIndex);
+
+		return true;
+	}
+
+	bool SpirvOptimizer::HandleOpcode(const SpirvInstruction& instruction, std::uint32_t wordCount)
+	{
+		const std::uint32_t* instructionBegin = GetCurrentPtr() - 1;
+
+		std::size_t instructionIndex = m_currentState->instructions.size();
+
+		Instruction& optInstruction = m_currentState->instructions.emplace_back();
+		optInstruction.op = instruction.op;
+		optInstruction.words.assign(instructionBegin, instructionBegin + wordCount);
+
+		OperandParser operandParser(optInstruction);
+		operandParser.Parse(instruction.operands, instruction.minOperandCount);
+
+		if (optInstruction.resultId != 0)
+		{
+			if (optInstruction.resultId >= m_currentState->definitions.size())
+				throw std::runtime_error("invalid SPIR-V: result id " + std::to_string(optInstruction.resultId) + " is out of bounds");
+
+			m_currentState->definitions[optInstruction.resultId] = instructionIndex;
+		}
+
+		if (instruction.op == SpirvOp::OpFunction)
+			m_currentState->currentFunctionId = optInstruction.resultId;
+
+		optInstruction.functionId = m_currentState->currentFunctionId;
+
+		switch (instruction.op)
+		{
+			case SpirvOp::OpExtInstImport:
+			{
+				ReadWord(); //< result id
+				if (ReadString() == "GLSL.std.450")
+					m_currentState->glslExtInstSets.insert(optInstruction.resultId);
+
+				break;
+			}
+
+			case SpirvOp::OpFunctionEnd:
+				m_currentState->currentFunctionId = 0;
+				break;
+
+			default:
+				break;
+		}
+
+		return true;
+	}
+}
@@ -4,11 +4,16 @@
 
 #include <NZSL/SpirvWriter.hpp>
 #include <NazaraUtils/Algorithm.hpp>
+#include <NazaraUtils/Assert.hpp>
 #include <NazaraUtils/CallOnExit.hpp>
 #include <NazaraUtils/FixedVector.hpp>
 #include <NazaraUtils/PathUtils.hpp>
 #include <NZSL/Enums.hpp>
 #include <NZSL/Parser.hpp>
+#include <NZSL/PermutationUtils.hpp>
+#include <NZSL/Ast/Cloner.hpp>
+#include <NZSL/Ast/NodeArena.hpp>
+#include <NZSL/Ast/Option.hpp>
 #include <NZSL/Ast/RecursiveVisitor.hpp>
 #include <NZSL/Lang/Constants.hpp>
 #include <NZSL/Lang/LangData.hpp>
@@ -17,6 +22,7 @@
 #include <NZSL/SpirV/SpirvConstantCache.hpp>
 #include <NZSL/SpirV/SpirvData.hpp>
 #include <NZSL/SpirV/SpirvGenData.hpp>
+#include <NZSL/SpirV/SpirvOptimizer.hpp>
 #include <NZSL/SpirV/SpirvSection.hpp>
 #include <NZSL/Ast/Transformations/AliasTransformer.hpp>
 #include <NZSL/Ast/Transformations/BindingResolverTransformer.hpp>
@@ -39,6 +45,7 @@
 #include <tsl/ordered_set.h>
 #include <cassert>
 #include <fstream>
+#include <iterator>
 #include <stdexcept>
 #include <type_traits>
 #include <unordered_map>
@@ -78,6 +85,8 @@ namespace nzsl
 			using ExtVarContainer = tsl::ordered_map<std::size_t /*varIndex*/, ExternalVar>;
 			using FunctionContainer = tsl::ordered_map<std::size_t, SpirvAstVisitor::FuncData>;
 			using LocalContainer = tsl::ordered_set<Ast::ExpressionType>;
+			using OptionContainer = std::unordered_map<std::size_t /*optIndex*/, const Ast::DeclareOptionStatement*>;
+			using SpecConstantContainer = tsl::ordered_map<std::size_t /*optIndex*/, std::uint32_t /*resultId*/>;
 			using StructContainer = std::vector<Ast::StructDescription*>;
 
 			PreVisitor(const SpirvWriter& writer, SpirvConstantCache& constantCache) :
@@ -489,6 +498,13 @@ namespace nzsl
 				m_funcIndex.reset();
 			}
 
+			void Visit(Ast::DeclareOptionStatement& node) override
+			{
+				// Options only reach code generation when they are emitted as specialization constants, registered on first use
+				assert(node.optIndex);
+				declaredOptions.emplace(*node.optIndex, &node);
+			}
+
 			void Visit(Ast::DeclareStructStatement& node) override
 			{
 				RecursiveVisitor::Visit(node);
@@ -536,6 +552,22 @@ namespace nzsl
 						auto& func = it.value();
 						func.globalInterfaces.UnboundedSet(constIt->second.pointerId);
 					}
+					else if (auto optIt = declaredOptions.find(node.identifierIndex); optIt != declaredOptions.end() && specConstants.find(node.identifierIndex) == specConstants.end())
+					{
+						const Ast::DeclareOptionStatement& declOption = *optIt->second;
+						if (!declOption.defaultValue || declOption.defaultValue->GetType() != Ast::NodeType::ConstantValueExpression)
+							throw std::runtime_error("unexpected option " + declOption.optName + " without a constant value, is shader sanitized?");
+
+						// SpecId is a 32-bit hash of the option name, two options can end up with the same one
+						Ast::OptionHash specId = Ast::HashOption(declOption.optName.data());
+						if (auto specIdIt = m_specIdOptions.find(specId); specIdIt != m_specIdOptions.end())
+							throw std::runtime_error(fmt::format("options {} and {} have the same specialization constant id ({}), rename one of them or give it a value", specIdIt->second->optName, declOption.optName, specId));
+
+						m_specIdOptions.emplace(specId, &declOption);
+
+						const auto& defaultValue = static_cast<const Ast::ConstantValueExpression&>(*declOption.defaultValue);
+						specConstants.emplace(node.identifierIndex, m_constantCache.Register(*m_constantCache.BuildSpecConstant(defaultValue.value, specId)));
+					}
 				}
 				else if (node.identifierType == Ast::IdentifierType::Variable)
 				{
@@ -675,6 +707,8 @@ namespace nzsl
 			FunctionContainer funcs;
 			InterpolationDecoration interpolationDecorations;
 			LocationDecoration locationDecorations;
+			OptionContainer declaredOptions;
+			SpecConstantContainer specConstants;
 			StructContainer declaredStructs;
 			tsl::ordered_set<SpirvCapability> spirvCapabilities;
 
@@ -682,6 +716,7 @@ namespace nzsl
 			SpirvConstantCache& m_constantCache;
 			const SpirvWriter& m_writer;
 			std::optional<std::size_t> m_funcIndex;
+			std::unordered_map<Ast::OptionHash, const Ast::DeclareOptionStatement*> m_specIdOptions;
 	};
 
 	struct SpirvWriter::State
@@ -700,7 +735,7 @@ namespace nzsl
 
 		tsl::ordered_map<std::size_t, SpirvAstVisitor::FuncData> funcs;
 		tsl::ordered_map<std::string, std::uint32_t> extensionInstructionSet;
-		std::unordered_map<std::shared_ptr<const std::string>, std::uint32_t> sourceFiles;
+		std::unordered_map<std::uint32_t /*fileIndex*/, std::uint32_t> sourceFiles;
 		std::vector<std::uint32_t> resultIds;
 		std::uint32_t nextResultId = 1;
 		SourceLocation sourceLocation;
@@ -722,45 +757,24 @@ namespace nzsl
 
 	std::vector<std::uint32_t> SpirvWriter::Generate(Ast::Module& module, const BackendParameters& parameters)
 	{
-		if (parameters.backendPasses.size() > 0)
-		{
-			Ast::TransformerExecutor executor;
-			if (parameters.backendPasses.Test(BackendPass::Resolve))
-			{
-				executor.AddPass<Ast::ResolveTransformer>([&](Ast::ResolveTransformer::Options& opt)
-				{
-					opt.moduleResolver = parameters.shaderModuleResolver;
-				});
-			}
-
-			if (parameters.backendPasses.Test(BackendPass::TargetRequired))
-				RegisterPasses(executor);
+		std::vector<std::uint32_t> ret;
 
-			if (parameters.backendPasses.Test(BackendPass::Optimize))
-				executor.AddPass<Ast::ConstantPropagationTransformer>();
+		OutputSink sink;
+		sink.reserve = [&](std::size_t wordCount) { ret.reserve(wordCount); };
+		sink.append = [&](const std::uint32_t* words, std::size_t wordCount) { ret.insert(ret.end(), words, words + wordCount); };
 
-			if (parameters.backendPasses.Test(BackendPass::Validate))
-			{
-				executor.AddPass<Ast::ValidationTransformer>([](Ast::ValidationTransformer::Options& opt)
-				{
-					opt.allowUntyped = false;
-					opt.checkIndices = true;
-				});
-			}
+		Generate(module, sink, parameters);
 
-			Ast::TransformerContext context;
-			context.optionValues = parameters.optionValues;
+		return ret;
+	}
 
-			executor.Transform(module, context);
-		}
+	void SpirvWriter::Generate(Ast::Module& module, const OutputSink& sink, const BackendParameters& parameters)
+	{
+		NazaraAssertMsg(sink.append, "sink must have an append function");
 
-		if (parameters.backendPasses.Test(BackendPass::RemoveDeadCode))
-		{
-			Ast::DependencyCheckerVisitor::Config dependencyConfig;
-			dependencyConfig.usedShaderStages = ShaderStageType_All;
+		RunPasses(module, parameters);
 
-			Ast::EliminateUnusedPass(module, dependencyConfig);
-		}
+		Ast::PassInstrumentation::Scope generationInstrumentationScope(parameters.passInstrumentation, "SPIR-V generation");
 
 		// Previsitor
 
@@ -819,14 +833,14 @@ namespace nzsl
 
 				std::string source;
 				std::uint32_t fileId = 0;
-				if (rootLocation.file)
+				if (const auto& filePath = rootLocation.GetFile())
 				{
-					fileId = m_currentState->constantTypeCache.Register(*rootLocation.file);
-					m_currentState->sourceFiles.emplace(rootLocation.file, fileId);
+					fileId = m_currentState->constantTypeCache.Register(*filePath);
+					m_currentState->sourceFiles.emplace(rootLocation.fileIndex, fileId);
 
 					if (parameters.debugLevel >= DebugLevel::Full)
 					{
-						std::ifstream file(Nz::Utf8Path(*rootLocation.file));
+						std::ifstream file(Nz::Utf8Path(*filePath));
 						if (file)
 						{
 							std::string line;
@@ -927,16 +941,73 @@ namespace nzsl
 		{
 			for (auto&& [funcIndex, func] : m_currentState->funcs)
 				m_currentState->debugInfo.Append(SpirvOp::OpName, func.funcId, func.name);
+
+			for (auto&& [optIndex, specConstantId] : previsitor.specConstants)
+				m_currentState->debugInfo.Append(SpirvOp::OpName, specConstantId, Nz::Retrieve(previsitor.declaredOptions, optIndex)->optName);
 		}
 
-		std::vector<std::uint32_t> ret;
-		MergeSections(ret, state.header);
-		MergeSections(ret, state.debugInfo);
-		MergeSections(ret, state.annotations);
-		MergeSections(ret, state.constants);
-		MergeSections(ret, state.instructions);
+		// Sections are handed to the sink as they are, in module order, the whole module size being known before the first word is written
+		const SpirvSection* sections[] = { &state.header, &state.debugInfo, &state.annotations, &state.constants, &state.instructions };
 
-		return ret;
+		if (parameters.backendPasses.Test(BackendPass::OptimizeSpirv))
+		{
+			// The optimizer decodes the sections and writes the optimized module straight to the sink
+			Ast::PassInstrumentation::Scope instrumentationScope(parameters.passInstrumentation, "OptimizeSpirv");
+
+			SpirvOptimizer::Output optimizerOutput;
+			optimizerOutput.reserve = sink.reserve;
+			optimizerOutput.append = sink.append;
+
+			SpirvOptimizer optimizer;
+			optimizer.Optimize(sections, std::size(sections), SpirvOptimizer::Settings{}, optimizerOutput);
+			return;
+		}
+
+		if (sink.reserve)
+		{
+			std::size_t wordCount = 0;
+			for (const SpirvSection* section : sections)
+				wordCount += section->GetBytecode().size();
+
+			sink.reserve(wordCount);
+		}
+
+		for (const SpirvSection* section : sections)
+		{
+			const std::vector<std::uint32_t>& bytecode = section->GetBytecode();
+			if (!bytecode.empty())
+				sink.append(bytecode.data(), bytecode.size());
+		}
+	}
+
+	std::vector<std::uint32_t> SpirvWriter::Generate(const Ast::Module& module, const BackendParameters& parameters)
+	{
+		// The copy gets its own arena, nodes created by the passes are allocated from it and released at once with it
+		Ast::ModulePtr moduleCopy;
+		{
+			Ast::NodeArena::Scope arenaScope(std::make_shared<Ast::NodeArena>());
+			moduleCopy = Ast::Clone(module);
+		}
+
+		return Generate(*moduleCopy, parameters);
+	}
+
+	auto SpirvWriter::GeneratePermutations(const Ast::Module& module, const std::vector<OptionValues>& optionPermutations, const BackendParameters& parameters) -> PermutationOutputs<std::vector<std::uint32_t>>
+	{
+		auto RunPermutationPasses = [&](Ast::Module& permutationModule, const BackendParameters& permutationParameters, bool keepUnsetScalarOptions)
+		{
+			RunPasses(permutationModule, permutationParameters, keepUnsetScalarOptions);
+		};
+
+		auto GeneratePermutation = [&](Ast::Module& permutationModule, const BackendParameters& generationParameters)
+		{
+			return Generate(permutationModule, generationParameters);
+		};
+
+		// unset options become specialization constants in every permutation
+		bool keepUnsetOptions = parameters.backendPasses.Test(BackendPass::SpecializationConstants);
+
+		return PermutationUtils::GeneratePermutations<std::vector<std::uint32_t>>(module, optionPermutations, parameters, keepUnsetOptions, RunPermutationPasses, GeneratePermutation);
 	}
 
 	const SpirvVariable& SpirvWriter::GetConstantVariable(std::size_t constIndex) const
@@ -944,6 +1015,15 @@ namespace nzsl
 		return Nz::Retrieve(m_currentState->previsitor->constantVariables, constIndex);
 	}
 
+	std::optional<std::uint32_t> SpirvWriter::GetSpecConstantId(std::size_t constIndex) const
+	{
+		auto it = m_currentState->previsitor->specConstants.find(constIndex);
+		if (it == m_currentState->previsitor->specConstants.end())
+			return std::nullopt;
+
+		return it->second;
+	}
+
 	bool SpirvWriter::IsVersionGreaterOrEqual(std::uint32_t spvMajor, std::uint32_t spvMinor) const
 	{
 		if (m_environment.spvMajorVersion > spvMajor)
@@ -974,18 +1054,21 @@ namespace nzsl
 			return { 1, 0 };
 	}
 
-	void SpirvWriter::RegisterPasses(Ast::TransformerExecutor& executor)
+	void SpirvWriter::RegisterPasses(Ast::TransformerExecutor& executor, bool specializationConstants)
 	{
 		executor.AddPass<Ast::LoopUnrollTransformer>();
-		executor.AddPass<Ast::ConstantRemovalTransformer>();
+		executor.AddPass<Ast::ConstantRemovalTransformer>([&](Ast::ConstantRemovalTransformer::Options& opt)
+		{
+			opt.keepUnsetScalarOptions = specializationConstants;
+		});
 		executor.AddPass<Ast::LiteralTransformer>();
-		executor.AddPass<Ast::BranchSplitterTransformer>();
 		executor.AddPass<Ast::ForToWhileTransformer>();
 		executor.AddPass<Ast::StructAssignmentTransformer>([](Ast::StructAssignmentTransformer::Options& opt)
 		{
 			opt.splitWrappedArrayAssignation = true;
 			opt.splitWrappedStructAssignation = true;
 		});
+		executor.AddPass<Ast::BranchSplitterTransformer>(); //< kept next to the following passes so they run in a single traversal
 		executor.AddPass<Ast::CompoundAssignmentTransformer>([](Ast::CompoundAssignmentTransformer::Options& opt)
 		{
 			opt.removeCompoundAssignment = true;
@@ -1154,7 +1237,7 @@ namespace nzsl
 
 	std::uint32_t SpirvWriter::GetFunctionTypeId(const Ast::DeclareFunctionStatement& functionNode)
 	{
-		return m_currentState->constantTypeCache.GetId({ *BuildFunctionType(functionNode) });
+		return m_currentState->constantTypeCache.GetId(*BuildFunctionType(functionNode));
 	}
 
 	std::uint32_t SpirvWriter::GetPointerTypeId(const SpirvConstantCache::TypePtr& typePtr, SpirvStorageClass storageClass) const
@@ -1167,9 +1250,9 @@ namespace nzsl
 		return m_currentState->constantTypeCache.GetId(*m_currentState->constantTypeCache.BuildPointerType(type, storageClass));
 	}
 
-	std::uint32_t SpirvWriter::GetSourceFileId(const std::shared_ptr<const std::string>& filepathPtr)
+	std::uint32_t SpirvWriter::GetSourceFileId(std::uint32_t fileIndex)
 	{
-		auto it = m_currentState->sourceFiles.find(filepathPtr);
+		auto it = m_currentState->sourceFiles.find(fileIndex);
 		if (it == m_currentState->sourceFiles.end())
 			throw std::runtime_error("unknown source filepath");
 
@@ -1198,7 +1281,7 @@ namespace nzsl
 
 	std::uint32_t SpirvWriter::RegisterFunctionType(const Ast::DeclareFunctionStatement& functionNode)
 	{
-		return m_currentState->constantTypeCache.Register({ *BuildFunctionType(functionNode) });
+		return m_currentState->constantTypeCache.Register(*BuildFunctionType(functionNode));
 	}
 
 	std::uint32_t SpirvWriter::RegisterPointerType(const SpirvConstantCache::TypePtr& typePtr, SpirvStorageClass storageClass)
@@ -1222,12 +1305,50 @@ namespace nzsl
 		return m_currentState->constantTypeCache.Register(*m_currentState->constantTypeCache.BuildType(type));
 	}
 
-	void SpirvWriter::MergeSections(std::vector<std::uint32_t>& output, const SpirvSection& from)
+	void SpirvWriter::RunPasses(Ast::Module& module, const BackendParameters& parameters, bool keepUnsetScalarOptions)
 	{
-		const std::vector<std::uint32_t>& bytecode = from.GetBytecode();
+		if (parameters.backendPasses.size() > 0)
+		{
+			Ast::TransformerExecutor executor;
+			executor.SetInstrumentation(parameters.passInstrumentation);
 
-		std::size_t prevSize = output.size();
-		output.resize(prevSize + bytecode.size());
-		std::copy(bytecode.begin(), bytecode.end(), output.begin() + prevSize);
+			if (parameters.backendPasses.Test(BackendPass::Resolve))
+			{
+				executor.AddPass<Ast::ResolveTransformer>([&](Ast::ResolveTransformer::Options& opt)
+				{
+					opt.moduleResolver = parameters.shaderModuleResolver;
+					opt.resolvedModuleCache = parameters.resolvedModuleCache;
+				});
+			}
+
+			if (parameters.backendPasses.Test(BackendPass::TargetRequired))
+				RegisterPasses(executor, keepUnsetScalarOptions || parameters.backendPasses.Test(BackendPass::SpecializationConstants));
+
+			if (parameters.backendPasses.Test(BackendPass::Optimize))
+				executor.AddPass<Ast::ConstantPropagationTransformer>();
+
+			if (parameters.backendPasses.Test(BackendPass::Validate))
+			{
+				executor.AddPass<Ast::ValidationTransformer>([](Ast::ValidationTransformer::Options& opt)
+				{
+					opt.allowUntyped = false;
+					opt.checkIndices = true;
+				});
+			}
+
+			Ast::TransformerContext context;
+			context.optionValues = parameters.optionValues;
+
+			executor.Transform(module, context);
+		}
+
+		if (parameters.backendPasses.Test(BackendPass::RemoveDeadCode))
+		{
+			Ast::DependencyCheckerVisitor::Config dependencyConfig;
+			dependencyConfig.usedShaderStages = ShaderStageType_All;
+
+			Ast::PassInstrumentation::Scope instrumentationScope(parameters.passInstrumentation, "RemoveDeadCode");
+			Ast::EliminateUnusedPass(module, dependencyConfig);
+		}
 	}
 }
@@ -26,6 +26,7 @@
 #include <frozen/string.h>
 #include <frozen/unordered_map.h>
 #include <nlohmann/json.hpp>
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <fstream>
@@ -55,6 +56,7 @@ namespace nzslc
 	m_parentStep(Nz::MaxValue()),
 	m_logFormat(LogFormat::Classic),
 	m_options(options),
+	m_isMeasuringPasses(false),
 	m_isProfiling(false),
 	m_outputToStdout(false),
 	m_skipOutput(false),
@@ -110,6 +112,9 @@ namespace nzslc
 		if (m_options.count("measure") > 0)
 			m_isProfiling = m_options["measure"].as<bool>();
 
+		if (m_options.count("measure-passes") > 0)
+			m_isMeasuringPasses = m_options["measure-passes"].as<bool>();
+
 		m_skipUnchangedOutput = m_options.count("skip-unchanged") > 0;
 		m_verbose = m_options.count("verbose") > 0;
 	}
@@ -126,7 +131,7 @@ namespace nzslc
 				try
 				{
 					// Retrieve line
-					std::string sourceContent = ReadSourceFileContent(*errorLocation.file);
+					std::string sourceContent = ReadSourceFileContent(*errorLocation.GetFile());
 
 					std::size_t lineStartOffset = 0;
 					if (errorLocation.startLine > 1)
@@ -178,8 +183,8 @@ namespace nzslc
 			{
 				// VS requires absolute path
 				std::filesystem::path fullPath;
-				if (errorLocation.file)
-					fullPath = std::filesystem::absolute(*errorLocation.file);
+				if (const auto& filePath = errorLocation.GetFile())
+					fullPath = std::filesystem::absolute(*filePath);
 
 				fmt::print(stderr, "{}({},{}): error {}: {}\n", Nz::PathToString(fullPath), errorLocation.startLine, errorLocation.startColumn, ToString(error.GetErrorType()), error.GetErrorMessage());
 			}
@@ -206,6 +211,9 @@ namespace nzslc
 
 		if (m_isProfiling)
 			PrintTime();
+
+		if (m_isMeasuringPasses)
+			PrintPassStatistics();
 	}
 
 	cxxopts::Options Compiler::BuildOptions()
@@ -215,6 +223,7 @@ namespace nzslc
 		options.add_options()
 			("benchmark-iteration", "Benchmark each step of the compilation repeat over a huge number of time, implies --measure", cxxopts::value<unsigned int>()->implicit_value("1000"))
 			("measure", "Measure time taken for every step of the compilation process", cxxopts::value<bool>()->default_value("false"))
+			("measure-passes", "Measure time, visited nodes and allocations of every pass run by the backends", cxxopts::value<bool>()->default_value("false"))
 			("log-format", "Set log format (classic, vs)", cxxopts::value<std::string>())
 			("i,input", "Input file(s)", cxxopts::value<std::string>())
 			("o,output", "Output path (use @stdout to output on stdout)", cxxopts::value<std::string>()->default_value("."), "path")
@@ -248,6 +257,8 @@ You can also specify -header as a suffix (ex: --compile=glsl-header) to generate
 			("gl-bindingmap", "Add binding support (generates a .binding.json mapping file)");
 
 		options.add_options("spirv output")
+			("spv-optimize", "Run the SPIR-V optimizer on the generated module (removes dead code, redundant loads and duplicate constants, compacts ids)")
+			("spv-specconstants", "Emit options with no value as specialization constants (using option hash as SpecId)")
 			("spv-version", "SPIR-V version (110 being 1.1)", cxxopts::value<std::uint32_t>(), "version");
 
 		options.parse_positional("input");
@@ -263,6 +274,12 @@ You can also specify -header as a suffix (ex: --compile=glsl-header) to generate
 		if (m_options.count("optimize"))
 			parameters.backendPasses |= nzsl::BackendPass::Optimize | nzsl::BackendPass::RemoveDeadCode;
 
+		if (m_options.count("spv-optimize"))
+			parameters.backendPasses |= nzsl::BackendPass::OptimizeSpirv;
+
+		if (m_options.count("spv-specconstants"))
+			parameters.backendPasses |= nzsl::BackendPass::SpecializationConstants;
+
 		if (m_options.count("debug-level"))
 		{
 			const std::string& debugLevelStr = m_options["debug-level"].as<std::string>();
@@ -274,6 +291,32 @@ You can also specify -header as a suffix (ex: --compile=glsl-header) to generate
 			parameters.debugLevel = it->second;
 		}
 
+		if (m_isMeasuringPasses)
+		{
+			parameters.passInstrumentation.callback = [this](const nzsl::Ast::PassStatistics& statistics)
+			{
+				auto it = std::find_if(m_passStatistics.begin(), m_passStatistics.end(), [&](const PassStatistics& passStatistics) { return passStatistics.name == statistics.passName; });
+				if (it == m_passStatistics.end())
+				{
+					it = m_passStatistics.emplace(m_passStatistics.end());
+					it->name = statistics.passName;
+					it->allocatedBytes = 0;
+					it->allocationCount = 0;
+					it->createdNodeCount = 0;
+					it->replacedNodeCount = 0;
+					it->visitedNodeCount = 0;
+					it->time = 0;
+				}
+
+				it->allocatedBytes += statistics.allocatedBytes;
+				it->allocationCount += statistics.allocationCount;
+				it->createdNodeCount += statistics.createdNodeCount;
+				it->replacedNodeCount += statistics.replacedNodeCount;
+				it->visitedNodeCount += statistics.visitedNodeCount;
+				it->time += std::chrono::duration_cast<std::chrono::microseconds>(statistics.duration).count();
+			};
+		}
+
 		return parameters;
 	}
 
@@ -594,6 +637,16 @@ You can also specify -header as a suffix (ex: --compile=glsl-header) to generate
 		return nzsl::Ast::DeserializeShader(deserializer);
 	}
 
+	void Compiler::PrintPassStatistics()
+	{
+		fmt::print("Backend passes:\n");
+		for (const PassStatistics& passStatistics : m_passStatistics)
+		{
+			fmt::print("- {}: {}", passStatistics.name, fmt::format(fg(fmt::color::dark_golden_rod), "{}us", passStatistics.time / m_iterationCount));
+			fmt::print(" (visited nodes: {} - replaced nodes: {} - created nodes: {} - allocations: {} for {} bytes)\n", passStatistics.visitedNodeCount / m_iterationCount, passStatistics.replacedNodeCount / m_iterationCount, passStatistics.createdNodeCount / m_iterationCount, passStatistics.allocationCount / m_iterationCount, passStatistics.allocatedBytes / m_iterationCount);
+		}
+	}
+
 	void Compiler::PrintTime()
 	{
 		long long fullTime = std::max(m_steps[0].time, 1LL); //< prevent a divison by zero
@@ -678,8 +731,7 @@ You can also specify -header as a suffix (ex: --compile=glsl-header) to generate
 		{
 			std::string sourceContent = Step("File reading"sv, __LINE__, &Compiler::ReadSourceFileContent, m_inputFilePath);
 			std::string sourceFile = Nz::PathToString(m_inputFilePath);
-			std::vector<nzsl::Token> tokens = Step("Tokenizing", __LINE__, [&] { return nzsl::Tokenize(sourceContent, sourceFile); });
-			m_shaderModule = Step("Parsing"sv, __LINE__, [&] { return nzsl::Parse(tokens); });
+			m_shaderModule = Step("Parsing"sv, __LINE__, [&] { return nzsl::Parse(sourceContent, sourceFile); }); //< tokens are lexed on demand by the parser
 		}
 		else if (extension == ".nzslb")
 		{
@@ -60,6 +60,7 @@ namespace nzslc
 			void CompileToNZSLB(std::filesystem::path outputPath, const nzsl::Ast::Module& module);
 			void CompileToSPV(std::filesystem::path outputPath, nzsl::Ast::Module& module, bool textual);
 			nzsl::Ast::ModulePtr Deserialize(const std::uint8_t* data, std::size_t size);
+			void PrintPassStatistics();
 			void PrintTime();
 			void OutputFile(std::filesystem::path filePath, const void* data, std::size_t size, bool disallowHeader = false);
 			void OutputToStdout(std::string_view str);
@@ -74,6 +75,17 @@ namespace nzslc
 			static std::string ReadSourceFileContent(const std::filesystem::path& filePath);
 			static std::string ToHeader(const void* data, std::size_t size);
 
+			struct PassStatistics
+			{
+				std::string name;
+				std::size_t allocatedBytes;
+				std::size_t allocationCount;
+				std::size_t createdNodeCount;
+				std::size_t replacedNodeCount;
+				std::size_t visitedNodeCount;
+				long long time;
+			};
+
 			struct StepTime
 			{
 				std::size_t childrenCount;
@@ -85,10 +97,12 @@ namespace nzslc
 			std::filesystem::path m_outputPath;
 			std::size_t m_parentStep;
 			std::unordered_map<std::size_t, std::size_t> m_stepIndices;
+			std::vector<PassStatistics> m_passStatistics;
 			std::vector<StepTime> m_steps;
 			LogFormat m_logFormat;
 			nzsl::Ast::ModulePtr m_shaderModule;
 			cxxopts::ParseResult& m_options;
+			bool m_isMeasuringPasses;
 			bool m_isProfiling;
 			bool m_outputHeader;
 			bool m_outputToStdout;
@@ -0,0 +1,110 @@
+#include <NZSL/Parser.hpp>
+#include <NZSL/SpirvWriter.hpp>
+#include <NZSL/Ast/TransformerExecutor.hpp>
+#include <NZSL/Ast/Transformations/ResolveTransformer.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <string>
+#include <vector>
+
+// Benchmarks are hidden (run them with "UnitTests [Benchmark]")
+
+namespace
+{
+	std::string BuildShaderWithGlobals(std::size_t globalCount)
+	{
+		std::string source = R"(
+[nzsl_version("1.1")]
+module;
+)";
+
+		for (std::size_t i = 0; i < globalCount; ++i)
+			source += "const Global" + std::to_string(i) + " = " + std::to_string(i) + ";\n";
+
+		// Every global is looked up by name, from a nested scope
+		source += R"(
+[entry(frag)]
+fn main()
+{
+	let value = 0;
+)";
+
+		for (std::size_t i = 0; i < globalCount; ++i)
+			source += "\tvalue += Global" + std::to_string(i) + ";\n";
+
+		source += "}\n";
+
+		return source;
+	}
+
+	std::string BuildShaderWithMatrixOperations(std::size_t operationCount)
+	{
+		std::string source = R"(
+[nzsl_version("1.1")]
+module;
+
+[entry(frag)]
+fn main()
+{
+	let value = mat4[f32](1.0);
+	let factor = 0.5;
+)";
+
+		for (std::size_t i = 0; i < operationCount; ++i)
+		{
+			source += "\tif (factor > " + std::to_string(i) + ".0) value += mat4[f32](factor);\n";
+			source += "\telse if (factor < 0.0) value -= value;\n";
+		}
+
+		source += "}\n";
+
+		return source;
+	}
+}
+
+TEST_CASE("identifier lookup", "[.][Benchmark]")
+{
+	for (std::size_t globalCount : { 100, 1000, 5000 })
+	{
+		std::string source = BuildShaderWithGlobals(globalCount);
+
+		BENCHMARK_ADVANCED("resolving " + std::to_string(globalCount) + " globals")(Catch::Benchmark::Chronometer meter)
+		{
+			std::vector<nzsl::Ast::ModulePtr> modules(meter.runs());
+			for (auto& module : modules)
+				module = nzsl::Parse(source);
+
+			meter.measure([&](int i)
+			{
+				nzsl::Ast::TransformerContext context;
+				nzsl::Ast::ResolveTransformer resolver;
+				return resolver.Transform(*modules[i], context);
+			});
+		};
+	}
+}
+
+TEST_CASE("pass fusion", "[.][Benchmark]")
+{
+	std::string source = BuildShaderWithMatrixOperations(500);
+
+	for (bool passFusion : { false, true })
+	{
+		nzsl::Ast::TransformerExecutor executor;
+		executor.AddPass<nzsl::Ast::ResolveTransformer>();
+		nzsl::SpirvWriter::RegisterPasses(executor);
+		executor.EnablePassFusion(passFusion);
+
+		BENCHMARK_ADVANCED("SPIR-V passes (" + std::to_string(executor.GetTraversalCount()) + " traversals)")(Catch::Benchmark::Chronometer meter)
+		{
+			std::vector<nzsl::Ast::ModulePtr> modules(meter.runs());
+			for (auto& module : modules)
+				module = nzsl::Parse(source);
+
+			meter.measure([&](int i)
+			{
+				return executor.Transform(*modules[i]);
+			});
+		};
+	}
+}
@@ -0,0 +1,129 @@
+#include <Tests/ShaderUtils.hpp>
+#include <NZSL/CompilationSession.hpp>
+#include <NZSL/LangWriter.hpp>
+#include <NZSL/Parser.hpp>
+#include <NZSL/Ast/Cloner.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("compilation session", "[Shader]")
+{
+	std::string_view nzslSource = R"(
+[nzsl_version("1.1")]
+module;
+
+option UseColor: bool = false;
+
+struct VertOut
+{
+	[builtin(position)] position: vec4[f32]
+}
+
+struct FragOut
+{
+	[location(0)] color: vec4[f32]
+}
+
+[entry(vert)]
+fn vertMain() -> VertOut
+{
+	let output: VertOut;
+	output.position = vec4[f32](0.0, 0.0, 0.0, 1.0);
+	return output;
+}
+
+[entry(frag)]
+fn fragMain() -> FragOut
+{
+	let output: FragOut;
+	output.color = const_select(UseColor, vec4[f32](1.0, 0.0, 0.0, 1.0), vec4[f32](1.0, 1.0, 1.0, 1.0));
+	return output;
+}
+)";
+
+	// Option values are only given to jobs
+	nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(nzslSource);
+	{
+		nzsl::Ast::TransformerContext context;
+		context.partialCompilation = true;
+
+		nzsl::Ast::ResolveTransformer resolver;
+		REQUIRE_NOTHROW(resolver.Transform(*shaderModule, context, {}));
+	}
+
+	std::string originalModule = nzsl::LangWriter{}.Generate(*shaderModule);
+
+	nzsl::CompilationSession session(shaderModule);
+
+	std::vector<nzsl::CompilationSession::Job> jobs;
+	for (bool useColor : { false, true })
+	{
+		for (nzsl::ShaderStageType stage : { nzsl::ShaderStageType::Fragment, nzsl::ShaderStageType::Vertex })
+		{
+			auto& glslJob = jobs.emplace_back();
+			glslJob.backend = nzsl::CompilationSession::Backend::Glsl;
+			glslJob.parameters.optionValues[nzsl::Ast::HashOption("UseColor")] = useColor;
+			glslJob.shaderStage = stage;
+		}
+
+		auto& spirvJob = jobs.emplace_back();
+		spirvJob.backend = nzsl::CompilationSession::Backend::Spirv;
+		spirvJob.parameters.optionValues[nzsl::Ast::HashOption("UseColor")] = useColor;
+	}
+
+	// An invalid job (the option is used as a boolean condition) shouldn't prevent others from completing
+	auto& invalidJob = jobs.emplace_back();
+	invalidJob.backend = nzsl::CompilationSession::Backend::Glsl;
+	invalidJob.parameters.optionValues[nzsl::Ast::HashOption("UseColor")] = 42;
+	invalidJob.shaderStage = nzsl::ShaderStageType::Fragment;
+
+	for (const auto& job : jobs)
+		session.AddJob(job);
+
+	REQUIRE(session.GetJobCount() == jobs.size());
+
+	auto CheckResults = [&](const std::vector<nzsl::CompilationSession::Result>& results)
+	{
+		REQUIRE(results.size() == jobs.size());
+
+		// Results must match a sequential compilation, in the order jobs were added
+		for (std::size_t i = 0; i < jobs.size(); ++i)
+		{
+			const auto& job = jobs[i];
+			const auto& result = results[i];
+
+			if (&job == &jobs.back())
+			{
+				CHECK(result.error);
+				continue;
+			}
+
+			REQUIRE_FALSE(result.error);
+
+			nzsl::Ast::ModulePtr moduleCopy = nzsl::Ast::Clone(*shaderModule);
+			if (job.backend == nzsl::CompilationSession::Backend::Glsl)
+			{
+				nzsl::GlslWriter glslWriter;
+				CHECK(result.glslOutput.code == glslWriter.Generate(job.shaderStage, *moduleCopy, job.parameters).code);
+			}
+			else
+			{
+				nzsl::SpirvWriter spirvWriter;
+				CHECK(result.spirv == spirvWriter.Generate(*moduleCopy, job.parameters));
+			}
+		}
+	};
+
+	WHEN("Running jobs on the calling thread")
+	{
+		CheckResults(session.Run(1));
+	}
+
+	WHEN("Running jobs on multiple threads")
+	{
+		CheckResults(session.Run(4));
+		CheckResults(session.Run());
+	}
+
+	// Jobs work on their own copy of the module
+	CHECK(nzsl::LangWriter{}.Generate(*shaderModule) == originalModule);
+}
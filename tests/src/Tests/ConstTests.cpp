@@ -2,6 +2,8 @@
 #include <NZSL/FilesystemModuleResolver.hpp>
 #include <NZSL/ShaderBuilder.hpp>
 #include <NZSL/Parser.hpp>
+#include <NZSL/SpirV/SpirvPrinter.hpp>
+#include <NZSL/Ast/Cloner.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <cctype>
 
@@ -157,6 +159,385 @@ fn main()
 }
 )");
 		}
+
+		WHEN("Generating permutations")
+		{
+			using namespace nzsl::Ast::Literals;
+
+			std::vector<nzsl::OptionValues> optionPermutations(3);
+			optionPermutations[0]["UseInt"_opt] = true;
+			optionPermutations[1]["UseInt"_opt] = false;
+			optionPermutations[2]["UseInt"_opt] = false;
+			optionPermutations[2]["UnusedOption"_opt] = 42;
+
+			// Permutations are resolved once but must match a separate compilation of each of them
+			nzsl::Ast::ModulePtr originalModule = nzsl::Ast::Clone(*shaderModule);
+
+			nzsl::GlslWriter glslWriter;
+			nzsl::PermutationOutputs<nzsl::GlslWriter::Output> glslPermutations = glslWriter.GeneratePermutations(nzsl::ShaderStageType::Fragment, *shaderModule, optionPermutations);
+			REQUIRE(glslPermutations.outputIndices.size() == optionPermutations.size());
+
+			// the module given to GeneratePermutations is left untouched
+			CHECK(nzsl::Ast::Compare(*shaderModule, *originalModule));
+
+			for (std::size_t i = 0; i < optionPermutations.size(); ++i)
+			{
+				nzsl::BackendParameters parameters;
+				parameters.optionValues = optionPermutations[i];
+
+				REQUIRE(glslPermutations.outputIndices[i] < glslPermutations.outputs.size());
+				CHECK(glslPermutations.outputs[glslPermutations.outputIndices[i]].code == glslWriter.Generate(nzsl::ShaderStageType::Fragment, *nzsl::Ast::Clone(*shaderModule), parameters).code);
+			}
+
+			// The last permutation only differs by an option which isn't declared, it shares the output of the second one
+			CHECK(glslPermutations.outputs.size() == 2);
+			CHECK(glslPermutations.outputIndices[0] != glslPermutations.outputIndices[1]);
+			CHECK(glslPermutations.outputIndices[1] == glslPermutations.outputIndices[2]);
+
+			nzsl::SpirvWriter spirvWriter;
+			nzsl::PermutationOutputs<std::vector<std::uint32_t>> spirvPermutations = spirvWriter.GeneratePermutations(*nzsl::Ast::Clone(*shaderModule), optionPermutations);
+			REQUIRE(spirvPermutations.outputIndices.size() == optionPermutations.size());
+			CHECK(spirvPermutations.outputs.size() == 2);
+			CHECK(spirvPermutations.outputIndices[1] == spirvPermutations.outputIndices[2]);
+			CHECK(spirvPermutations.outputs[spirvPermutations.outputIndices[0]] != spirvPermutations.outputs[spirvPermutations.outputIndices[1]]);
+
+			// Permutations giving the same values to declared options are only resolved and generated once
+			std::size_t resolveCount = 0;
+			std::size_t generationCount = 0;
+
+			nzsl::BackendParameters instrumentedParameters;
+			instrumentedParameters.passInstrumentation.callback = [&](const nzsl::Ast::PassStatistics& statistics)
+			{
+				if (statistics.passName.substr(0, 7) == "Resolve")
+					resolveCount++;
+				else if (statistics.passName == "SPIR-V generation")
+					generationCount++;
+			};
+
+			std::vector<nzsl::OptionValues> repeatedPermutations = optionPermutations;
+			repeatedPermutations.push_back(optionPermutations[0]);
+			repeatedPermutations.push_back(optionPermutations[1]);
+
+			nzsl::PermutationOutputs<std::vector<std::uint32_t>> repeatedOutputs = spirvWriter.GeneratePermutations(*nzsl::Ast::Clone(*shaderModule), repeatedPermutations, instrumentedParameters);
+			REQUIRE(repeatedOutputs.outputIndices.size() == repeatedPermutations.size());
+			CHECK(repeatedOutputs.outputs.size() == 2);
+			CHECK(repeatedOutputs.outputIndices[3] == repeatedOutputs.outputIndices[0]);
+			CHECK(repeatedOutputs.outputIndices[4] == repeatedOutputs.outputIndices[1]);
+
+			// one partial resolve for all permutations, then one per distinct set of option values (instead of one per permutation)
+			CHECK(resolveCount == 1 + 2);
+			CHECK(generationCount == 2);
+
+			// Code generation flags are applied to permutations as well
+			nzsl::BackendParameters promotionParameters;
+			promotionParameters.backendPasses |= nzsl::BackendPass::PromoteVariables;
+
+			nzsl::PermutationOutputs<std::vector<std::uint32_t>> promotedPermutations = spirvWriter.GeneratePermutations(*nzsl::Ast::Clone(*shaderModule), optionPermutations, promotionParameters);
+			REQUIRE(promotedPermutations.outputIndices.size() == optionPermutations.size());
+
+			for (std::size_t i = 0; i < optionPermutations.size(); ++i)
+			{
+				nzsl::BackendParameters parameters = promotionParameters;
+				parameters.optionValues = optionPermutations[i];
+
+				REQUIRE(promotedPermutations.outputIndices[i] < promotedPermutations.outputs.size());
+				CHECK(promotedPermutations.outputs[promotedPermutations.outputIndices[i]] == spirvWriter.Generate(*nzsl::Ast::Clone(*shaderModule), parameters));
+			}
+
+			nzsl::BackendParameters optimizationParameters;
+			optimizationParameters.backendPasses |= nzsl::BackendPass::OptimizeSpirv;
+
+			nzsl::PermutationOutputs<std::vector<std::uint32_t>> optimizedPermutations = spirvWriter.GeneratePermutations(*nzsl::Ast::Clone(*shaderModule), optionPermutations, optimizationParameters);
+			REQUIRE(optimizedPermutations.outputIndices.size() == optionPermutations.size());
+
+			for (std::size_t i = 0; i < optionPermutations.size(); ++i)
+			{
+				nzsl::BackendParameters parameters = optimizationParameters;
+				parameters.optionValues = optionPermutations[i];
+
+				REQUIRE(optimizedPermutations.outputIndices[i] < optimizedPermutations.outputs.size());
+				CHECK(optimizedPermutations.outputs[optimizedPermutations.outputIndices[i]] == spirvWriter.Generate(*nzsl::Ast::Clone(*shaderModule), parameters));
+			}
+		}
+	}
+
+	WHEN("using options as specialization constants")
+	{
+		std::string_view sourceCode = R"(
+[nzsl_version("1.1")]
+module;
+
+option UseColor: bool = false;
+option Factor: f32 = 2.0;
+
+struct FragOut
+{
+	[location(0)] value: f32
+}
+
+[entry(frag)]
+fn main() -> FragOut
+{
+	let output: FragOut;
+	output.value = Factor * 3.0;
+	if (UseColor)
+	{
+		output.value = 0.0;
+	}
+
+	return output;
+}
+)";
+
+		nzsl::Ast::ModulePtr shaderModule;
+		REQUIRE_NOTHROW(shaderModule = nzsl::Parse(sourceCode));
+		ResolveModule(*shaderModule);
+
+		nzsl::BackendParameters options;
+		options.backendPasses |= nzsl::BackendPass::SpecializationConstants;
+
+		// options are used directly, without any load, and the branch is kept
+		ExpectSPIRV(*shaderModule, R"(
+OpFunction
+OpLabel
+OpVariable
+OpFMul
+OpAccessChain
+OpStore
+OpSelectionMerge
+OpBranchConditional
+OpLabel
+OpAccessChain
+OpStore
+OpBranch
+OpLabel
+OpLoad
+OpCompositeExtract
+OpStore
+OpReturn
+OpFunctionEnd)", options);
+
+		nzsl::SpirvWriter spirvWriter;
+		std::vector<std::uint32_t> spirv = spirvWriter.Generate(*nzsl::Ast::Clone(*shaderModule), options);
+
+		nzsl::SpirvPrinter::Settings settings;
+		settings.printHeader = false;
+
+		std::string output = nzsl::SpirvPrinter{}.Print(spirv.data(), spirv.size(), settings);
+		CHECK(output.find("OpSpecConstantFalse") != std::string::npos);
+		CHECK(output.find("OpSpecConstant ") != std::string::npos);
+		CHECK(output.find("Decoration(SpecId) " + std::to_string(nzsl::Ast::HashOption("UseColor"))) != std::string::npos);
+		CHECK(output.find("Decoration(SpecId) " + std::to_string(nzsl::Ast::HashOption("Factor"))) != std::string::npos);
+
+		// without the pass, options are replaced by their value
+		std::string defaultOutput = nzsl::SpirvPrinter{}.Print(spirvWriter.Generate(*nzsl::Ast::Clone(*shaderModule)), settings);
+		CHECK(defaultOutput.find("OpSpecConstant") == std::string::npos);
+	}
+
+	WHEN("generating permutations of options only used at runtime")
+	{
+		using namespace nzsl::Ast::Literals;
+
+		std::string_view sourceCode = R"(
+[nzsl_version("1.1")]
+module;
+
+option UseColor: bool = false;
+option Factor: f32 = 2.0;
+
+struct FragOut
+{
+	[location(0)] value: f32
+}
+
+[entry(frag)]
+fn main() -> FragOut
+{
+	let output: FragOut;
+	output.value = Factor * 3.0;
+	if (UseColor)
+	{
+		output.value = 0.0;
+	}
+
+	return output;
+}
+)";
+
+		nzsl::Ast::ModulePtr shaderModule;
+		REQUIRE_NOTHROW(shaderModule = nzsl::Parse(sourceCode));
+
+		std::vector<nzsl::OptionValues> optionPermutations(3);
+		optionPermutations[0]["UseColor"_opt] = true;
+		optionPermutations[1]["UseColor"_opt] = false;
+		optionPermutations[1]["Factor"_opt] = 4.f;
+
+		nzsl::BackendParameters permutationParameters;
+		permutationParameters.backendPasses |= nzsl::BackendPass::Optimize | nzsl::BackendPass::RemoveDeadCode;
+
+		// The module is resolved and transformed once, permutations only replace options by their value
+		std::size_t resolveCount = 0;
+		std::size_t generationCount = 0;
+
+		nzsl::BackendParameters instrumentedParameters = permutationParameters;
+		instrumentedParameters.passInstrumentation.callback = [&](const nzsl::Ast::PassStatistics& statistics)
+		{
+			if (statistics.passName.substr(0, 7) == "Resolve")
+				resolveCount++;
+			else if (statistics.passName == "SPIR-V generation")
+				generationCount++;
+		};
+
+		nzsl::SpirvWriter spirvWriter;
+		nzsl::PermutationOutputs<std::vector<std::uint32_t>> spirvPermutations = spirvWriter.GeneratePermutations(*shaderModule, optionPermutations, instrumentedParameters);
+		REQUIRE(spirvPermutations.outputIndices.size() == optionPermutations.size());
+
+		// one partial resolve, then one full resolve shared by all permutations
+		CHECK(resolveCount == 2);
+		CHECK(generationCount == 3);
+
+		nzsl::GlslWriter glslWriter;
+		nzsl::PermutationOutputs<nzsl::GlslWriter::Output> glslPermutations = glslWriter.GeneratePermutations(nzsl::ShaderStageType::Fragment, *shaderModule, optionPermutations, permutationParameters);
+		REQUIRE(glslPermutations.outputIndices.size() == optionPermutations.size());
+
+		for (std::size_t i = 0; i < optionPermutations.size(); ++i)
+		{
+			nzsl::BackendParameters parameters = permutationParameters;
+			parameters.optionValues = optionPermutations[i];
+
+			REQUIRE(spirvPermutations.outputIndices[i] < spirvPermutations.outputs.size());
+			CHECK(spirvPermutations.outputs[spirvPermutations.outputIndices[i]] == spirvWriter.Generate(*nzsl::Ast::Clone(*shaderModule), parameters));
+
+			REQUIRE(glslPermutations.outputIndices[i] < glslPermutations.outputs.size());
+			CHECK(glslPermutations.outputs[glslPermutations.outputIndices[i]].code == glslWriter.Generate(nzsl::ShaderStageType::Fragment, *nzsl::Ast::Clone(*shaderModule), parameters).code);
+		}
+
+		// unset options stay specialization constants in each permutation
+		nzsl::BackendParameters specializationParameters = permutationParameters;
+		specializationParameters.backendPasses |= nzsl::BackendPass::SpecializationConstants;
+
+		nzsl::PermutationOutputs<std::vector<std::uint32_t>> specializedPermutations = spirvWriter.GeneratePermutations(*shaderModule, optionPermutations, specializationParameters);
+		REQUIRE(specializedPermutations.outputIndices.size() == optionPermutations.size());
+
+		for (std::size_t i = 0; i < optionPermutations.size(); ++i)
+		{
+			nzsl::BackendParameters parameters = specializationParameters;
+			parameters.optionValues = optionPermutations[i];
+
+			REQUIRE(specializedPermutations.outputIndices[i] < specializedPermutations.outputs.size());
+			CHECK(specializedPermutations.outputs[specializedPermutations.outputIndices[i]] == spirvWriter.Generate(*nzsl::Ast::Clone(*shaderModule), parameters));
+		}
+	}
+
+	WHEN("using options as specialization constants in compile-time contexts")
+	{
+		std::string_view sourceCode = R"(
+[nzsl_version("1.1")]
+module;
+
+option UseColor: bool = false;
+option Factor: f32 = 2.0;
+
+struct FragOut
+{
+	[location(0)] value: f32
+}
+
+[entry(frag)]
+fn main() -> FragOut
+{
+	let output: FragOut;
+	output.value = Factor * 3.0;
+	const if (UseColor)
+	{
+		output.value = 1.0;
+	}
+
+	if (UseColor)
+	{
+		output.value = 0.0;
+	}
+
+	return output;
+}
+)";
+
+		nzsl::BackendParameters options;
+		options.backendPasses |= nzsl::BackendPass::SpecializationConstants;
+
+		nzsl::SpirvPrinter::Settings settings;
+		settings.printHeader = false;
+
+		auto CheckSpecConstants = [&](nzsl::Ast::Module& module)
+		{
+			nzsl::SpirvWriter spirvWriter;
+			std::vector<std::uint32_t> spirv = spirvWriter.Generate(module, options);
+
+			// UseColor value was used by the const if, it has to stay a regular constant
+			std::string output = nzsl::SpirvPrinter{}.Print(spirv.data(), spirv.size(), settings);
+			CHECK(output.find("OpSpecConstantFalse") == std::string::npos);
+			CHECK(output.find("Decoration(SpecId) " + std::to_string(nzsl::Ast::HashOption("UseColor"))) == std::string::npos);
+			CHECK(output.find("Decoration(SpecId) " + std::to_string(nzsl::Ast::HashOption("Factor"))) != std::string::npos);
+		};
+
+		WHEN("Generating from the parsed module")
+		{
+			nzsl::Ast::ModulePtr shaderModule;
+			REQUIRE_NOTHROW(shaderModule = nzsl::Parse(sourceCode));
+
+			CheckSpecConstants(*shaderModule);
+		}
+
+		WHEN("Generating from a resolved module")
+		{
+			nzsl::Ast::ModulePtr shaderModule;
+			REQUIRE_NOTHROW(shaderModule = nzsl::Parse(sourceCode));
+			ResolveModule(*shaderModule);
+
+			// the const if has been resolved, the option remembers its value was used
+			CheckSpecConstants(*shaderModule);
+		}
+	}
+
+	WHEN("using options with the same specialization constant id")
+	{
+		// both option names have the same 32-bit FNV-1a hash
+		std::string_view sourceCode = R"(
+[nzsl_version("1.1")]
+module;
+
+option Opt179599: f32 = 1.0;
+option Opt362382: f32 = 2.0;
+
+struct FragOut
+{
+	[location(0)] value: f32
+}
+
+[entry(frag)]
+fn main() -> FragOut
+{
+	let output: FragOut;
+	output.value = Opt179599 * Opt362382;
+
+	return output;
+}
+)";
+
+		REQUIRE(nzsl::Ast::HashOption("Opt179599") == nzsl::Ast::HashOption("Opt362382"));
+
+		nzsl::Ast::ModulePtr shaderModule;
+		REQUIRE_NOTHROW(shaderModule = nzsl::Parse(sourceCode));
+
+		nzsl::BackendParameters options;
+		options.backendPasses |= nzsl::BackendPass::SpecializationConstants;
+
+		nzsl::SpirvWriter spirvWriter;
+		CHECK_THROWS_WITH(spirvWriter.Generate(*nzsl::Ast::Clone(*shaderModule), options), "options Opt179599 and Opt362382 have the same specialization constant id (" + std::to_string(nzsl::Ast::HashOption("Opt179599")) + "), rename one of them or give it a value");
+
+		// giving a value to one of them leaves a single specialization constant
+		options.optionValues[nzsl::Ast::HashOption("Opt362382")] = 3.f;
+		CHECK_NOTHROW(spirvWriter.Generate(*nzsl::Ast::Clone(*shaderModule), options));
 	}
 
 	WHEN("using [unroll] attribute on numerical for")
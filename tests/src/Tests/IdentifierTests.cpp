@@ -3,6 +3,7 @@
 #include <NZSL/Parser.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <cctype>
+#include <thread>
 
 TEST_CASE("identifiers", "[Shader]")
 {
@@ -148,4 +149,62 @@ OpLoad
 OpReturn
 OpFunctionEnd)");
 	}
+
+	SECTION("Interned identifiers")
+	{
+		nzsl::Ast::InternedString foo("foo");
+		nzsl::Ast::InternedString otherFoo(std::string("fo") + "o");
+		nzsl::Ast::InternedString bar("bar");
+
+		CHECK(foo == otherFoo);
+		CHECK(&foo.GetString() == &otherFoo.GetString());
+		CHECK(foo != bar);
+		CHECK(foo == "foo");
+		CHECK(nzsl::Ast::InternedString("").IsEmpty());
+		CHECK(nzsl::Ast::InternedString() == nzsl::Ast::InternedString(""));
+
+		auto firstIdentifier = nzsl::ShaderBuilder::Identifier("foo");
+		auto secondIdentifier = nzsl::ShaderBuilder::Identifier(std::string_view("foo"));
+		CHECK(firstIdentifier->identifier == secondIdentifier->identifier);
+		CHECK(firstIdentifier->identifier == foo);
+
+		// strings interned from other threads share the same entries
+		std::vector<nzsl::Ast::InternedString> threadStrings(4);
+		std::vector<std::thread> threads;
+		for (std::size_t i = 0; i < threadStrings.size(); ++i)
+		{
+			threads.emplace_back([&, i]
+			{
+				for (std::size_t j = 0; j < 100; ++j)
+					nzsl::Ast::InternedString(std::to_string(j) + "_thread");
+
+				threadStrings[i] = nzsl::Ast::InternedString("foo");
+			});
+		}
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+		for (const nzsl::Ast::InternedString& threadString : threadStrings)
+			CHECK(threadString == foo);
+	}
+
+	SECTION("Clearing interned identifiers")
+	{
+		// "foo" is now cached by this thread, clearing the table must invalidate the cache as well
+		nzsl::Ast::InternedString("foo");
+		nzsl::Ast::InternedString::ClearTable();
+
+		nzsl::Ast::InternedString foo("foo");
+		CHECK(foo.GetString() == "foo");
+
+		nzsl::Ast::InternedString threadFoo;
+		std::thread thread([&]
+		{
+			threadFoo = nzsl::Ast::InternedString("foo");
+		});
+		thread.join();
+
+		CHECK(threadFoo == foo);
+	}
 }
@@ -65,4 +65,116 @@ Let Identifier(b) Assign Identifier(a) Semicolon
 ClosingCurlyBracket
 EndOfStream)");
 	}
+
+	SECTION("Token stream")
+	{
+		nzsl::TokenStream emptyStream("");
+		CHECK(nzsl::ToString(emptyStream) == "EndOfStream");
+
+		std::string_view nzslSource = R"(
+[nzsl_version("1.1")]
+module;
+
+[entry(frag)]
+fn main(/* no parameters*/)
+{
+	let a = 42; // the answer
+	let b = a;
+}
+)";
+
+		// lexing on demand must yield the same tokens as tokenizing everything upfront
+		nzsl::TokenStream tokenStream(nzslSource);
+		CHECK(nzsl::ToString(tokenStream) == nzsl::ToString(nzsl::Tokenize(nzslSource)));
+	}
+
+	SECTION("String literals")
+	{
+		std::string_view nzslSource = R"("Hello" "line\nbreak" "\"quoted\"")";
+
+		nzsl::TokenStream tokenStream(nzslSource);
+
+		const nzsl::TokenView& helloToken = tokenStream.Advance();
+		REQUIRE(helloToken.type == nzsl::TokenType::StringValue);
+		CHECK(std::get<std::string_view>(helloToken.data) == "Hello");
+		CHECK(std::get<std::string_view>(helloToken.data).data() == nzslSource.data() + 1); //< views into the source
+
+		const nzsl::TokenView& lineBreakToken = tokenStream.Advance();
+		REQUIRE(lineBreakToken.type == nzsl::TokenType::StringValue);
+		CHECK(std::get<std::string_view>(lineBreakToken.data) == R"(line\nbreak)");
+		CHECK(nzsl::UnescapeString(std::get<std::string_view>(lineBreakToken.data)) == "line\nbreak");
+
+		const nzsl::TokenView& quotedToken = tokenStream.Advance();
+		REQUIRE(quotedToken.type == nzsl::TokenType::StringValue);
+		CHECK(nzsl::UnescapeString(std::get<std::string_view>(quotedToken.data)) == "\"quoted\"");
+
+		CHECK(tokenStream.Advance().type == nzsl::TokenType::EndOfStream);
+	}
+
+	SECTION("Compatibility vector API")
+	{
+		std::string_view nzslSource = "let a = b;";
+
+		std::vector<nzsl::Token> tokens = nzsl::Tokenize(nzslSource);
+		CHECK(nzsl::ToString(tokens) == "Let Identifier(a) Assign Identifier(b) Semicolon EndOfStream");
+
+		nzsl::TokenStream tokenStream(tokens);
+		CHECK(nzsl::ToString(tokenStream) == "Let Identifier(a) Assign Identifier(b) Semicolon EndOfStream");
+
+		// tokenized strings own their value and are unescaped, streaming them escapes them back
+		std::vector<nzsl::Token> stringTokens = nzsl::Tokenize(R"("line\nbreak")");
+		REQUIRE(stringTokens.front().type == nzsl::TokenType::StringValue);
+		CHECK(std::get<std::string>(stringTokens.front().data) == "line\nbreak");
+
+		nzsl::TokenStream stringStream(stringTokens);
+		CHECK(nzsl::UnescapeString(std::get<std::string_view>(stringStream.Advance().data)) == "line\nbreak");
+	}
+
+	SECTION("Long tokens")
+	{
+		// long runs of characters are scanned by blocks, make sure block boundaries and tails are handled
+		std::string_view nzslSource = "let averyveryveryverylongidentifier_42 = 0x7EAD_BEEF_0000_1234 + 1_000_000_000_000 + 1_000.500_000_000_000_000_000;\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t // a comment long enough to span several blocks\n/* a block comment\nspanning several lines and longer than a single block */ x";
+
+		nzsl::TokenStream tokenStream(nzslSource);
+		CHECK(nzsl::ToString(tokenStream) == R"(Let Identifier(averyveryveryverylongidentifier_42) Assign IntegerValue(9128161953456329268) Plus IntegerValue(1000000000000) Plus FloatingPointValue(1000.5) Semicolon
+Identifier(x) EndOfStream)");
+	}
+
+	SECTION("Source file table")
+	{
+		nzsl::TokenStream firstStream("let a;", "shader.nzsl");
+		nzsl::TokenStream secondStream("let b;", "shader.nzsl");
+		nzsl::TokenStream unnamedStream("let c;");
+
+		const nzsl::SourceLocation& firstLocation = firstStream.Peek().location;
+		REQUIRE(firstLocation.fileIndex != 0);
+		CHECK(firstLocation.fileIndex == secondStream.Peek().location.fileIndex); //< same path, same index
+		REQUIRE(firstLocation.GetFile());
+		CHECK(*firstLocation.GetFile() == "shader.nzsl");
+
+		CHECK(unnamedStream.Peek().location.fileIndex == 0);
+		CHECK(unnamedStream.Peek().location.GetFile() == nullptr);
+
+		// clearing the table releases every path, indices are then given again from the start
+		nzsl::SourceLocation::ClearFileTable();
+
+		std::uint32_t fileIndex = nzsl::SourceLocation::RegisterFile("other.nzsl");
+		CHECK(fileIndex == 1);
+		CHECK(nzsl::SourceLocation::RegisterFile("shader.nzsl") == 2);
+		REQUIRE(nzsl::SourceLocation::ResolveFile(fileIndex));
+		CHECK(*nzsl::SourceLocation::ResolveFile(fileIndex) == "other.nzsl");
+	}
+
+	SECTION("Lazy tokenization")
+	{
+		// tokens are only lexed when reached, so errors happen when the faulty token is peeked
+		nzsl::TokenStream tokenStream("let a = $;");
+
+		CHECK(tokenStream.Peek().type == nzsl::TokenType::Let);
+		CHECK(tokenStream.Peek(1).type == nzsl::TokenType::Identifier);
+
+		tokenStream.Consume(2);
+		CHECK(tokenStream.Advance().type == nzsl::TokenType::Assign);
+		CHECK_THROWS_WITH(tokenStream.Peek(), "(1, 9): LUnrecognizedToken error: unrecognized token");
+	}
 }
@@ -954,4 +954,395 @@ OpLabel
 OpReturn
 OpFunctionEnd)");
 	}
+
+	WHEN("promoting variables to SSA values")
+	{
+		std::string_view nzslSource = R"(
+[nzsl_version("1.1")]
+module;
+
+[entry(frag)]
+fn main()
+{
+	let value = 0.0;
+	let color: vec4[f32];
+	let i = 0;
+	while (i < 10)
+	{
+		if (i >= 5)
+		{
+			value += 0.2;
+		}
+		else
+		{
+			value += 0.1;
+		}
+
+		i += 1;
+	}
+
+	color.x = value;
+}
+)";
+
+		nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(nzslSource);
+		ResolveModule(*shaderModule);
+
+		nzsl::BackendParameters options;
+		options.backendPasses |= nzsl::BackendPass::PromoteVariables;
+
+		ExpectSPIRV(*shaderModule, R"(
+OpFunction
+OpLabel
+OpUndef
+OpBranch
+OpLabel
+OpPhi
+OpPhi
+OpSLessThan
+OpLoopMerge
+OpBranchConditional
+OpLabel
+OpSGreaterThanEqual
+OpSelectionMerge
+OpBranchConditional
+OpLabel
+OpFAdd
+OpBranch
+OpLabel
+OpFAdd
+OpBranch
+OpLabel
+OpPhi
+OpIAdd
+OpBranch
+OpLabel
+OpPhi
+OpPhi
+OpBranch
+OpLabel
+OpCompositeInsert
+OpReturn
+OpFunctionEnd)", options);
+	}
+
+	WHEN("promoting variables across break and continue")
+	{
+		std::string_view nzslSource = R"(
+[nzsl_version("1.1")]
+module;
+
+[entry(frag)]
+fn main()
+{
+	let value = 0.0;
+	let i = 0;
+	while (i < 10)
+	{
+		value += 0.1;
+		i += 1;
+		if (i >= 8)
+			break;
+
+		if (i == 4)
+			continue;
+
+		value += 0.2;
+	}
+}
+)";
+
+		nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(nzslSource);
+		ResolveModule(*shaderModule);
+
+		nzsl::BackendParameters options;
+		options.backendPasses |= nzsl::BackendPass::PromoteVariables;
+
+		// the continue block merges values from the continue statement and the end of the body, the merge block those from the header and the break statement
+		ExpectSPIRV(*shaderModule, R"(
+OpFunction
+OpLabel
+OpBranch
+OpLabel
+OpPhi
+OpPhi
+OpSLessThan
+OpLoopMerge
+OpBranchConditional
+OpLabel
+OpFAdd
+OpIAdd
+OpSGreaterThanEqual
+OpSelectionMerge
+OpBranchConditional
+OpLabel
+OpBranch
+OpLabel
+OpBranch
+OpLabel
+OpIEqual
+OpSelectionMerge
+OpBranchConditional
+OpLabel
+OpBranch
+OpLabel
+OpBranch
+OpLabel
+OpFAdd
+OpBranch
+OpLabel
+OpPhi
+OpPhi
+OpBranch
+OpLabel
+OpPhi
+OpPhi
+OpReturn
+OpFunctionEnd)", options);
+	}
+
+	WHEN("promoting variables in nested loops")
+	{
+		std::string_view nzslSource = R"(
+[nzsl_version("1.1")]
+module;
+
+[entry(frag)]
+fn main()
+{
+	let x = 0;
+	let i = 0;
+	while (i < 4)
+	{
+		let j = 0;
+		while (j < 4)
+		{
+			x += j;
+			j += 1;
+			if (j == i)
+				break;
+		}
+
+		i += 1;
+		if (x > 100)
+			break;
+	}
+}
+)";
+
+		nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(nzslSource);
+		ResolveModule(*shaderModule);
+
+		nzsl::BackendParameters options;
+		options.backendPasses |= nzsl::BackendPass::PromoteVariables;
+
+		// j is declared inside the outer loop and only gets a OpPhi in the inner loop, the outer break goes to the outer merge block
+		ExpectSPIRV(*shaderModule, R"(
+OpFunction
+OpLabel
+OpBranch
+OpLabel
+OpPhi
+OpPhi
+OpSLessThan
+OpLoopMerge
+OpBranchConditional
+OpLabel
+OpBranch
+OpLabel
+OpPhi
+OpPhi
+OpSLessThan
+OpLoopMerge
+OpBranchConditional
+OpLabel
+OpIAdd
+OpIAdd
+OpIEqual
+OpSelectionMerge
+OpBranchConditional
+OpLabel
+OpBranch
+OpLabel
+OpBranch
+OpLabel
+OpBranch
+OpLabel
+OpPhi
+OpPhi
+OpBranch
+OpLabel
+OpPhi
+OpPhi
+OpIAdd
+OpSGreaterThan
+OpSelectionMerge
+OpBranchConditional
+OpLabel
+OpBranch
+OpLabel
+OpBranch
+OpLabel
+OpBranch
+OpLabel
+OpPhi
+OpPhi
+OpBranch
+OpLabel
+OpPhi
+OpPhi
+OpReturn
+OpFunctionEnd)", options);
+	}
+
+	WHEN("promoting variables through branches which both terminate")
+	{
+		std::string_view nzslSource = R"(
+[nzsl_version("1.1")]
+module;
+
+[entry(frag)]
+fn main()
+{
+	let value = 0.0;
+	let i = 0;
+	while (i < 10)
+	{
+		i += 1;
+		if (i > 5)
+		{
+			value += 1.0;
+			break;
+		}
+		else
+		{
+			value += 2.0;
+			continue;
+		}
+	}
+}
+)";
+
+		nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(nzslSource);
+		ResolveModule(*shaderModule);
+
+		nzsl::BackendParameters options;
+		options.backendPasses |= nzsl::BackendPass::PromoteVariables;
+
+		// the selection merge block is unreachable and keeps the values from before the branch (no OpPhi)
+		ExpectSPIRV(*shaderModule, R"(
+OpFunction
+OpLabel
+OpBranch
+OpLabel
+OpPhi
+OpPhi
+OpSLessThan
+OpLoopMerge
+OpBranchConditional
+OpLabel
+OpIAdd
+OpSGreaterThan
+OpSelectionMerge
+OpBranchConditional
+OpLabel
+OpFAdd
+OpBranch
+OpLabel
+OpFAdd
+OpBranch
+OpLabel
+OpBranch
+OpLabel
+OpPhi
+OpPhi
+OpBranch
+OpLabel
+OpPhi
+OpPhi
+OpReturn
+OpFunctionEnd)", options);
+	}
+
+	WHEN("promoting variables stored through swizzles")
+	{
+		std::string_view nzslSource = R"(
+[nzsl_version("1.1")]
+module;
+
+[entry(frag)]
+fn main()
+{
+	let vec = vec4[f32](0.0, 0.0, 0.0, 0.0);
+	vec.yzw = vec3[f32](1.0, 2.0, 3.0);
+	vec.xw = vec.zy;
+	vec.z = vec.x;
+}
+)";
+
+		nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(nzslSource);
+		ResolveModule(*shaderModule);
+
+		nzsl::BackendParameters options;
+		options.backendPasses |= nzsl::BackendPass::PromoteVariables;
+
+		// multiple components are stored using OpVectorShuffle, a single one using OpCompositeInsert
+		ExpectSPIRV(*shaderModule, R"(
+OpFunction
+OpLabel
+OpCompositeConstruct
+OpCompositeConstruct
+OpVectorShuffle
+OpVectorShuffle
+OpVectorShuffle
+OpCompositeExtract
+OpCompositeInsert
+OpReturn
+OpFunctionEnd)", options);
+	}
+
+	WHEN("promoting variables passed as out and inout arguments")
+	{
+		std::string_view nzslSource = R"(
+[nzsl_version("1.1")]
+module;
+
+fn Scale(inout color: vec3[f32], out factor: f32)
+{
+	color *= 2.0;
+	factor = 0.5;
+}
+
+[entry(frag)]
+fn main()
+{
+	let color = vec3[f32](1.0, 1.0, 1.0);
+	let factor: f32;
+	Scale(inout color, out factor);
+	color.x = factor;
+}
+)";
+
+		nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(nzslSource);
+		ResolveModule(*shaderModule);
+
+		nzsl::BackendParameters options;
+		options.backendPasses |= nzsl::BackendPass::PromoteVariables;
+
+		// arguments still go through call variables, their value is loaded back into the promoted variables after the call
+		ExpectSPIRV(*shaderModule, R"(
+OpFunction
+OpLabel
+OpVariable
+OpVariable
+OpCompositeConstruct
+OpUndef
+OpStore
+OpFunctionCall
+OpLoad
+OpLoad
+OpCompositeInsert
+OpReturn
+OpFunctionEnd)", options);
+	}
 }
@@ -1,6 +1,8 @@
 #include <Tests/ShaderUtils.hpp>
 #include <NZSL/FilesystemModuleResolver.hpp>
 #include <NZSL/Parser.hpp>
+#include <NZSL/Ast/Cloner.hpp>
+#include <NZSL/Ast/ResolvedModuleCache.hpp>
 #include <NZSL/Ast/TransformerExecutor.hpp>
 #include <NZSL/Ast/Transformations/ResolveTransformer.hpp>
 #include <catch2/catch_test_macros.hpp>
@@ -1585,4 +1587,317 @@ OpLoad
 OpReturn
 OpFunctionEnd)");
 	}
+
+	WHEN("Importing a module with deferred function bodies")
+	{
+		// Unused has an invalid body, which is never parsed nor resolved as the function is not used
+		std::string_view importedSource = R"(
+[nzsl_version("1.1")]
+module DeferredModule;
+
+fn Double(value: f32) -> f32
+{
+	return value * 2.0;
+}
+
+[export]
+fn GetValue(value: f32) -> f32
+{
+	return Double(value) + 1.0;
+}
+
+[export]
+fn Unused() -> f32
+{
+	return DoesNotExist(42) +;
+}
+)";
+
+		std::string_view shaderSource = R"(
+[nzsl_version("1.1")]
+module;
+
+import GetValue from DeferredModule;
+
+struct FragOut
+{
+	[location(0)] value: f32
+}
+
+[entry(frag)]
+fn main() -> FragOut
+{
+	let output: FragOut;
+	output.value = GetValue(0.5);
+	return output;
+}
+)";
+
+		nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(shaderSource);
+
+		nzsl::Parser::Options parserOptions;
+		parserOptions.deferFunctionBodies = true;
+
+		auto directoryModuleResolver = std::make_shared<nzsl::FilesystemModuleResolver>();
+		directoryModuleResolver->SetParserOptions(parserOptions);
+		directoryModuleResolver->RegisterModule(importedSource);
+
+		nzsl::Ast::ResolveTransformer::Options resolverOptions;
+		resolverOptions.moduleResolver = directoryModuleResolver;
+
+		ResolveOptions resolveOptions;
+		resolveOptions.identifierResolverOptions = &resolverOptions;
+
+		ResolveModule(*shaderModule, resolveOptions);
+
+		ExpectNZSL(*shaderModule, R"(
+[nzsl_version("1.1")]
+module _DeferredModule
+{
+	fn Double(value: f32) -> f32
+	{
+		return value * 2.0;
+	}
+
+	fn GetValue(value: f32) -> f32
+	{
+		return (Double(value)) + 1.0;
+	}
+
+}
+)");
+	}
+
+	WHEN("Parsing an invalid deferred function body")
+	{
+		std::string_view shaderSource = R"(
+[nzsl_version("1.1")]
+module;
+
+fn Broken() -> f32
+{
+	return 1.0 +;
+}
+)";
+
+		nzsl::Parser::Options parserOptions;
+		parserOptions.deferFunctionBodies = true;
+
+		nzsl::TokenStream tokenStream(shaderSource);
+		nzsl::Ast::ModulePtr shaderModule = nzsl::Parser(parserOptions).Parse(tokenStream);
+
+		REQUIRE(shaderModule->rootNode->statements.size() == 1);
+		REQUIRE(shaderModule->rootNode->statements.front()->GetType() == nzsl::Ast::NodeType::DeclareFunctionStatement);
+		auto& brokenFunc = static_cast<nzsl::Ast::DeclareFunctionStatement&>(*shaderModule->rootNode->statements.front());
+
+		// the body is kept when it fails to parse, so the error is reported again on retry
+		CHECK_THROWS(nzsl::ParseDeferredFunctionBody(brokenFunc));
+		CHECK(brokenFunc.deferredBody);
+		CHECK(brokenFunc.statements.empty());
+		CHECK_THROWS(nzsl::ParseDeferredFunctionBody(brokenFunc));
+	}
+
+	WHEN("Importing a module through a resolved module cache")
+	{
+		std::string_view importedSource = R"(
+[nzsl_version("1.1")]
+module CachedModule;
+
+option Scale: f32 = 2.0;
+
+const Offset = 1.0;
+
+[export]
+fn GetValue(value: f32) -> f32
+{
+	return value * Scale + Offset;
+}
+
+[export]
+fn Unused() -> f32
+{
+	return Offset;
+}
+)";
+
+		std::string_view shaderSource = R"(
+[nzsl_version("1.1")]
+module;
+
+import GetValue from CachedModule;
+
+struct FragOut
+{
+	[location(0)] value: f32
+}
+
+[entry(frag)]
+fn main() -> FragOut
+{
+	let output: FragOut;
+	output.value = GetValue(0.5);
+	return output;
+}
+)";
+
+		auto directoryModuleResolver = std::make_shared<nzsl::FilesystemModuleResolver>();
+		directoryModuleResolver->RegisterModule(importedSource);
+
+		auto resolvedModuleCache = std::make_shared<nzsl::Ast::ResolvedModuleCache>();
+
+		nzsl::Ast::ResolveTransformer::Options resolverOptions;
+		resolverOptions.moduleResolver = directoryModuleResolver;
+		resolverOptions.resolvedModuleCache = resolvedModuleCache;
+
+		ResolveOptions resolveOptions;
+		resolveOptions.identifierResolverOptions = &resolverOptions;
+
+		// Each compilation gets the same output, the module being only resolved once
+		std::shared_ptr<const nzsl::Ast::Module> firstResolvedModule;
+		for (std::size_t i = 0; i < 2; ++i)
+		{
+			nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(shaderSource);
+			ResolveModule(*shaderModule, resolveOptions);
+
+			CHECK(resolvedModuleCache->GetEntryCount() == 1);
+
+			std::shared_ptr<const nzsl::Ast::Module> resolvedModule = resolvedModuleCache->Retrieve(directoryModuleResolver->Resolve("CachedModule"));
+			REQUIRE(resolvedModule);
+			if (firstResolvedModule)
+				CHECK(resolvedModule == firstResolvedModule);
+			else
+				firstResolvedModule = resolvedModule;
+
+			ExpectNZSL(*shaderModule, R"(
+[nzsl_version("1.1")]
+module _CachedModule
+{
+	option Scale: f32 = 2.0;
+
+	const Offset: f32 = 1.0;
+
+	fn GetValue(value: f32) -> f32
+	{
+		return (value * Scale) + Offset;
+	}
+
+}
+)");
+		}
+
+		// Retrieving an unchanged module (or a copy of it) gives back the same resolved module
+		nzsl::Ast::ModulePtr cachedModule = directoryModuleResolver->Resolve("CachedModule");
+		REQUIRE(cachedModule);
+
+		CHECK(resolvedModuleCache->Retrieve(cachedModule) == firstResolvedModule);
+		CHECK(resolvedModuleCache->Retrieve(nzsl::Ast::Clone(*cachedModule)) == firstResolvedModule);
+
+		// Modifying the module in place invalidates its entry
+		cachedModule->rootNode->statements.pop_back();
+
+		std::shared_ptr<const nzsl::Ast::Module> updatedModule = resolvedModuleCache->Retrieve(cachedModule);
+		REQUIRE(updatedModule);
+		CHECK(updatedModule != firstResolvedModule);
+		CHECK(resolvedModuleCache->GetEntryCount() == 1);
+
+		// Registering the module again gives it a new version
+		std::optional<std::uint64_t> previousVersion = directoryModuleResolver->GetModuleVersion("CachedModule");
+		REQUIRE(previousVersion);
+
+		directoryModuleResolver->RegisterModule(importedSource);
+
+		std::optional<std::uint64_t> moduleVersion = directoryModuleResolver->GetModuleVersion("CachedModule");
+		REQUIRE(moduleVersion);
+		CHECK(*moduleVersion != *previousVersion);
+
+		// Modules retrieved with a version are recognized by it, and by their content without one
+		nzsl::Ast::ModulePtr registeredModule = directoryModuleResolver->Resolve("CachedModule");
+		REQUIRE(registeredModule);
+
+		std::shared_ptr<const nzsl::Ast::Module> versionedModule = resolvedModuleCache->Retrieve(registeredModule, moduleVersion);
+		REQUIRE(versionedModule);
+		CHECK(versionedModule != updatedModule);
+		CHECK(resolvedModuleCache->Retrieve(registeredModule, moduleVersion) == versionedModule);
+		CHECK(resolvedModuleCache->Retrieve(registeredModule) == versionedModule);
+
+		// A version only stands for the module it was reported for
+		CHECK(resolvedModuleCache->Retrieve(nzsl::Ast::Clone(*registeredModule), moduleVersion) != versionedModule);
+		CHECK(resolvedModuleCache->GetEntryCount() == 1);
+	}
+
+	WHEN("Importing the same module from multiple modules")
+	{
+		std::string_view importedSource = R"(
+[nzsl_version("1.1")]
+module SharedModule;
+
+[export]
+fn GetValue(value: f32) -> f32
+{
+	return value * 2.0;
+}
+)";
+
+		std::string_view shaderSource = R"(
+[nzsl_version("1.1")]
+module;
+
+import GetValue from SharedModule;
+
+struct FragOut
+{
+	[location(0)] value: f32
+}
+
+[entry(frag)]
+fn main() -> FragOut
+{
+	let output: FragOut;
+	output.value = GetValue(0.5);
+	return output;
+}
+)";
+
+		auto directoryModuleResolver = std::make_shared<nzsl::FilesystemModuleResolver>();
+		directoryModuleResolver->RegisterModule(importedSource);
+
+		auto resolvedModuleCache = std::make_shared<nzsl::Ast::ResolvedModuleCache>();
+
+		nzsl::Ast::ResolveTransformer::Options resolverOptions;
+		resolverOptions.moduleResolver = directoryModuleResolver;
+		resolverOptions.resolvedModuleCache = resolvedModuleCache;
+
+		ResolveOptions resolveOptions;
+		resolveOptions.identifierResolverOptions = &resolverOptions;
+
+		nzsl::Ast::ModulePtr firstModule = nzsl::Parse(shaderSource);
+		ResolveModule(*firstModule, resolveOptions);
+
+		// Function bodies are shared with the imported module until they're resolved, modifying one importer must not affect the others
+		REQUIRE(firstModule->importedModules.size() == 1);
+		for (auto& statement : firstModule->importedModules.front().module->rootNode->statements)
+		{
+			if (statement->GetType() != nzsl::Ast::NodeType::DeclareFunctionStatement)
+				continue;
+
+			auto& func = static_cast<nzsl::Ast::DeclareFunctionStatement&>(*statement);
+			CHECK(func.sharedBody == nullptr);
+			func.statements.clear();
+		}
+
+		nzsl::Ast::ModulePtr secondModule = nzsl::Parse(shaderSource);
+		ResolveModule(*secondModule, resolveOptions);
+
+		ExpectNZSL(*secondModule, R"(
+[nzsl_version("1.1")]
+module _SharedModule
+{
+	fn GetValue(value: f32) -> f32
+	{
+		return value * 2.0;
+	}
+
+}
+)");
+	}
 }
@@ -0,0 +1,92 @@
+#include <Tests/ShaderUtils.hpp>
+#include <NZSL/Parser.hpp>
+#include <NZSL/Ast/Cloner.hpp>
+#include <NZSL/Ast/NodeArena.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("node arena", "[Shader]")
+{
+	std::string_view nzslSource = R"(
+[nzsl_version("1.1")]
+module;
+
+struct Data
+{
+	value: f32
+}
+
+external
+{
+	[set(0), binding(0)] data: uniform[Data]
+}
+
+[entry(frag)]
+fn main()
+{
+	let value = data.value * 2.0;
+	for i in 0 -> 3
+	{
+		value += 1.0;
+	}
+}
+)";
+
+	WHEN("Parsing a module with an arena")
+	{
+		nzsl::Ast::ModulePtr shaderModule;
+		auto arena = std::make_shared<nzsl::Ast::NodeArena>();
+		{
+			nzsl::Ast::NodeArena::Scope arenaScope(arena);
+			shaderModule = nzsl::Parse(nzslSource);
+		}
+
+		CHECK(shaderModule->arena == arena);
+		CHECK(arena->GetAllocatedSize() > 0);
+		CHECK(nzsl::Ast::NodeArena::GetCurrent() == nullptr);
+
+		std::size_t parsedSize = arena->GetAllocatedSize();
+
+		ResolveModule(*shaderModule);
+		CHECK(arena->GetAllocatedSize() > parsedSize); //< nodes created by transformations come from the module arena
+
+		nzsl::Ast::ModulePtr clonedModule = nzsl::Ast::Clone(*shaderModule);
+		REQUIRE(clonedModule->arena);
+		CHECK(clonedModule->arena != arena);
+		CHECK(clonedModule->arena->GetAllocatedSize() > 0);
+
+		// the module owns its arena, the clone doesn't depend on it
+		arena.reset();
+		shaderModule.reset();
+
+		ExpectGLSL(*clonedModule, R"(
+void main()
+{
+	float value = data.value * 2.0;
+	{
+		int i = 0;
+		int _nzsl_to = 3;
+		while (i < _nzsl_to)
+		{
+			value += 1.0;
+			i += 1;
+		}
+
+	}
+
+}
+)");
+	}
+
+	WHEN("Allocating big nodes")
+	{
+		nzsl::Ast::NodeArena arena(256);
+
+		void* first = arena.Allocate(16);
+		void* big = arena.Allocate(1024);
+		void* second = arena.Allocate(16);
+
+		CHECK(arena.GetBlockCount() == 2);
+		CHECK(static_cast<std::byte*>(second) == static_cast<std::byte*>(first) + 16); //< big allocations don't consume the current block
+		CHECK(big != first);
+	}
+}
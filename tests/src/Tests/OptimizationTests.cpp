@@ -491,4 +491,63 @@ fn main() -> Output
 	return output;
 })");
 	}
+
+	WHEN("optimizing generated SPIR-V")
+	{
+		std::string_view nzslSource = R"(
+[nzsl_version("1.1")]
+module;
+
+struct FragOut
+{
+	[location(0)] value: f32
+}
+
+fn unusedFunction() -> f32
+{
+	return 1.0;
+}
+
+[entry(frag)]
+fn main() -> FragOut
+{
+	let value = 42.0;
+	let unusedValue = value * 2.0;
+
+	let output: FragOut;
+	output.value = value + value;
+	return output;
+}
+)";
+
+		nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(nzslSource);
+		ResolveModule(*shaderModule);
+
+		nzsl::BackendParameters options;
+		options.backendPasses |= nzsl::BackendPass::OptimizeSpirv;
+
+		// value loads are forwarded from its store, leaving value and unusedValue variables unused
+		ExpectSPIRV(*shaderModule, R"(
+OpFunction
+OpLabel
+OpVariable
+OpFAdd
+OpAccessChain
+OpStore
+OpLoad
+OpCompositeExtract
+OpStore
+OpReturn
+OpFunctionEnd)", options);
+
+		const nzsl::Ast::Module& constModule = *shaderModule;
+
+		nzsl::SpirvWriter spirvWriter;
+		std::vector<std::uint32_t> spirv = spirvWriter.Generate(constModule);
+		std::vector<std::uint32_t> optimizedSpirv = spirvWriter.Generate(constModule, options);
+
+		// ids are compacted once instructions are removed (bound is the fourth word of the header)
+		CHECK(optimizedSpirv.size() < spirv.size());
+		CHECK(optimizedSpirv[3] < spirv[3]);
+	}
 }
@@ -4,7 +4,9 @@
 #include <NZSL/LangWriter.hpp>
 #include <NZSL/Parser.hpp>
 #include <NZSL/Ast/AstSerializer.hpp>
+#include <NZSL/Ast/Cloner.hpp>
 #include <NZSL/Ast/Compare.hpp>
+#include <NZSL/Ast/Hash.hpp>
 #include <NZSL/Ast/TransformerExecutor.hpp>
 #include <NZSL/Ast/Transformations/ResolveTransformer.hpp>
 #include <catch2/catch_test_macros.hpp>
@@ -558,4 +560,135 @@ fn main()
 }
 )", false);
 	}
+
+	WHEN("serializing and unserializing shared function bodies")
+	{
+		nzsl::Ast::ModulePtr sourceModule;
+		REQUIRE_NOTHROW(sourceModule = nzsl::Parse(R"(
+[nzsl_version("1.1")]
+module;
+
+fn GetValue(value: f32) -> f32
+{
+	return value * 2.0;
+}
+
+[entry(frag)]
+fn main()
+{
+	let value = GetValue(0.5);
+}
+)"));
+
+		// Share function bodies of the source module, like imported modules do
+		nzsl::Ast::ModulePtr sharedModule = nzsl::Ast::Clone(*sourceModule);
+		for (std::size_t i = 0; i < sharedModule->rootNode->statements.size(); ++i)
+		{
+			if (sharedModule->rootNode->statements[i]->GetType() != nzsl::Ast::NodeType::DeclareFunctionStatement)
+				continue;
+
+			auto& func = static_cast<nzsl::Ast::DeclareFunctionStatement&>(*sharedModule->rootNode->statements[i]);
+			func.statements.clear();
+			func.sharedBody = std::shared_ptr<const nzsl::Ast::DeclareFunctionStatement>(sourceModule, &static_cast<const nzsl::Ast::DeclareFunctionStatement&>(*sourceModule->rootNode->statements[i]));
+		}
+
+		CHECK(nzsl::Ast::Compare(*sourceModule, *sharedModule));
+		CHECK(nzsl::Ast::Hash(*sourceModule) == nzsl::Ast::Hash(*sharedModule));
+
+		nzsl::Serializer serializer;
+		REQUIRE_NOTHROW(nzsl::Ast::SerializeShader(serializer, *sharedModule));
+
+		// serializing doesn't touch the module
+		const auto& sharedMain = static_cast<const nzsl::Ast::DeclareFunctionStatement&>(*sharedModule->rootNode->statements.back());
+		CHECK(sharedMain.sharedBody);
+		CHECK(sharedMain.statements.empty());
+
+		const std::vector<std::uint8_t>& data = serializer.GetData();
+
+		nzsl::Deserializer deserializer(&data[0], data.size());
+		nzsl::Ast::ModulePtr deserializedShader;
+		REQUIRE_NOTHROW(deserializedShader = nzsl::Ast::DeserializeShader(deserializer));
+
+		CHECK(nzsl::Ast::Compare(*sourceModule, *deserializedShader));
+	}
+
+	WHEN("serializing deferred function bodies")
+	{
+		std::string_view nzslSource = R"(
+[nzsl_version("1.1")]
+module;
+
+fn GetValue(value: f32) -> f32
+{
+	return value * 2.0;
+}
+)";
+
+		nzsl::Parser::Options parserOptions;
+		parserOptions.deferFunctionBodies = true;
+
+		nzsl::TokenStream tokenStream(nzslSource);
+		nzsl::Ast::ModulePtr deferredModule = nzsl::Parser(parserOptions).Parse(tokenStream);
+
+		nzsl::Serializer serializer;
+		REQUIRE_NOTHROW(nzsl::Ast::SerializeShader(serializer, *deferredModule));
+
+		// the body is parsed into a copy, the module keeps its deferred body
+		REQUIRE(deferredModule->rootNode->statements.size() == 1);
+		const auto& deferredFunc = static_cast<const nzsl::Ast::DeclareFunctionStatement&>(*deferredModule->rootNode->statements.front());
+		CHECK(deferredFunc.deferredBody);
+		CHECK(deferredFunc.statements.empty());
+
+		const std::vector<std::uint8_t>& data = serializer.GetData();
+
+		nzsl::Deserializer deserializer(&data[0], data.size());
+		nzsl::Ast::ModulePtr deserializedShader;
+		REQUIRE_NOTHROW(deserializedShader = nzsl::Ast::DeserializeShader(deserializer));
+
+		CHECK(nzsl::Ast::Compare(*nzsl::Parse(nzslSource), *deserializedShader));
+	}
+
+	WHEN("deserializing expression types")
+	{
+		std::string_view nzslSource = R"(
+[nzsl_version("1.1")]
+module;
+
+fn foo() -> vec3[f32]
+{
+	return vec3[f32](1.0, 2.0, 3.0);
+}
+)";
+
+		auto GetReturnType = [](nzsl::Ast::Module& module) -> const nzsl::Ast::InternedType&
+		{
+			REQUIRE(module.rootNode->statements.size() == 1);
+			REQUIRE(module.rootNode->statements[0]->GetType() == nzsl::Ast::NodeType::DeclareFunctionStatement);
+			auto& declFunc = static_cast<nzsl::Ast::DeclareFunctionStatement&>(*module.rootNode->statements[0]);
+
+			REQUIRE(declFunc.statements.size() == 1);
+			REQUIRE(declFunc.statements[0]->GetType() == nzsl::Ast::NodeType::ReturnStatement);
+			return static_cast<nzsl::Ast::ReturnStatement&>(*declFunc.statements[0]).returnExpr->cachedExpressionType;
+		};
+
+		nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(nzslSource);
+		ResolveModule(*shaderModule);
+
+		nzsl::Serializer serializer;
+		nzsl::Ast::SerializeShader(serializer, *shaderModule);
+
+		const std::vector<std::uint8_t>& data = serializer.GetData();
+
+		nzsl::Deserializer deserializer(&data[0], data.size());
+		nzsl::Ast::ModulePtr deserializedShader = nzsl::Ast::DeserializeShader(deserializer);
+
+		// expression types are interned, equal types share the same handle
+		const nzsl::Ast::InternedType& returnType = GetReturnType(*shaderModule);
+		REQUIRE(returnType);
+		CHECK(returnType == GetReturnType(*deserializedShader));
+		CHECK(returnType == nzsl::Ast::InternedType(nzsl::Ast::VectorType{ 3, nzsl::Ast::PrimitiveType::Float32 }));
+		CHECK(returnType != nzsl::Ast::InternedType(nzsl::Ast::VectorType{ 4, nzsl::Ast::PrimitiveType::Float32 }));
+		CHECK(*returnType == nzsl::Ast::ExpressionType{ nzsl::Ast::VectorType{ 3, nzsl::Ast::PrimitiveType::Float32 } });
+		CHECK(nzsl::Ast::InternedType{} == nzsl::Ast::InternedType(std::nullopt));
+	}
 }
@@ -13,7 +13,9 @@
 #include <NZSL/Ast/Transformations/BindingResolverTransformer.hpp>
 #include <NZSL/Ast/Transformations/LiteralTransformer.hpp>
 #include <NZSL/Ast/Cloner.hpp>
+#include <algorithm>
 #include <sstream>
+#include <utility>
 
 namespace NAZARA_ANONYMOUS_NAMESPACE
 {
@@ -270,8 +272,15 @@ void ExpectGLSL(nzsl::ShaderStageType stageType, nzsl::Ast::Module& shaderModule
 		nzsl::GlslWriter writer;
 		writer.SetEnv(env);
 
+		// The const overload transforms its own copy, so it has to run before the module is transformed in place
+		nzsl::GlslWriter::Output constOutput = writer.Generate(stageType, std::as_const(*moduleClone), options);
 		nzsl::GlslWriter::Output output = writer.Generate(stageType, *moduleClone, options);
 
+		SECTION("Generating from a const module")
+		{
+			CHECK(constOutput.code == output.code);
+		}
+
 		SECTION("Validating expected code")
 		{
 			std::string outputCode = SanitizeSource(output.code);
@@ -413,9 +422,46 @@ void ExpectSPIRV(nzsl::Ast::Module& shaderModule, std::string_view expectedOutpu
 		settings.printHeader = false;
 		settings.printParameters = outputParameter;
 
+		// The const overload transforms its own copy, so it has to run before the module is transformed in place
+		std::vector<std::uint32_t> constSpirv = writer.Generate(std::as_const(targetModule), options);
+
 		auto spirv = writer.Generate(targetModule, options);
 		std::string output = SanitizeSource(printer.Print(spirv.data(), spirv.size(), settings));
 
+		SECTION("Generating from a const module")
+		{
+			CHECK(constSpirv == spirv);
+		}
+
+		SECTION("Generating into a caller-provided buffer")
+		{
+			std::vector<std::uint32_t> expectedSpirv = writer.Generate(std::as_const(shaderModule), options);
+
+			std::vector<std::uint32_t> buffer;
+			std::size_t reserveCount = 0;
+			std::size_t writeOffset = 0;
+
+			nzsl::SpirvWriter::OutputSink sink;
+			sink.reserve = [&](std::size_t wordCount)
+			{
+				reserveCount++;
+				buffer.resize(wordCount);
+			};
+
+			sink.append = [&](const std::uint32_t* words, std::size_t wordCount)
+			{
+				REQUIRE(writeOffset + wordCount <= buffer.size());
+				std::copy(words, words + wordCount, buffer.data() + writeOffset);
+				writeOffset += wordCount;
+			};
+
+			writer.Generate(*nzsl::Ast::Clone(shaderModule), sink, options);
+
+			CHECK(reserveCount == 1);
+			CHECK(writeOffset == buffer.size());
+			CHECK(buffer == expectedSpirv);
+		}
+
 		SECTION("Validating expected code")
 		{
 			if (output.find(source) == std::string::npos)
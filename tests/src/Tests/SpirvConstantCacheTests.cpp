@@ -0,0 +1,66 @@
+#include <Tests/ShaderUtils.hpp>
+#include <NZSL/SpirvWriter.hpp>
+#include <NZSL/SpirV/SpirvConstantCache.hpp>
+#include <NZSL/SpirV/SpirvSection.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("spirv constant cache", "[Shader]")
+{
+	nzsl::SpirvWriter writer;
+
+	nzsl::Ast::VectorType vec3Type{ 3, nzsl::Ast::PrimitiveType::Float32 };
+	nzsl::Vector3f32 vec3Value(1.f, 2.f, 3.f);
+
+	WHEN("Building the same types and constants")
+	{
+		std::uint32_t resultId = 1;
+		nzsl::SpirvConstantCache cache(writer, resultId);
+
+		// equal nodes are interned and share the same pointer, including the vector component type of constants
+		nzsl::SpirvConstantCache::TypePtr vecType = cache.BuildType(vec3Type);
+		CHECK(vecType == cache.BuildType(vec3Type));
+		CHECK(vecType != cache.BuildType(nzsl::Ast::VectorType{ 4, nzsl::Ast::PrimitiveType::Float32 }));
+
+		nzsl::SpirvConstantCache::ConstantPtr vecConstant = cache.BuildConstant(vec3Value);
+		CHECK(vecConstant == cache.BuildConstant(vec3Value));
+		CHECK(vecConstant != cache.BuildConstant(nzsl::Vector3f32(3.f, 2.f, 1.f)));
+
+		REQUIRE(std::holds_alternative<nzsl::SpirvConstantCache::ConstantComposite>(vecConstant->constant));
+		CHECK(std::get<nzsl::SpirvConstantCache::ConstantComposite>(vecConstant->constant).type == vecType);
+
+		CHECK(resultId == 1); //< building doesn't register anything
+	}
+
+	WHEN("Registering the same types and constants")
+	{
+		auto RegisterAndWrite = [&](unsigned int registerCount)
+		{
+			std::uint32_t resultId = 1;
+			nzsl::SpirvConstantCache cache(writer, resultId);
+
+			std::uint32_t typeId = cache.Register(*cache.BuildType(vec3Type));
+			std::uint32_t constantId = cache.Register(*cache.BuildConstant(vec3Value));
+			std::uint32_t nextResultId = resultId;
+
+			for (unsigned int i = 1; i < registerCount; ++i)
+			{
+				CHECK(cache.Register(*cache.BuildType(vec3Type)) == typeId);
+				CHECK(cache.Register(*cache.BuildConstant(vec3Value)) == constantId);
+				CHECK(cache.GetId(*cache.BuildType(vec3Type)) == typeId);
+			}
+
+			// registering again doesn't allocate any new id
+			CHECK(resultId == nextResultId);
+
+			nzsl::SpirvSection annotations;
+			nzsl::SpirvSection constants;
+			nzsl::SpirvSection debugInfos;
+			cache.Write(annotations, constants, debugInfos, nzsl::DebugLevel::None);
+
+			return constants.GetBytecode();
+		};
+
+		// nor does it emit anything
+		CHECK(RegisterAndWrite(1) == RegisterAndWrite(3));
+	}
+}
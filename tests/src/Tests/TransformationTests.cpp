@@ -2,11 +2,18 @@
 #include <NazaraUtils/Algorithm.hpp>
 #include <NZSL/Serializer.hpp>
 #include <NZSL/ShaderBuilder.hpp>
+#include <NZSL/LangWriter.hpp>
 #include <NZSL/Parser.hpp>
+#include <NZSL/Ast/Cloner.hpp>
+#include <NZSL/Ast/Compare.hpp>
+#include <NZSL/Ast/Hash.hpp>
+#include <NZSL/Ast/Option.hpp>
 #include <NZSL/Ast/Transformations/AliasTransformer.hpp>
 #include <NZSL/Ast/Transformations/BranchSplitterTransformer.hpp>
 #include <NZSL/Ast/Transformations/CompoundAssignmentTransformer.hpp>
+#include <NZSL/Ast/Transformations/ConstantRemovalTransformer.hpp>
 #include <NZSL/Ast/Transformations/ForToWhileTransformer.hpp>
+#include <NZSL/Ast/Transformations/LoopUnrollTransformer.hpp>
 #include <NZSL/Ast/Transformations/MatrixTransformer.hpp>
 #include <NZSL/Ast/Transformations/StructAssignmentTransformer.hpp>
 #include <NZSL/Ast/Transformations/SwizzleTransformer.hpp>
@@ -14,6 +21,28 @@
 #include <array>
 #include <cctype>
 #include <string>
+#include <vector>
+
+namespace
+{
+	// Doesn't transform anything, only counts how many times it ran on a module containing for loops
+	class ForLoopCounterTransformer final : public nzsl::Ast::Transformer
+	{
+		public:
+			struct Options
+			{
+				std::size_t* runCount = nullptr;
+			};
+
+			static constexpr nzsl::Ast::NodeTypeFlags TriggerNodes = nzsl::Ast::NodeType::ForStatement;
+
+			bool Transform(nzsl::Ast::Module& /*module*/, nzsl::Ast::TransformerContext& /*context*/, const Options& options, std::string* /*error*/ = nullptr)
+			{
+				(*options.runCount)++;
+				return true;
+			}
+	};
+}
 
 TEST_CASE("transformations", "[Shader]")
 {
@@ -752,4 +781,275 @@ fn main()
 )");
 
 	}
+
+	WHEN("fusing passes")
+	{
+		std::string_view nzslSource = R"(
+[nzsl_version("1.1")]
+module;
+
+fn compute(x: mat4[f32], y: mat3[f32], factor: f32) -> mat4[f32]
+{
+	let result = mat4[f32](y);
+	if (factor > 2.0)
+		result += x;
+	else if (factor > 1.0)
+		result -= x + mat4[f32](factor);
+	else if (factor > 0.0)
+		result = result - x;
+	else
+		result *= factor;
+
+	return result;
+}
+)";
+
+		auto TransformModule = [&](bool passFusion, std::size_t expectedTraversalCount)
+		{
+			nzsl::Ast::TransformerExecutor executor;
+			executor.AddPass<nzsl::Ast::ResolveTransformer>();
+			nzsl::SpirvWriter::RegisterPasses(executor);
+			executor.EnablePassFusion(passFusion);
+
+			CHECK(executor.GetTraversalCount() == expectedTraversalCount);
+
+			nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(nzslSource);
+			REQUIRE_NOTHROW(executor.Transform(*shaderModule));
+
+			nzsl::LangWriter langWriter;
+			return langWriter.Generate(*shaderModule);
+		};
+
+		// Branch splitting, compound assignment and matrix passes share a single traversal
+		std::string fusedOutput = TransformModule(true, 10);
+		std::string unfusedOutput = TransformModule(false, 12);
+
+		CHECK(fusedOutput == unfusedOutput);
+	}
+
+	WHEN("skipping passes")
+	{
+		auto CountRuns = [](std::string_view nzslSource, bool passSkipping)
+		{
+			std::size_t runCount = 0;
+
+			nzsl::Ast::TransformerExecutor executor;
+			executor.AddPass<nzsl::Ast::ResolveTransformer>();
+			executor.AddPass<ForLoopCounterTransformer>(ForLoopCounterTransformer::Options{ &runCount });
+			executor.AddPass<nzsl::Ast::ForToWhileTransformer>();
+			executor.AddPass<ForLoopCounterTransformer>(ForLoopCounterTransformer::Options{ &runCount }); //< for loops are gone at this point
+			executor.EnablePassSkipping(passSkipping);
+
+			nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(nzslSource);
+			REQUIRE_NOTHROW(executor.Transform(*shaderModule));
+
+			return runCount;
+		};
+
+		std::string_view withLoop = R"(
+[nzsl_version("1.1")]
+module;
+
+fn main()
+{
+	let x = 0;
+	for i in 0 -> 10
+		x += i;
+}
+)";
+
+		std::string_view withoutLoop = R"(
+[nzsl_version("1.1")]
+module;
+
+fn main()
+{
+	let x = 0;
+	while (x < 10)
+		x += 1;
+}
+)";
+
+		CHECK(CountRuns(withLoop, true) == 1);
+		CHECK(CountRuns(withoutLoop, true) == 0);
+		CHECK(CountRuns(withLoop, false) == 2);
+		CHECK(CountRuns(withoutLoop, false) == 2);
+	}
+
+	WHEN("instrumenting passes")
+	{
+		std::string_view nzslSource = R"(
+[nzsl_version("1.1")]
+module;
+
+fn main()
+{
+	let x = 0;
+	for i in 0 -> 10
+		x += i;
+}
+)";
+
+		std::vector<std::string> passNames;
+		std::vector<nzsl::Ast::PassStatistics> passStatistics;
+
+		nzsl::Ast::PassInstrumentation instrumentation;
+		instrumentation.callback = [&](const nzsl::Ast::PassStatistics& statistics)
+		{
+			passNames.emplace_back(statistics.passName);
+			passStatistics.push_back(statistics);
+		};
+
+		nzsl::Ast::TransformerExecutor executor;
+		executor.AddPass<nzsl::Ast::ResolveTransformer>();
+		executor.AddPass<nzsl::Ast::ForToWhileTransformer>();
+		executor.AddPass<nzsl::Ast::CompoundAssignmentTransformer>(nzsl::Ast::CompoundAssignmentTransformer::Options{ true });
+		executor.SetInstrumentation(std::move(instrumentation));
+
+		nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(nzslSource);
+		REQUIRE_NOTHROW(executor.Transform(*shaderModule));
+
+		REQUIRE(passNames == std::vector<std::string>{ "Resolve", "ForToWhile", "CompoundAssignment" });
+		for (const nzsl::Ast::PassStatistics& statistics : passStatistics)
+			CHECK(statistics.visitedNodeCount > 0);
+
+		// The for loop is replaced by a while loop, which requires new nodes
+		CHECK(passStatistics[1].replacedNodeCount > 0);
+		CHECK(passStatistics[1].createdNodeCount > 0);
+		CHECK(passStatistics[1].allocationCount == passStatistics[1].createdNodeCount);
+
+		// x += i becomes x = x + i
+		CHECK(passStatistics[2].createdNodeCount > 0);
+	}
+
+	WHEN("skipping passes based on operators and attributes")
+	{
+		auto RunPasses = [](std::string_view nzslSource)
+		{
+			std::vector<std::string> passNames;
+
+			nzsl::Ast::PassInstrumentation instrumentation;
+			instrumentation.callback = [&](const nzsl::Ast::PassStatistics& statistics)
+			{
+				passNames.emplace_back(statistics.passName);
+			};
+
+			nzsl::Ast::TransformerExecutor executor;
+			executor.AddPass<nzsl::Ast::ResolveTransformer>();
+			executor.AddPass<nzsl::Ast::LoopUnrollTransformer>();
+			executor.AddPass<nzsl::Ast::MatrixTransformer>(nzsl::Ast::MatrixTransformer::Options{ true, true });
+			executor.SetInstrumentation(std::move(instrumentation));
+
+			nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(nzslSource);
+			REQUIRE_NOTHROW(executor.Transform(*shaderModule));
+
+			return passNames;
+		};
+
+		// Loops without [unroll], non-matrix operations and casts don't require loop unrolling nor matrix transformations
+		CHECK(RunPasses(R"(
+[nzsl_version("1.1")]
+module;
+
+fn main(m: mat2[f32]) -> vec2[f32]
+{
+	let x = 0.0;
+	for i in 0 -> 10
+		x = x + f32(i);
+
+	return m * vec2[f32](x, x);
+}
+)") == std::vector<std::string>{ "Resolve" });
+
+		CHECK(RunPasses(R"(
+[nzsl_version("1.1")]
+module;
+
+fn main()
+{
+	let x = 0;
+	[unroll]
+	for i in 0 -> 3
+		x += i;
+}
+)") == std::vector<std::string>{ "Resolve", "LoopUnroll" });
+
+		CHECK(RunPasses(R"(
+[nzsl_version("1.1")]
+module;
+
+fn main(m: mat2[f32], n: mat2[f32]) -> mat2[f32]
+{
+	return m + n;
+}
+)") == std::vector<std::string>{ "Resolve", "Matrix" });
+	}
+
+	WHEN("hashing modules")
+	{
+		std::string_view nzslSource = R"(
+[nzsl_version("1.1")]
+module;
+
+option Factor: f32 = 1.0;
+
+struct FragOut
+{
+	[location(0)] value: f32
+}
+
+[entry(frag)]
+fn main() -> FragOut
+{
+	let output: FragOut;
+	output.value = Factor * 2.0;
+	return output;
+}
+)";
+
+		// Identical modules hash the same
+		nzsl::Ast::ModulePtr shaderModule = nzsl::Parse(nzslSource);
+		nzsl::Ast::ModulePtr reparsedModule = nzsl::Parse(nzslSource);
+		CHECK(nzsl::Ast::Compare(*shaderModule, *reparsedModule));
+		CHECK(nzsl::Ast::Hash(*shaderModule) == nzsl::Ast::Hash(*reparsedModule));
+
+		nzsl::Ast::ModulePtr clonedModule = nzsl::Ast::Clone(*shaderModule);
+		CHECK(nzsl::Ast::Compare(*shaderModule, *clonedModule));
+		CHECK(nzsl::Ast::Hash(*shaderModule) == nzsl::Ast::Hash(*clonedModule));
+
+		// Modules produced by passes with different option values are different
+		auto TransformWithFactor = [&](float factor)
+		{
+			nzsl::Ast::ModulePtr transformedModule = nzsl::Ast::Clone(*shaderModule);
+
+			nzsl::Ast::TransformerExecutor executor;
+			executor.AddPass<nzsl::Ast::ResolveTransformer>();
+			executor.AddPass<nzsl::Ast::ConstantRemovalTransformer>();
+
+			nzsl::Ast::TransformerContext context;
+			context.optionValues[nzsl::Ast::HashOption("Factor")] = factor;
+			REQUIRE_NOTHROW(executor.Transform(*transformedModule, context));
+
+			return transformedModule;
+		};
+
+		nzsl::Ast::ModulePtr firstVariant = TransformWithFactor(1.0f);
+		nzsl::Ast::ModulePtr secondVariant = TransformWithFactor(1.0f);
+		nzsl::Ast::ModulePtr thirdVariant = TransformWithFactor(3.0f);
+
+		CHECK(nzsl::Ast::Compare(*firstVariant, *secondVariant));
+		CHECK(nzsl::Ast::Hash(*firstVariant) == nzsl::Ast::Hash(*secondVariant));
+
+		CHECK_FALSE(nzsl::Ast::Compare(*firstVariant, *thirdVariant));
+		CHECK_FALSE(nzsl::Ast::Compare(*shaderModule, *firstVariant));
+
+		// Source locations are ignored when asked to, by both of them
+		nzsl::Ast::ComparisonParams ignoreSourceLoc;
+		ignoreSourceLoc.compareSourceLoc = false;
+
+		nzsl::Ast::ModulePtr shiftedModule = nzsl::Parse(std::string("\n\n") + std::string(nzslSource));
+		CHECK_FALSE(nzsl::Ast::Compare(*shaderModule, *shiftedModule));
+		CHECK(nzsl::Ast::Compare(*shaderModule, *shiftedModule, ignoreSourceLoc));
+		CHECK(nzsl::Ast::Hash(*shaderModule, ignoreSourceLoc) == nzsl::Ast::Hash(*shiftedModule, ignoreSourceLoc));
+	}
 }